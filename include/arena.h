@@ -0,0 +1,47 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef ARENA_H
+#define ARENA_H
+
+// We need stddef.h for 'size_t' (the standard type for sizes in bytes).
+#include <stddef.h>
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// A memory arena: ONE big block of RAM that we hand out in pieces, front to back.
+// Instead of calling malloc() and free() for every little array, a level asks for exactly
+// the bytes it needs once, splits the block between its arrays, and frees everything
+// with a single call when the level ends. No leaks, no fragmentation, and all the data
+// of a level sits next to each other in memory (which the CPU cache loves).
+typedef struct MemoryArena {
+    unsigned char *base;      // Start of the block (NULL if the arena is empty).
+    size_t capacity;          // Total bytes in the block.
+    size_t used;              // Bytes already handed out.
+} MemoryArena;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in other files before defining what they actually do.
+
+// Reserves a block of 'capacity' bytes. Check 'base' before using it (NULL if there was no RAM left).
+MemoryArena CreateArena(size_t capacity);
+
+// Hands out 'size' bytes from the arena (aligned to 16 bytes, so any type fits safely).
+// Returns NULL if the arena is full. The memory is NOT cleared.
+void *ArenaAlloc(MemoryArena *arena, size_t size);
+
+// How many bytes ArenaAlloc() really takes for 'size' (including the alignment padding).
+// Add these up to know the exact 'capacity' to ask for in CreateArena().
+size_t ArenaAllocSize(size_t size);
+
+// Forgets everything handed out so far (the block is kept and reused).
+void ResetArena(MemoryArena *arena);
+
+// Gives the whole block back to the operating system.
+void DestroyArena(MemoryArena *arena);
+
+#endif // Ends the include guard
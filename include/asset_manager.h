@@ -0,0 +1,92 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef ASSET_MANAGER_H
+#define ASSET_MANAGER_H
+
+// We need 'size_t' for the memory budget.
+#include <stddef.h>
+
+// The assets themselves are still the globals of resource_manager.h ('planeModel', 'menuMusic'...).
+#include "resource_manager.h"
+
+
+// --- ASSET MANAGER ---
+// Loads the file-based assets in the background and only keeps the ones somebody needs.
+//
+// 1. LOADING: worker threads read the files from the disk, decode the sounds and build the
+//    terrain collision. The main thread only does what needs the GPU or the audio device
+//    (one model per frame), so the window keeps drawing while everything arrives.
+// 2. RESIDENCY: every screen "acquires" the assets it uses and "releases" them when it is left.
+//    An asset nobody holds stays in memory (maybe the player comes back) until the total goes
+//    over the memory budget: then the one unused for the longest time is freed.
+//
+// Until an asset is ready, its global stays zeroed: Raylib draws nothing and plays nothing with it.
+// There is only one asset manager, so its state lives inside asset_manager.c (like the text cache).
+
+
+// --- CONSTANTS ---
+#define ASSET_WORKER_COUNT 2                          // Background threads reading and decoding files.
+#define DEFAULT_ASSET_BUDGET (64u * 1024u * 1024u)    // Bytes of assets kept when nobody holds them.
+
+
+// --- DATA STRUCTURES ---
+// An 'enum' assigns names to numbers. One entry per file-based asset.
+typedef enum AssetID {
+    ASSET_TERRAIN = 0,        // environmentModel (and its collision data).
+    ASSET_SKYBOX,             // skyboxModel
+    ASSET_RING,               // ringModel
+    ASSET_PLANE_MODEL,        // planeModel
+    ASSET_HELICOPTER_MODEL,   // helicopterModel
+    ASSET_PLANE_SOUND,        // planeSound
+    ASSET_HELICOPTER_SOUND,   // helicopterSound
+    ASSET_MENU_MUSIC,         // menuMusic
+    ASSET_ENDING_MUSIC,       // endingMusic
+    ASSET_COUNT               // How many there are (not an asset).
+} AssetID;
+
+// Where an asset is on its way from the disk to the game.
+typedef enum AssetState {
+    ASSET_UNLOADED = 0,       // Not in memory.
+    ASSET_QUEUED,             // Waiting for a worker thread.
+    ASSET_READING,            // A worker is reading (and decoding) the file.
+    ASSET_READ,               // In RAM, waiting for the main thread to hand it to the GPU / audio device.
+    ASSET_BUILDING,           // Uploaded, a worker is building extra data (the terrain collision).
+    ASSET_RESIDENT,           // Ready: its global can be used.
+    ASSET_FAILED              // The file is missing or broken (Raylib has printed why).
+} AssetState;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Starts the worker threads. Called by LoadGameResources().
+void StartAssetManager(void);
+
+// Finishes whatever the workers have read (main thread, once per frame) and frees the unused
+// assets if the budget is exceeded. Never blocks.
+void UpdateAssetManager(void);
+
+// Blocks until every held asset is ready (or failed). For the benchmarks that need the terrain right away.
+void FinishAssetLoading(void);
+
+// Stops the threads and frees every asset. Called by UnloadGameResources().
+void StopAssetManager(void);
+
+// Holds an asset: it is loaded if needed and never freed until the matching ReleaseAsset().
+void AcquireAsset(AssetID id);
+void ReleaseAsset(AssetID id);
+
+// Starts loading an asset that will probably be needed soon, without holding it.
+void PrefetchAsset(AssetID id);
+
+// How far along the listed assets are, from 0.0f (none started) to 1.0f (all ready or failed).
+// The loading screen uses it for the assets of the screen it is waiting for.
+float GetAssetLoadingProgress(const AssetID *ids, int count);
+
+// How many bytes of assets may stay in memory (held assets are never freed, whatever the budget).
+void SetAssetMemoryBudget(size_t bytes);
+size_t GetAssetMemoryUsage(void);
+
+#endif // Ends the include guard
@@ -0,0 +1,23 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef CAMERA_H
+#define CAMERA_H
+
+// Include the main Raylib library so the compiler knows what 'Camera3D' is.
+// We also need player.h because the camera follows the player.
+#include "raylib.h"
+#include "player.h"
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Updates the camera position, target, and handles 1st/3rd person toggling.
+// It reads the gamepad/keyboard inputs to orbit around the player smoothly.
+// 'alpha' (0.0f to 1.0f) tells how far we are between the previous and the latest simulation tick.
+// This is part of the GAME, not of the simulation core: it needs a window and real input.
+void UpdateDynamicCamera(Camera3D *camera, Player *player, float alpha);
+
+#endif // Ends the include guard
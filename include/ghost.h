@@ -0,0 +1,106 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef GHOST_H
+#define GHOST_H
+
+// We need stdio.h for the 'FILE' stream, stdint.h for the run id that names the file,
+// and player.h for 'Player', 'Vector3' and 'VehicleType'.
+#include <stdio.h>
+#include <stdint.h>
+#include "player.h"
+
+
+// --- CONSTANTS ---
+// The first 4 bytes of every ghost file spell "GHS1".
+#define GHOST_MAGIC 0x31534847
+#define GHOST_VERSION 1
+
+// One keyframe every 12 simulation ticks (10 per second). The ghost is interpolated in between.
+#define GHOST_KEYFRAME_TICKS 12
+
+// Positions are stored as the movement since the previous keyframe, in 1/64 unit steps.
+#define GHOST_POSITION_SCALE 64.0f
+
+// The most keyframes we are allowed to decode in a single frame.
+// This keeps the cost of the ghost fixed, even right after a long freeze.
+#define GHOST_DECODE_BUDGET 4
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// A single decoded snapshot of the ghost aircraft.
+typedef struct GhostKeyframe {
+    float time;               // Race time of this snapshot (seconds).
+    Vector3 position;         // Where the aircraft was.
+    Vector3 rotation;         // Its tilt (pitch, yaw, roll).
+    VehicleType vehicle;      // Plane or helicopter at that moment.
+} GhostKeyframe;
+
+// Collects keyframes in RAM while the player flies (saved only if the run makes the leaderboard).
+typedef struct GhostRecorder {
+    unsigned char *data;      // Encoded keyframes.
+    int size;                 // Bytes used.
+    int capacity;             // Bytes allocated.
+
+    int keyframeCount;        // Number of keyframes stored.
+    int tickCounter;          // Ticks since the last keyframe.
+    Vector3 startPosition;    // Spawn position (keyframe 0, stored in the file header).
+    Vector3 startRotation;    // Spawn rotation.
+    VehicleType startVehicle; // Spawn vehicle.
+    Vector3 lastPosition;     // Position as the DECODER will see it (avoids drift from rounding).
+} GhostRecorder;
+
+// Streams a ghost file from the hard drive a few keyframes at a time.
+// Only the two keyframes around the current race time are kept in memory.
+typedef struct GhostPlayback {
+    FILE *file;               // The open ghost file (NULL if there is no ghost).
+    int keyframeCount;        // Keyframes in the whole file (including keyframe 0).
+    int keyframesLeft;        // Keyframes not decoded yet.
+    GhostKeyframe start;      // Keyframe 0 (from the file header), kept for RewindGhost().
+    Vector3 decodedPosition;  // Running position, rebuilt from the stored movements.
+
+    GhostKeyframe previous;   // Keyframe at or before the race time.
+    GhostKeyframe next;       // Keyframe after the race time.
+    bool isActive;            // False if there is no ghost for this level.
+} GhostPlayback;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Starts a new recording and stores the player's spawn pose as the first keyframe.
+void BeginGhostRecording(GhostRecorder *recorder, const Player *player);
+
+// Call once per simulation tick (after SimStep). Stores a keyframe every GHOST_KEYFRAME_TICKS ticks.
+void RecordGhostTick(GhostRecorder *recorder, const Player *player);
+
+// Writes the recorded trajectory to the hard drive. Returns false if the file couldn't be created.
+bool SaveGhost(GhostRecorder *recorder, const char *fileName);
+
+// Frees the RAM used by the recording.
+void UnloadGhostRecorder(GhostRecorder *recorder);
+
+// Opens a ghost file for streaming. Check 'isActive' before using it.
+GhostPlayback OpenGhost(const char *fileName);
+
+// Takes the ghost back to the start of its flight, for a quick restart of the same level.
+// The file stays open: it just seeks back to the first keyframe.
+void RewindGhost(GhostPlayback *ghost);
+
+// Decodes keyframes until the ghost reaches 'raceTime' (never more than GHOST_DECODE_BUDGET per call).
+void UpdateGhost(GhostPlayback *ghost, float raceTime);
+
+// Returns the ghost's pose at 'raceTime', interpolated between the two decoded keyframes.
+GhostKeyframe GetGhostPose(const GhostPlayback *ghost, float raceTime);
+
+// Closes the file.
+void CloseGhost(GhostPlayback *ghost);
+
+// Builds the file name of the ghost that belongs to a leaderboard run (named like its replay),
+// e.g. level 3, run 57 -> "data/times_lvl3_run57.ghost" (beside its replay and "data/times_lvl3.board").
+void GetGhostFileName(int levelID, uint32_t runID, char *outName, int outSize);
+
+#endif // Ends the include guard
@@ -6,19 +6,42 @@
 
 // Include the main Raylib library.
 // We also inclue player.h  so the compiler knows what 'VehicleType' is.
-// We also include standard C libraries for string manipulation and file Input/Output.
+// We also include standard C libraries for string manipulation, file Input/Output
+// and the fixed-size integers of the file layout.
 #include "raylib.h"
 #include "player.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
 
 
 // --- CONSTANTS ---
-// Defining the maximum entries and name length here makes it easy to adjust later 
+// Defining the maximum entries and name length here makes it easy to adjust later
 // without digging through the logic code.
-#define MAX_LEADERBOARD 10
+#define MAX_LEADERBOARD 10        // Runs shown per page (and the "top 10" that keeps its replays).
 #define MAX_NAME_LENGTH 15
 
+// The board files. Every run ever submitted is kept, sorted by time, in a B+tree of 4 KB pages.
+// Each inner page also stores how many runs sit under each of its children, so "which rank is
+// this time?" and "read ranks 500 to 510" only walk one path from the root (O(log n) page reads).
+#define LEADERBOARD_MAGIC "GLBD"
+#define LEADERBOARD_VERSION 1
+#define LEADERBOARD_PAGE_SIZE 4096
+
+// New runs never touch the board file. They are appended to a small journal beside it
+// ("data/times_lvl3.journal"), one checksummed record each, and the board is only ever replaced
+// as a whole. Once a level's journal holds LEADERBOARD_COMPACT_RUNS runs, or 1/LEADERBOARD_COMPACT_FRACTION
+// of the board if that is more, a background thread folds them into a fresh board (compaction) and
+// the journal starts over. Growing the threshold with the board keeps the rewrite cost per run the
+// same whether the board holds a hundred runs or millions.
+#define LEADERBOARD_JOURNAL_MAGIC "GLJR"
+#define LEADERBOARD_COMPACT_RUNS 64
+#define LEADERBOARD_COMPACT_FRACTION 16
+
+
+// Passed to AddLeaderboardRun for a run that has no id yet.
+#define LEADERBOARD_NEXT_SEQUENCE UINT32_MAX
+
 
 // --- DATA STRUCTURES ---
 // A 'struct' groups related variables into a single package.
@@ -28,30 +51,113 @@ typedef struct LeaderboardEntry {
     char name[MAX_NAME_LENGTH + 1]; // +1 to leave room for the invisible null-terminator '\0'.
     float time;                     // The total race time.
     VehicleType vehicle;            // Player's vehicle type.
+    uint32_t sequence;              // Unique id of the run (it names the run's replay and ghost files).
 } LeaderboardEntry;
 
-// The main system that holds the entire Top 10 list.
+// One page of the board, as the screens show it (ranks 'firstRank' to 'firstRank + count - 1').
 typedef struct Leaderboard {
     LeaderboardEntry entries[MAX_LEADERBOARD]; // The array holding up to 10 records.
     int count;                                 // How many records are currently stored (0 to 10).
+    int firstRank;                             // Rank of entries[0] (1 = the fastest run).
+    int totalCount;                            // Runs in the whole board.
 } Leaderboard;
 
+// One run as it is stored in the board file (28 bytes).
+typedef struct LeaderboardRecord {
+    float time;
+    uint32_t sequence;              // Submission order: on equal times, the earlier run ranks higher.
+    int32_t vehicle;
+    char name[MAX_NAME_LENGTH + 1];
+} LeaderboardRecord;
+
+// Page 0 of every board file.
+typedef struct LeaderboardFileHeader {
+    char magic[4];                  // LEADERBOARD_MAGIC.
+    uint32_t version;               // LEADERBOARD_VERSION.
+    uint32_t pageSize;              // LEADERBOARD_PAGE_SIZE.
+    uint32_t rootPage;              // Where the tree starts.
+    uint32_t pageCount;             // Pages in the file (including this one).
+    uint32_t height;                // Levels of the tree (1 = the root is a leaf).
+    uint32_t runCount;              // Runs stored.
+    uint32_t nextSequence;          // 'sequence' of the next run.
+} LeaderboardFileHeader;
+
+// One record of the journal (36 bytes).
+typedef struct LeaderboardJournalRecord {
+    char magic[4];                  // LEADERBOARD_JOURNAL_MAGIC.
+    uint32_t checksum;              // Of 'run': a record cut short by a crash or power loss never matches.
+    LeaderboardRecord run;
+} LeaderboardJournalRecord;
+
+// An open board: the board file plus the journal runs that aren't in it yet.
+// Open it, ask or add what you need, and close it again.
+typedef struct LeaderboardStore {
+    int levelID;
+    FILE *file;                     // The board file (NULL until the level's first compaction).
+    LeaderboardFileHeader header;
+
+    LeaderboardRecord *pending;     // Journal runs newer than the board, sorted like the board.
+    int pendingCount;
+    int pendingCapacity;
+    uint32_t nextSequence;          // 'sequence' of the next run.
+} LeaderboardStore;
+
 
 // --- FUNCTION PROTOTYPES ---
 // These declarations tell the compiler the names of our functions and what parameters they take,
 // so it doesn't panic when we call them in main.c before defining what they actually do.
 
-// Reads the text file from the hard drive and loads the saved times into RAM.
-// It returns a full 'Leaderboard' struct (passed by value).
-Leaderboard LoadLeaderboard(const char *filename);
+// The board file of a level ("data/times_lvl3.board").
+void GetLeaderboardFileName(int levelID, char *outName, int outSize);
+
+// The journal of a level ("data/times_lvl3.journal").
+void GetLeaderboardJournalName(int levelID, char *outName, int outSize);
 
-// Writes the current leaderboard from RAM into a text file on the hard drive.
-// We pass a POINTER (*lb) to avoid copying the entire array just to read it.
-void SaveLeaderboard(Leaderboard *lb, const char *filename);
+// Creates the 'data' folder every board, journal, replay and ghost lives in.
+// If the folder already exists, it just silently does nothing.
+void CreateLeaderboardFolder(void);
+
+// Opens the board of a level for adding runs (and creates the 'data' folder).
+// It replays the journal, dropping any record a crash left half-written.
+// A level seen for the first time imports its old top 10 ("data/times_lvl3.txt") if there is one.
+// Returns false if the board file exists but can't be read.
+bool OpenLeaderboardStore(LeaderboardStore *store, int levelID);
+
+// Opens the board of a level just for reading: nothing is ever created or repaired.
+// Returns false if the level has no board and no journal yet.
+bool OpenLeaderboardStoreReadOnly(LeaderboardStore *store, int levelID);
+
+// Closes the files and frees the journal runs. Every added run is already on the disk.
+void CloseLeaderboardStore(LeaderboardStore *store);
+
+// Adds a run and returns its rank (1 = the fastest), or 0 if it couldn't be written.
+// Nobody is ever dropped from the board. The run is on the disk when this returns.
+// 'sequence' is the id the run was already given (its replay and ghost files are named after it),
+// or LEADERBOARD_NEXT_SEQUENCE to take the next free one.
+int AddLeaderboardRun(LeaderboardStore *store, const char *name, float time, VehicleType vehicle, uint32_t sequence);
+
+// The rank a run of 'time' would get if it was added now.
+int GetLeaderboardRank(LeaderboardStore *store, float time);
+
+// Reads up to MAX_LEADERBOARD runs starting at rank 'firstRank' (1 = the fastest).
+Leaderboard ReadLeaderboardPage(LeaderboardStore *store, int firstRank);
+
+// Copies the time of every run, fastest first, into 'outTimes' (at most 'maxCount').
+// Returns how many were copied.
+int ReadLeaderboardTimes(LeaderboardStore *store, float *outTimes, int maxCount);
+
+// Cleans a pilot name the way the board stores it (spaces become '_', an empty name becomes "UNKNOWN").
+// 'outName' must hold MAX_NAME_LENGTH + 1 characters.
+void SanitizeLeaderboardName(const char *name, char *outName);
+
+// Shortcut for the screens: opens the level's board, reads one page and closes it again.
+// It never creates a file: a level without a board just returns an empty page.
+// It returns a full 'Leaderboard' struct (passed by value).
+Leaderboard LoadLeaderboard(int levelID, int firstRank);
 
-// Evaluates a new time, finds its proper sorted position (lowest to highest), 
-// shifts the slower times down, and inserts the new record.
-// We pass a POINTER (*lb) because we need to modify the actual leaderboard array.
-void AddLeaderboardEntry(Leaderboard *lb, const char *name, float time, VehicleType vehicle);
+// Waits for the compaction running right now (if any) and stops the background thread.
+// Levels still waiting keep their journal and get compacted on a later launch.
+// Must be called once right before closing the program.
+void StopLeaderboardCompaction(void);
 
-#endif // Ends the include guard
\ No newline at end of file
+#endif // Ends the include guard
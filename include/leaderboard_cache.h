@@ -0,0 +1,72 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef LEADERBOARD_CACHE_H
+#define LEADERBOARD_CACHE_H
+
+// We need leaderboard.h for 'Leaderboard' and 'LeaderboardEntry' (what the screens get back).
+#include "leaderboard.h"
+
+
+// --- LEADERBOARD CACHE ---
+// Keeps the boards of every level in RAM, read ONCE when the game starts, so the menus and the
+// HUD can ask "what is the record?" or "which rank would this time get?" every frame without
+// touching the hard drive.
+// For each level it holds the top runs (names and all) and the time of every run, sorted.
+// New runs go into the cache right away; a background thread writes them to the board files
+// (see leaderboard.h) a moment later.
+//
+// There is only one cache, so its state lives inside leaderboard_cache.c (like the text cache).
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// The run the player is racing against right now: the fastest one a finish at this very moment
+// would still beat, i.e. the first run slower than the race time (the record, while the player
+// is on pace for it).
+typedef struct LeaderboardTarget {
+    bool hasTarget;             // false = no runs yet, or already slower than all of them.
+    int rank;                   // Its rank, which the player would take by finishing now (1 = the record).
+    float time;
+    float delta;                // Race time minus its time (negative = still ahead of it).
+} LeaderboardTarget;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Reads the boards of levels 1 to 'levelCount' and starts the writer thread.
+// Levels outside that range are read the first time they are asked for.
+void LoadLeaderboardCache(int levelCount);
+
+// Writes every run still waiting, stops the writer thread and frees the cache.
+// Must be called once right before closing the program.
+void UnloadLeaderboardCache(void);
+
+// Adds a finished run to the cache and hands it to the writer thread.
+// Returns its rank (1 = the fastest).
+int SubmitLeaderboardRun(int levelID, const char *name, float time, VehicleType vehicle);
+
+// The top 10 of a level (ranks 1 to 10, plus how many runs there are in total).
+Leaderboard GetCachedLeaderboard(int levelID);
+
+// Any page of a level's board. The first page comes from the cache; later ones are read from the
+// board file once the writer thread has saved every run (menus only: it may wait for the disk).
+Leaderboard GetLeaderboardPage(int levelID, int firstRank);
+
+// Copies the run at 'rank' into 'outEntry'. Only the top MAX_LEADERBOARD + 1 ranks are cached
+// (the one just below the top 10 tells whose replay drops out). Returns false if there is none.
+bool GetCachedRun(int levelID, int rank, LeaderboardEntry *outEntry);
+
+// The rank a run of 'time' would get if it was added now.
+int GetCachedRank(int levelID, float time);
+
+// The run to beat for a race that has been going on for 'raceTime' seconds (see LeaderboardTarget).
+LeaderboardTarget GetLeaderboardTarget(int levelID, float raceTime);
+
+// Waits until the writer thread has saved every submitted run.
+void FlushLeaderboardWrites(void);
+
+#endif // Ends the include guard
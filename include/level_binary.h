@@ -0,0 +1,88 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef LEVEL_BINARY_H
+#define LEVEL_BINARY_H
+
+// Fixed-size integer types, so the file layout is the same whatever 'int' and 'long' are.
+#include <stdint.h>
+
+// We need race.h for 'RaceSystem' (what a compiled level turns into).
+#include "race.h"
+
+
+// --- CONSTANTS ---
+// Every compiled level starts with these 4 bytes, so a random file is never mistaken for one.
+#define LEVEL_BINARY_MAGIC "GLVL"
+
+// Bump this whenever the layout below (or the Ring/RingFrames structs) changes:
+// old files are then simply ignored and the text is parsed again until they are recompiled.
+#define LEVEL_BINARY_VERSION 1
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// The header at the start of every 'lvlN.bin'. It holds the whole level except the ring arrays,
+// which follow it (from LEVEL_BINARY_PAYLOAD_OFFSET) exactly as they sit in RAM:
+// Ring[], Matrix[] and the 9 RingFrames arrays, in the order of CarveRaceRings().
+//
+// The file is only valid on the kind of machine that wrote it (same endianness and struct layout).
+// 'headerSize' and 'ringSize' catch a different compiler or platform, and the file is then ignored.
+typedef struct LevelBinaryHeader {
+    char magic[4];              // LEVEL_BINARY_MAGIC.
+    uint32_t version;           // LEVEL_BINARY_VERSION.
+    uint32_t headerSize;        // sizeof(LevelBinaryHeader) on the machine that wrote it.
+    uint32_t ringSize;          // sizeof(Ring) on the machine that wrote it.
+
+    // The text file it was compiled from. If it has been edited since, the binary is stale.
+    int64_t sourceSize;
+    int64_t sourceModTime;
+
+    uint64_t payloadSize;       // Bytes of ring arrays after the header.
+    uint64_t checksum;          // Of the header (with this field at 0) and the ring arrays.
+
+    // --- GLOBAL MISSION DATA ---
+    int32_t missionType;
+    Vector3 startPos;
+    float startYaw;
+
+    // --- MISSION TYPE 0: RINGS DATA ---
+    int32_t ringCapacity;       // Rings the arrays have room for ('declaredRings').
+    int32_t totalRings;         // Rings actually read from the text file.
+
+    // --- MISSION TYPE 1: LANDING DATA ---
+    Vector3 landingZone;
+    float landingRadius;
+    float maxLandingSpeed;
+    int32_t padMoveType;
+    Vector3 padOrigin;
+    Vector3 padVelocity;
+    float padAccel;
+    float currentPadSpeed;
+    float currentPadAngle;
+    float padRadius;
+} LevelBinaryHeader;
+
+// Where the ring arrays start: right after the header, rounded up so every array stays 16-byte aligned.
+#define LEVEL_BINARY_PAYLOAD_OFFSET (ArenaAllocSize(sizeof(LevelBinaryHeader)))
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Writes 'race' (freshly built by LoadRaceText() from 'sourceFile') into the compiled file 'binaryFile'.
+// The file is written next to it first and then renamed, so a running game never sees half a file.
+// Returns false if it couldn't be written.
+bool WriteLevelBinary(const RaceSystem *race, const char *sourceFile, const char *binaryFile);
+
+// Maps 'binaryFile' into memory and points the ring arrays of 'race' straight into it (no parsing).
+// Returns false (and leaves 'race' untouched) if the file is missing, damaged, from another version,
+// or older than 'sourceFile': the caller then parses the text instead.
+bool LoadLevelBinary(const char *binaryFile, const char *sourceFile, RaceSystem *race);
+
+// Releases the mapped file of 'race', if it has one. Called by UnloadRace().
+void UnloadLevelBinary(RaceSystem *race);
+
+#endif // Ends the include guard
@@ -0,0 +1,52 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef LEVEL_CATALOG_H
+#define LEVEL_CATALOG_H
+
+// Include the main Raylib library so the compiler knows what 'Vector3' is.
+#include "raylib.h"
+
+
+// --- CONSTANTS ---
+// The level select screen is a 5x5 grid, so levels 1 to 25 can be listed.
+#define MAX_CATALOG_LEVELS 25
+#define MAX_LEVEL_NAME_LENGTH 49
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// Everything the menus need to know about one level file, read from its header.
+// The rings themselves are NOT loaded here; InitRace() still does that when the level is played.
+typedef struct LevelInfo {
+    bool exists;                               // false = there is no 'lvlN.txt' for this slot.
+    char name[MAX_LEVEL_NAME_LENGTH + 1];      // First line of the file (the mission title).
+    int missionType;                           // 0 = Rings, 1 = Landing.
+    int ringCount;                             // Rings declared by the file (0 for landing missions).
+    Vector3 startPos;                          // Where the player spawns.
+    float startYaw;                            // Which way the player faces at the start.
+    long modifiedTime;                         // Last time the file was saved (seconds since 1970).
+} LevelInfo;
+
+// The list of every level on disk, built ONCE when the game starts.
+// The menu reads only from here, so drawing it never touches the hard drive.
+typedef struct LevelCatalog {
+    LevelInfo levels[MAX_CATALOG_LEVELS];      // Slot 0 is level 1, slot 1 is level 2...
+    int count;                                 // Playable levels: 1 to 'count' all exist, with no gaps.
+} LevelCatalog;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Lists the 'lvlN.txt' files of 'directory' once and reads the header of each one.
+// It returns a full 'LevelCatalog' struct (passed by value).
+LevelCatalog ScanLevelCatalog(const char *directory);
+
+// Returns the catalog entry for 'levelID' (starting at 1), or NULL if it is outside the grid.
+// Check 'exists' before using the rest of the fields.
+const LevelInfo *GetLevelInfo(const LevelCatalog *catalog, int levelID);
+
+#endif // Ends the include guard
@@ -0,0 +1,39 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef LEVEL_WATCHER_H
+#define LEVEL_WATCHER_H
+
+// We need race.h for 'RaceSystem' (what a reloaded level turns into).
+#include "race.h"
+
+
+// --- LEVEL HOT-RELOAD ---
+// Lets level designers edit 'levels/lvlN.txt' while flying it.
+// A background thread waits for the OS to report that a level file was saved (Linux inotify),
+// parses it there, and leaves the finished RaceSystem in a mailbox. The game picks it up between
+// two simulation ticks, so the parsing never costs a frame.
+// On other systems the watcher simply never reports anything.
+//
+// There is only one watcher, so its state lives inside level_watcher.c (like the text cache).
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Starts watching the level files of 'directory'. Returns false if it isn't available on this system.
+bool StartLevelWatcher(const char *directory);
+
+// Chooses which level gets reloaded (the one being played). Saves to any other level are ignored:
+// they are read normally the next time that level is picked from the menu.
+void WatchLevel(int levelID);
+
+// If the watched level was saved and parsed since the last call, moves the new race into 'outRace'
+// and returns true. The caller owns it from then on (release it with UnloadRace()).
+bool PollLevelReload(RaceSystem *outRace);
+
+// Stops the thread and frees anything still waiting in the mailbox.
+void StopLevelWatcher(void);
+
+#endif // Ends the include guard
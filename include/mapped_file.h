@@ -0,0 +1,55 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+// We need stdio.h for 'FILE', stdint.h for the 64-bit checksum, stddef.h for 'size_t'
+// and stdbool.h for 'bool'.
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+
+// --- MAPPED FILES ---
+// The helpers shared by the files the game writes once and then maps on every launch
+// (compiled levels, see level_binary.h, and cached models, see mesh_cache.h):
+// a fast checksum, a way to read a whole file as one block of memory, and a way to
+// replace a file so that a crash never leaves half of it behind.
+
+
+// --- CONSTANTS ---
+// Starting value of ChecksumBytes() (the FNV-1a 64-bit offset basis).
+#define CHECKSUM_SEED 14695981039346656037ull
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in other files before defining what they actually do.
+
+// FNV-1a, fed 8 bytes at a time so hashing a big file costs about as much as copying it once.
+// It isn't meant to stop tampering, only to notice a file that was cut short or damaged on disk.
+// Start with CHECKSUM_SEED; pass the result back in to keep hashing more bytes.
+uint64_t ChecksumBytes(uint64_t hash, const unsigned char *data, size_t size);
+
+// Makes the whole file readable as one block of memory and writes its size into 'outSize'.
+// Returns NULL if the file is missing or empty.
+// 'isWritable' gives a private copy-on-write mapping: writes only change our copy of the
+// touched pages, never the file on disk.
+// (Memory-mapped files are a POSIX feature. Windows gets a plain read of the whole file instead.)
+unsigned char *MapFile(const char *fileName, size_t *outSize, bool isWritable);
+
+// Releases a block returned by MapFile().
+void UnmapFile(void *data, size_t size);
+
+// Opens "<fileName>.tmp" for writing and copies its name into 'outTempName'.
+// Write the new contents into it, then hand it to CommitReplacementFile().
+FILE *OpenReplacementFile(const char *fileName, char *outTempName, int tempNameSize);
+
+// Closes the temporary file and, if it was fully written ('isWritten' and a clean close),
+// swaps it in for 'fileName' with one rename, so nobody ever maps a half-written file.
+// Otherwise the temporary file is deleted and the old one stays. Returns true if it was swapped in.
+bool CommitReplacementFile(FILE *file, const char *tempName, const char *fileName, bool isWritten);
+
+#endif // Ends the include guard
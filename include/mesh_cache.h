@@ -0,0 +1,118 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+// Fixed-size integer types, so the file layout is the same whatever 'int' and 'long' are.
+#include <stdint.h>
+
+// Include the main Raylib library so the compiler knows what 'Model', 'Mesh' and 'Image' are.
+#include "raylib.h"
+
+
+// --- MESH CACHE ---
+// Parsing a .glb file (JSON, accessors, embedded PNGs) is most of the time a model takes to load.
+// The first time a model is loaded, its meshes and textures are saved next to it ('apache.glb' ->
+// 'apache.mesh') exactly as the GPU wants them: raw vertex/index arrays and raw RGBA pixels, with the
+// model's fixup rotation already applied to the vertices. Later launches map that file into memory
+// and only copy the arrays out, which a worker thread can do (no OpenGL involved).
+//
+// The cache is tied to the exact bytes of the .glb (a hash of the whole file), so replacing a model
+// simply makes the game parse it again and save a new cache.
+
+
+// --- CONSTANTS ---
+// Every cache file starts with these 4 bytes, so a random file is never mistaken for one.
+#define MESH_CACHE_MAGIC "GMSH"
+
+// Bump this whenever the layout below changes: old caches are then rebuilt on the next launch.
+#define MESH_CACHE_VERSION 1
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// The header at the start of every cache file. It is followed by a MeshCacheMesh for every mesh,
+// a MeshCacheMaterial for every material, then the vertex arrays of every mesh and the pixels of
+// every texture (each block rounded up to 16 bytes).
+typedef struct MeshCacheHeader {
+    char magic[4];              // MESH_CACHE_MAGIC.
+    uint32_t version;           // MESH_CACHE_VERSION.
+    uint32_t headerSize;        // sizeof(MeshCacheHeader) on the machine that wrote it.
+    int32_t meshCount;
+    int32_t materialCount;
+    int32_t reserved;           // Keeps the 64-bit fields below aligned.
+
+    // The .glb it was built from. If its bytes change, the cache is stale.
+    uint64_t sourceSize;
+    uint64_t sourceHash;
+
+    Matrix fixup;               // The rotation baked into the vertices (it must match what the game asks for).
+
+    uint64_t payloadSize;       // Bytes after the header.
+    uint64_t checksum;          // Of the header (with this field at 0) and the payload.
+} MeshCacheHeader;
+
+// Which vertex arrays a mesh has (bits of MeshCacheMesh.arrays), in the order they are stored.
+#define MESH_CACHE_VERTICES   (1u << 0)
+#define MESH_CACHE_TEXCOORDS  (1u << 1)
+#define MESH_CACHE_TEXCOORDS2 (1u << 2)
+#define MESH_CACHE_NORMALS    (1u << 3)
+#define MESH_CACHE_TANGENTS   (1u << 4)
+#define MESH_CACHE_COLORS     (1u << 5)
+#define MESH_CACHE_INDICES    (1u << 6)
+#define MESH_CACHE_ARRAY_COUNT 7
+
+typedef struct MeshCacheMesh {
+    int32_t vertexCount;
+    int32_t triangleCount;
+    int32_t material;           // Index into the materials.
+    uint32_t arrays;            // MESH_CACHE_* bits.
+} MeshCacheMesh;
+
+typedef struct MeshCacheMaterial {
+    Color color;                // Albedo tint.
+    int32_t width;              // Albedo texture size in pixels (0 = no texture).
+    int32_t height;
+} MeshCacheMaterial;
+
+// A model read back from a cache file: every array is already in RAM, but nothing is on the GPU yet.
+typedef struct CachedModel {
+    int meshCount;
+    Mesh *meshes;               // CPU arrays only (not uploaded).
+    int *meshMaterial;
+
+    int materialCount;
+    Color *materialColors;
+    Image *materialImages;      // RGBA pixels of every albedo texture ('data' is NULL without one).
+} CachedModel;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// The hash a cache is tied to: FNV-1a over the whole source file.
+uint64_t HashMeshSource(const unsigned char *data, size_t size);
+
+// The cache file of a model ("resources/models/apache.glb" -> "resources/models/apache.mesh").
+void GetMeshCacheFileName(const char *sourceFile, char *outFileName, int outSize);
+
+// Reads 'cacheFile' into 'outModel' if it was built from a source of that size and hash, with that fixup.
+// Returns false (and leaves 'outModel' empty) otherwise. It never touches the GPU, so any thread may call it.
+bool LoadMeshCache(const char *cacheFile, uint64_t sourceSize, uint64_t sourceHash, Matrix fixup, CachedModel *outModel);
+
+// Uploads a cached model to the GPU and turns it into a normal Model (free it with UnloadModel()).
+// 'cached' is emptied: the Model owns its arrays now. Main thread only.
+Model UploadCachedModel(CachedModel *cached);
+
+// Frees a cached model that was never uploaded.
+void UnloadCachedModel(CachedModel *cached);
+
+// Saves 'model' (just loaded from the source, with 'model.transform' holding its fixup) as a cache.
+// The textures are read back from the GPU, so this runs on the main thread. Returns false if the model
+// can't be cached (animated models), a texture couldn't be read back, or the file couldn't be written.
+bool WriteMeshCache(const char *cacheFile, Model model, uint64_t sourceSize, uint64_t sourceHash);
+
+#endif // Ends the include guard
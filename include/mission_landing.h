@@ -24,13 +24,6 @@ typedef struct RaceSystem RaceSystem;
 // VERY IMPORTANT: We pass POINTERS to both the race and the player.
 // We need the race pointer to update the mission status (success/failure) and timers.
 // We need the player pointer to physically check their exact 3D coordinates, velocity, and tilt.
-void UpdateMissionLanding(RaceSystem *race, Player *player);
-
-// Draws the 3D models for the landing sequence (helipads, runway lights, or approach path).
-// We pass POINTERS to avoid copying large structures into memory 60 times per second.
-void DrawMissionLanding3D(RaceSystem *race, Player *player);
-
-// Draws the specific UI for the landing mission (altitude warnings, speed indicators, distance to target).
-void DrawMissionLandingUI(RaceSystem *race);
+void UpdateMissionLanding(RaceSystem *race, Player *player, float dt);
 
 #endif // Ends the include guard
\ No newline at end of file
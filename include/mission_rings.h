@@ -9,10 +9,8 @@
 #include "raylib.h"
 #include "player.h"
 
-
-// --- CONSTANTS ---
-// Defining the number of rings here makes it easy to add more later without changing the logic.
-#define MAX_RINGS 50
+// The ring grid keeps its lists in its own memory arena.
+#include "arena.h"
 
 
 // --- DATA STRUCTURES ---
@@ -28,6 +26,37 @@ typedef struct Ring {
     bool active;      // True if the player still needs to fly through this ring.
 } Ring;
 
+// The collision data of every ring, calculated ONCE when the level loads.
+// Instead of one struct per ring ("Array of Structures"), every value gets its own array
+// ("Structure of Arrays"): all the X centres together, all the Y centres together, etc.
+// The quick distance check then reads a few tightly packed arrays from start to end,
+// which the compiler can turn into SIMD instructions that test several rings at once.
+typedef struct RingFrames {
+    float *centerX;        // Ring centres.
+    float *centerY;
+    float *centerZ;
+    float *normalX;        // Which way the hole faces (unit vector, from the yaw and pitch).
+    float *normalY;
+    float *normalZ;
+    float *radius;         // Distance from the centre to the core of the tube.
+    float *tubeThickness;  // How close to the tube core counts as a crash.
+    float *boundRadiusSqr; // Squared radius of a sphere that contains the whole ring (plus a margin).
+} RingFrames;
+
+// A uniform 3D grid over the circuit, built once when the level loads ("broadphase").
+// The world is split into equal cubes and every ring is listed in each cube its bounding sphere touches.
+// Every tick we look up the ONE cube the player is in, and only test the rings listed there,
+// so the cost per tick stays the same whether the circuit has 10 rings or 50,000.
+// The cubes are stored in a hash table: cube coordinates -> bucket, and every bucket is a slice
+// of one big list of ring numbers (sorted from first to last ring).
+typedef struct RingGrid {
+    MemoryArena arena;     // Holds 'bucketStart' and 'ringIndices' (freed by UnloadRace).
+    float cellSize;        // Edge length of every cube (big enough for the largest ring).
+    unsigned int bucketMask; // Number of buckets - 1 (the bucket count is a power of two).
+    int *bucketStart;      // Bucket 'b' owns ringIndices[bucketStart[b]] to ringIndices[bucketStart[b + 1] - 1].
+    int *ringIndices;      // Ring numbers of every bucket, one bucket after another.
+} RingGrid;
+
 
 // --- FORWARD DECLARATION ---
 // We tell the compiler that the "RaceSystem" struct exists somewhere else (in race.h).
@@ -39,17 +68,29 @@ typedef struct RaceSystem RaceSystem;
 // These declarations tell the compiler the names of our functions and what parameters they take,
 // so it doesn't panic when we call them in race.c before defining what they actually do.
 
+// Builds the cached world matrix (position, rotation and size) of every ring in the circuit.
+// Rings never move, so InitRace() calls this once and the renderer just reuses the results.
+void BuildRingTransforms(RaceSystem *race);
+
+// Builds the collision data (RingFrames) of every ring, so the per-tick checks need no sinf/cosf.
+// Also called once by InitRace().
+void BuildRingFrames(RaceSystem *race);
+
+// Sorts the rings into the broadphase grid (RingGrid). Needs the RingFrames, so call it after BuildRingFrames().
+// Returns false if there wasn't enough memory (the rings then can't be hit or crossed).
+bool BuildRingGrid(RaceSystem *race);
+
+// Frees the grid's RAM.
+void UnloadRingGrid(RingGrid *grid);
+
 // Updates the ring mission logic (collisions and target progression).
 // VERY IMPORTANT: We pass POINTERS to both the race and the player.
 // We need the race pointer to update the target ring and mark rings as inactive.
 // We need the player pointer (read-only in this case) to check their exact 3D coordinates.
-void UpdateMissionRings(RaceSystem *race, Player *player);
-
-// Draws the 3D models of the rings and the navigation arrow.
-// We pass POINTERS to avoid copying the whole array of rings into memory 60 times per second.
-void DrawMissionRings3D(RaceSystem *race, Player *player);
+void UpdateMissionRings(RaceSystem *race, Player *player, float dt);
 
-// Draws the specific UI for the rings mission (remaining rings text, etc.).
-void DrawMissionRingsUI(RaceSystem *race);
+// Writes a colour into the bottom row of a ring's cached matrix, where the ring shader reads it.
+// race_draw.c uses it to paint the target ring GOLD.
+void SetRingInstanceColor(Matrix *transform, Color color);
 
 #endif // Ends the include guard
\ No newline at end of file
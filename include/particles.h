@@ -0,0 +1,80 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+// We need player.h for 'Player' (the smoke emitter) and Raylib's 'Vector3' and 'Matrix'.
+// Every particle array lives in one memory arena.
+#include "player.h"
+#include "arena.h"
+
+
+// --- CONSTANTS ---
+// The most smoke particles alive at once. The smoke only needs a few hundred,
+// but the system is built to draw tens of thousands in a single GPU call.
+#define PARTICLE_CAPACITY 32768
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// A pool of simple particles (smoke puffs) that rise, drift and fade out.
+//
+// Storage: "Structure of Arrays". Every value has its own tightly packed array, so the update loop
+// is the same few additions over long arrays, which the compiler turns into SIMD instructions.
+//
+// Allocation: a ring buffer. Every particle lives exactly as long as the others, so they always die
+// in the same order they were born. The live particles are one block that starts at 'oldest' and
+// wraps around the end of the arrays: a new particle goes right after the newest one, and dead
+// ones fall off the front. Spawning and removing a particle never searches for a free slot.
+typedef struct ParticleSystem {
+    MemoryArena arena;        // One block of RAM holding every array below.
+    int capacity;             // Size of every array.
+    int oldest;               // Slot of the oldest live particle.
+    int count;                // Number of live particles (from 'oldest' onwards, wrapping around).
+
+    float *positionX;         // Where every particle is in the 3D world.
+    float *positionY;
+    float *positionZ;
+    float *velocityX;         // Its chaotic drift (per 60 Hz frame).
+    float *velocityY;
+    float *velocityZ;
+    float *life;              // How much time it has left before disappearing (1.0f to 0.0f).
+
+    float fadePerFrame;       // Life lost per 60 Hz frame.
+    float risePerFrame;       // Extra upward movement per 60 Hz frame (hot smoke rises).
+
+    Matrix *instances;        // Per-particle data handed to the GPU every frame (see DrawParticles).
+} ParticleSystem;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Creates an empty particle pool with room for 'capacity' particles.
+// Check 'capacity' afterwards: it is 0 if there wasn't enough memory.
+ParticleSystem CreateParticleSystem(int capacity, float fadePerFrame, float risePerFrame);
+
+// Spawns one particle with full life. If the pool is full, the oldest particle is replaced.
+void EmitParticle(ParticleSystem *particles, Vector3 position, Vector3 velocity);
+
+// Moves and fades every live particle by 'dt' seconds, and removes the ones that died.
+void UpdateParticles(ParticleSystem *particles, float dt);
+
+// Removes every particle at once.
+void ClearParticles(ParticleSystem *particles);
+
+// Draws every live particle as a camera-facing soft puff, all in ONE instanced draw call.
+// Must be called inside BeginMode3D(), after the solid models (the puffs are see-through).
+void DrawParticles(ParticleSystem *particles);
+
+// Frees the RAM used by the pool.
+void UnloadParticleSystem(ParticleSystem *particles);
+
+// Spawns the twin smoke trails of the plane into 'smoke'.
+// Purely visual, so it lives outside the simulation core and is only called by the game.
+void UpdateSmokeTrails(Player *player, ParticleSystem *smoke, float dt);
+
+#endif // Ends the include guard
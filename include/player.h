@@ -11,9 +11,10 @@
 
 
 // --- CONSTANTS ---
-// Defining the maximum number of smoke particles on screen here
-// makes it easy to add more later without changing the logic.
-#define MAX_PARTICLES 200
+// The simulation runs at a FIXED rate, completely independent of the monitor's refresh rate.
+// This keeps the physics identical at 30, 60 or 240 FPS.
+#define SIM_TICK_RATE 120
+#define SIM_DT (1.0f / SIM_TICK_RATE)
 
 
 // --- ENUMERATIONS (STATES) ---
@@ -31,14 +32,14 @@ typedef enum VehicleType {
 // --- DATA STRUCTURES ---
 // A 'struct' groups related variables into a single package.
 
-// Defines the physical properties, movement, lifespan, and active state 
-// of a single visual smoke entity within the 3D world.
-typedef struct Particle {
-    Vector3 position; // Where the smoke is in the 3D world.
-    Vector3 velocity; // Controls the chaotic drift.
-    float life;       // How much time it has left before disappearing (1.0f to 0.0f).
-    bool active;      // Is this particle currently being used?
-} Particle;
+// The pilot's controls for ONE simulation tick, already read from the keyboard or the gamepad.
+// The physics never talk to the hardware directly: main.c fills this package and hands it over.
+// That way the exact same physics can be driven by a recording, a script or a batch tool with no window.
+typedef struct PilotInput {
+    float throttle;   // Engine: +1.0f accelerates (W / RT), -1.0f brakes or reverses (S / LT).
+    float yaw;        // Steering: +1.0f turns the nose left (A), -1.0f turns it right (D).
+    float pitch;      // Nose: +1.0f climbs (SPACE / stick back), -1.0f dives (LEFT SHIFT / stick forward).
+} PilotInput;
 
 // A comprehensive container that stores the current state, physics parameters, vehicle type, 
 // and visual effects pool of the user's controlled aircraft.
@@ -47,6 +48,9 @@ typedef struct Player {
     Vector3 velocity;              // Current speed and direction of movement.
     Vector3 rotation;              // Controls the visual tilt (Pitch, Yaw, Roll).
 
+    Vector3 prevPosition;          // Position at the start of the last simulation tick (for render interpolation and ring crossing).
+    Vector3 prevRotation;          // Rotation at the start of the last simulation tick (for render interpolation).
+
     float throttle;                // Engine power (Continuous movement).
     float acceleration;            // How quickly the vehicle gains speed when a key is pressed.
     float friction;                // Momentum decay multiplier (slows the vehicle down over time).
@@ -58,7 +62,7 @@ typedef struct Player {
     float cameraAnglePitch;        // Manual orbit camera vertical angle.
 
     float smokeDelayTimer;         // Timer for vehicle's switching.
-    Particle smoke[MAX_PARTICLES]; // Particle pool.
+    float smokeEmitTimer;          // Accumulates 60 Hz frames so the smoke density doesn't depend on the tick rate.
 } Player;
 
 
@@ -73,18 +77,20 @@ typedef struct Player {
 // copy in RAM that the main game loop will take ownership of.
 Player InitPlayer(VehicleType type, Vector3 startPos, float startYaw);
 
-// Updates the physics and reads the input for the player.
+// Updates the physics of the player using the controls stored in 'input'.
 // VERY IMPORTANT: Notice the asterisk (*). We are passing a POINTER to the player.
 // Why? Because if we just passed 'Player player', C would create a temporary COPY of it, 
 // update the copy, and destroy it, leaving our real player untouched.
 // By passing the memory address (*player), this function modifies the actual player in main.c.
-void UpdatePlayer(Player *player);
+// 'dt' is the fixed length of one simulation tick in seconds (SIM_DT).
+// It never reads the keyboard, the gamepad or the clock, so it also works without a window.
+void UpdatePlayer(Player *player, const PilotInput *input, float dt);
 
 // Calculates and returns the normalized 3D vector pointing exactly where the player's nose is facing.
 Vector3 GetPlayerForwardVector(Player *player);
 
-// Updates the camera position, target, and handles 1st/3rd person toggling.
-// It reads the gamepad/keyboard inputs to orbit around the player smoothly.
-void UpdateDynamicCamera(Camera3D *camera, Player *player);
+// Returns a copy of the player with its position and rotation interpolated between
+// the previous and the latest simulation tick. Used only for drawing.
+Player GetInterpolatedPlayer(const Player *player, float alpha);
 
 #endif // Ends the include guard
\ No newline at end of file
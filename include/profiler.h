@@ -0,0 +1,92 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Fixed-size integer types for the timestamps (nanoseconds don't fit in 32 bits).
+#include <stdint.h>
+#include <stdbool.h>
+
+
+// --- FRAME PROFILER ---
+// Measures how long each phase of a frame takes (input, physics, each part of the drawing...).
+// Every measured block becomes one event (name, start, duration, thread) in a ring buffer that always
+// holds the most recent PROFILER_CAPACITY events; older ones are simply overwritten. Recording is a
+// couple of clock reads and one atomic add, so the game can keep it on all the time.
+// ExportProfileTrace() saves the buffer as a Chrome trace: open it in chrome://tracing or ui.perfetto.dev.
+//
+// It only exists when the game is built with GABRIEL_PROFILER defined ('make BUILD_MODE=DEBUG' or
+// 'make PROFILER=TRUE'). Otherwise every macro below expands to nothing and profiler.c is empty,
+// so release builds carry no trace of it.
+//
+// There is only one profiler, so its state lives inside profiler.c (like the text cache).
+//
+// Usage:
+//     PROFILE_SCOPE("UpdateRace") {
+//         UpdateRace(race, player, dt);
+//     }
+// Never 'return', 'break' or 'goto' out of a PROFILE_SCOPE block (the event would never be closed).
+// When the measured code declares variables that are used after it, use the BEGIN/END pair instead:
+//     PROFILE_BEGIN(inputScope, "Input");
+//     PilotInput input = ReadPilotInput();
+//     PROFILE_END(inputScope);
+
+
+// --- CONSTANTS ---
+// Events kept (a power of two). About 15 events per frame: at 60 FPS that is over a minute of history.
+#define PROFILER_CAPACITY 65536
+
+
+#if defined(GABRIEL_PROFILER)
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// A block being measured. It lives on the stack of whoever measures it.
+typedef struct ProfileScope {
+    const char *name;           // Must be a string literal (only the pointer is stored).
+    uint64_t start;             // Nanoseconds.
+    bool isOpen;                // Drives the PROFILE_SCOPE loop: true until the block has run once.
+} ProfileScope;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Starts measuring a block.
+ProfileScope BeginProfileScope(const char *name);
+
+// Stops measuring it and records the event. Safe to call from any thread.
+void EndProfileScope(ProfileScope *scope);
+
+// Saves the events in the buffer as Chrome trace JSON. Returns how many were written (-1 on error).
+// Call it from one thread at a time; the others may keep recording meanwhile.
+int ExportProfileTrace(const char *fileName);
+
+
+// --- MACROS ---
+// Two steps so __LINE__ is expanded before it is glued to the name (nested scopes get unique names).
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// A 'for' loop that runs its block exactly once, opening the event before it and closing it after.
+#define PROFILE_SCOPE(name) \
+    for (ProfileScope PROFILE_CONCAT(profileScope_, __LINE__) = BeginProfileScope(name); \
+         PROFILE_CONCAT(profileScope_, __LINE__).isOpen; \
+         EndProfileScope(&PROFILE_CONCAT(profileScope_, __LINE__)))
+
+#define PROFILE_BEGIN(scope, name) ProfileScope scope = BeginProfileScope(name)
+#define PROFILE_END(scope) EndProfileScope(&scope)
+
+#else
+
+// Profiler compiled out: the blocks are plain blocks and nothing else is left.
+#define PROFILE_SCOPE(name)
+#define PROFILE_BEGIN(scope, name)
+#define PROFILE_END(scope)
+
+#endif
+
+#endif // Ends the include guard
@@ -14,6 +14,19 @@
 #include "mission_rings.h"
 #include "mission_landing.h"
 
+// The ring list of every level lives in its own memory arena (sized from the level file).
+#include "arena.h"
+
+
+// --- ENUMERATIONS ---
+// Why a mission ended in failure. Used by the HUD and by the headless tools to report the cause.
+typedef enum MissionFailReason {
+    FAIL_NONE = 0,          // The mission hasn't failed.
+    FAIL_MISSED_PAD,        // Touched down outside the landing pad.
+    FAIL_HARD_LANDING,      // Vertical sink rate above the limit on touchdown.
+    FAIL_SLIDING            // Horizontal slip (relative to the pad) above the limit on touchdown.
+} MissionFailReason;
+
 
 // --- DATA STRUCTURES ---
 // A 'struct' groups related variables into a single package.
@@ -32,9 +45,22 @@ typedef struct RaceSystem {
     bool isFinished;       // True if the player successfully completed the objective.
 
     // --- MISSION TYPE 0: RINGS DATA ---
-    Ring rings[MAX_RINGS]; // The array (list) containing all the rings in the circuit.
+    // There is no fixed limit: InitRace() reads how many rings the level has and reserves
+    // exactly that much RAM in 'ringArena'. Both arrays below point inside that block.
+    MemoryArena ringArena; // One block of RAM holding every ring array of the level (freed by UnloadRace).
+    Ring *rings;           // The list containing all the rings in the circuit ('totalRings' of them).
     int totalRings;        // Number of total rings.
-    int targetRing;        // The index (0 to MAX_RINGS - 1) of the NEXT ring the player must cross.
+    int declaredRings;     // Ring count written in the level file ('totalRings' is lower if the file was cut short).
+    int targetRing;        // The index (0 to totalRings - 1) of the NEXT ring the player must cross.
+    Matrix *ringTransforms; // World matrix of every ring, built ONCE when the level loads (rings never move).
+    RingFrames ringFrames; // Collision data of every ring, also built once (see mission_rings.h).
+    RingGrid ringGrid;     // Which rings are near which part of the world (see mission_rings.h).
+
+    // --- COMPILED LEVEL FILE ---
+    // When the level comes from a compiled 'lvlN.bin', the ring arrays above point straight into
+    // the file mapped in memory (and 'ringArena' stays empty). Released by UnloadRace().
+    void *levelMapping;
+    size_t levelMappingSize;
 
     // --- MISSION TYPE 1: LANDING DATA ---
     Vector3 landingZone;   // Coordinates for the center of the landing pad.
@@ -51,6 +77,7 @@ typedef struct RaceSystem {
     
     float prevSpeed;       // Stores the vehicle's speed from the previous frame to detect crashes.
     bool missionFailed;    // True if the player crashed or slammed into the ground.
+    MissionFailReason failReason; // The exact cause of the failure (FAIL_NONE while flying).
 } RaceSystem;
 
 
@@ -61,31 +88,45 @@ typedef struct RaceSystem {
 // Initializes and returns a brand new Mission package based on the level ID.
 // It sets up the starting positions, reads the mission type from the file, and resets the timer.
 // Notice it returns a full 'RaceSystem' struct (passed by value), just like InitPlayer.
+// It maps the compiled 'levels/lvlN.bin' when it is up to date, and parses 'levels/lvlN.txt' otherwise.
+// The ring list is allocated on the heap, so every race MUST be released with UnloadRace().
 RaceSystem InitRace(int levelID);
 
-// Updates the global mission logic and delegates work to the specific modules (rings or landing).
-// VERY IMPORTANT: We pass POINTERS to both the race and the player.
-// We need the race pointer to update the timer and delegate the status.
-// We need the player pointer to physically check their exact 3D coordinates.
-void UpdateRace(RaceSystem *race, Player *player);
+// Parses a text level file (the format we write by hand). InitRace() uses it when there is no
+// up-to-date compiled level; the level compiler uses it to read the files it compiles.
+RaceSystem LoadRaceText(const char *filename);
 
-// Draws the 3D models for the current mission (rings, helipads, etc.).
-// We pass a POINTER to avoid copying the whole struct into memory 60 times per second.
-void DrawRace3D(RaceSystem *race, Player *player);
+// Bytes needed by every ring array of a circuit with 'ringCount' rings.
+size_t GetRaceRingsSize(int ringCount);
 
-// Draws the specific UI for the current mission (timer, remaining rings, or landing warnings).
-void DrawRaceUI(RaceSystem *race);
+// Points every ring array of 'race' into 'arena' (at least GetRaceRingsSize() bytes), always in the same order.
+// Returns false if the arena is too small.
+bool CarveRaceRings(RaceSystem *race, MemoryArena *arena, int ringCount);
 
-// Reads only the first line of the level file to get its name for the menu UI.
-// We pass a buffer (outName) where the function will write the text.
-void GetLevelName(int levelID, char *outName);
+// Reserves the ring arrays of a circuit with 'ringCount' rings (in 'race->ringArena').
+// InitRace() uses it while parsing the level file; tools use it to build synthetic circuits.
+// Returns false if there wasn't enough memory. 'totalRings' is left at 0 for the caller to fill.
+bool AllocateRaceRings(RaceSystem *race, int ringCount);
 
+// Frees the RAM of a race built by InitRace(). Call it before overwriting 'race' with a new one.
+void UnloadRace(RaceSystem *race);
 
-// --- SHARED VISUAL UTILITIES ---
-// Draws text with a solid border. Shared across all mission modules and main UI.
-void DrawTextOutlined(const char *text, int posX, int posY, int fontSize, Color color, int outlineSize);
+// Resets 'race' to the starting state of 'raceTemplate' (a race freshly built by InitRace() and never flown).
+// It only copies memory: no file is opened and nothing is parsed, so a restart takes a fraction of a millisecond.
+// 'race' gets its own copy of every array (the template is never modified), and is released with UnloadRace() as usual.
+void RestoreRace(RaceSystem *race, const RaceSystem *raceTemplate);
+
+// Replaces the level data of a race in progress with 'raceTemplate' (the same level, just edited),
+// keeping the stopwatch, the mission result and the rings already crossed. Used by the level hot-reload.
+void HotSwapRace(RaceSystem *race, const RaceSystem *raceTemplate);
+
+// Updates the global mission logic and delegates work to the specific modules (rings or landing).
+// VERY IMPORTANT: We pass POINTERS to both the race and the player.
+// We need the race pointer to update the timer and delegate the status.
+// We need the player pointer to physically check their exact 3D coordinates.
+// 'dt' is the fixed simulation tick (SIM_DT), so the stopwatch advances the same on every machine.
+void UpdateRace(RaceSystem *race, Player *player, float dt);
 
-// Draws the 3D holographic navigation arrow pointing to a specific target.
-void DrawNavArrow(Player *player, Vector3 targetPos);
+// Drawing a mission (DrawRace3D, DrawRaceUI) lives in race_draw.h, outside the headless core.
 
 #endif // Ends the include guard
\ No newline at end of file
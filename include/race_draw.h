@@ -0,0 +1,32 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef RACE_DRAW_H
+#define RACE_DRAW_H
+
+// We need race.h for 'RaceSystem' and 'Player'.
+// text_cache.h brings DrawTextOutlined(), the outlined text every HUD uses (cached on the GPU).
+#include "race.h"
+#include "text_cache.h"
+
+
+// --- MISSION RENDERING ---
+// Everything that draws a mission lives here, apart from its logic (race.c and the mission files).
+// The headless simulation library (libgabriel_sim.a) doesn't include this file, so the batch tools
+// link without the 3D models, the shaders or the render textures.
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Draws the 3D models for the current mission (rings, helipads, etc.) and the navigation arrow.
+// This must be called inside BeginMode3D() in main.c.
+// We pass a POINTER to avoid copying the whole struct into memory 60 times per second.
+void DrawRace3D(RaceSystem *race, Player *player);
+
+// Draws the specific UI for the current mission (timer, remaining rings, or landing warnings).
+// This must be called outside BeginMode3D(), right next to the telemetry.
+void DrawRaceUI(RaceSystem *race);
+
+#endif // Ends the include guard
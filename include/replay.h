@@ -0,0 +1,93 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// We need player.h so the compiler knows what 'PilotInput' and 'VehicleType' are,
+// and stdint.h for the run id that names the file.
+#include <stdint.h>
+#include "player.h"
+
+
+// --- CONSTANTS ---
+// The first 4 bytes of every replay file spell "GRP1", so we never read a random file as a replay.
+#define REPLAY_MAGIC 0x31505247
+#define REPLAY_VERSION 1
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// Captures the pilot's controls tick by tick while flying.
+// The controls barely change between two ticks (a key is held for hundreds of them),
+// so instead of storing every tick we store "runs": what changed, and for how many ticks it stayed that way.
+// Every run costs 2 to 6 bytes, so a 10 minute flight takes a few KB instead of megabytes.
+typedef struct ReplayRecorder {
+    unsigned char *data;      // The encoded runs written so far.
+    int size;                 // Bytes used in 'data'.
+    int capacity;             // Bytes allocated for 'data' (it grows when full).
+
+    int levelID;              // The level this flight belongs to.
+    VehicleType startVehicle; // The vehicle chosen at the start.
+    int tickCount;            // Total number of recorded ticks.
+
+    signed char runValues[4]; // Quantized controls of the current run (throttle, yaw, pitch, vehicle).
+    signed char lastWritten[4]; // Values of the last run written to 'data' (to store only the changes).
+    int runLength;            // How many ticks the current run has lasted so far.
+} ReplayRecorder;
+
+// A replay loaded from the hard drive, read back one tick at a time.
+// Copying this struct gives an independent playback cursor over the same (read-only) data.
+typedef struct Replay {
+    unsigned char *data;      // The encoded runs.
+    int size;                 // Bytes in 'data'.
+
+    int levelID;              // The level to load before playing it.
+    VehicleType startVehicle; // The vehicle to spawn.
+    int tickCount;            // Total number of ticks in the recording.
+    float finalTime;          // The race time of the original run (to verify the playback).
+
+    int cursor;               // Byte position of the next run to decode.
+    signed char values[4];    // Controls of the run being played.
+    int ticksLeft;            // Ticks left in the run being played.
+
+    bool isReady;             // False if the file doesn't exist or is broken.
+} Replay;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Rounds every axis of the input to the precision stored in replays (1/127 steps).
+// The game feeds the ROUNDED input to the simulation, so the playback sees exactly the same numbers.
+PilotInput QuantizePilotInput(PilotInput input);
+
+// Starts a fresh recording for the given level and vehicle (reuses the memory of the previous one).
+void BeginReplayRecording(ReplayRecorder *recorder, int levelID, VehicleType vehicle);
+
+// Adds ONE simulation tick to the recording. Call it with the same input given to SimStep().
+void RecordReplayTick(ReplayRecorder *recorder, const PilotInput *input, VehicleType vehicle);
+
+// Writes the recording to the hard drive. Returns false if the file couldn't be created.
+bool SaveReplay(ReplayRecorder *recorder, const char *fileName, float finalTime);
+
+// Frees the RAM used by the recording.
+void UnloadReplayRecorder(ReplayRecorder *recorder);
+
+// Loads a replay file. Check 'isReady' before using it.
+Replay LoadReplay(const char *fileName);
+
+// Decodes the next tick. Returns false when the recording is over.
+bool ReadReplayTick(Replay *replay, PilotInput *outInput, VehicleType *outVehicle);
+
+// Frees the RAM used by a loaded replay.
+void UnloadReplay(Replay *replay);
+
+// Builds the file name of the replay that belongs to a leaderboard run, from the run's unique
+// sequence number (two runs can finish on the very same tick, so the time can't name it),
+// e.g. level 3, run 57 -> "data/times_lvl3_run57.replay" (right beside "data/times_lvl3.board").
+void GetReplayFileName(int levelID, uint32_t runID, char *outName, int outSize);
+
+#endif // Ends the include guard
@@ -20,11 +20,18 @@ extern Texture2D mapTexture;    // Stores the 2D image for the ground.
 extern Model mapModel;          // Stores the 3D plane for the ground.
 extern Model environmentModel;  // Stores the 3D data for the scenario.
 extern Model skyboxModel;       // Stores the 3D data for the infinite sky.
+extern Model groundModel;       // One huge flat quad for the endless green floor (follows the player).
+extern Shader groundShader;     // Paints the floor and its grid lines (anti-aliased, fading with distance).
 
 extern Model planeModel;        // Stores the 3D data for the SR-71 Blackbird.
 extern Model helicopterModel;   // Stores the 3D data for the AH-64 Apache.
 
 extern Model ringModel;         // Stores the 3D mathematical torus for the race.
+extern Shader ringShader;       // Draws all the rings at once (one GPU draw call per circuit).
+extern int ringShaderBaseLoc;   // Where 'matBase' (the ring model's own orientation) lives in 'ringShader'.
+
+extern Model particleModel;     // A 1x1 quad drawn once per smoke puff (always facing the camera).
+extern Shader particleShader;   // Turns the quad into a soft, fading puff (one draw call for all of them).
 
 
 extern Sound planeSound;        // Stores the jet engine sound effect.
@@ -38,7 +45,8 @@ extern Music endingMusic;       // Stores the ending music stream for the leader
 // These declarations tell the compiler the names of our functions and what parameters they take,
 // so it doesn't panic when we call them in main.c before defining what they actually do.
 
-// Loads all textures and models from the hard drive into RAM. Must be called once before the game loop.
+// Builds the shaders and quads, and starts loading the files in the background (see asset_manager.h).
+// Must be called once before the game loop.
 void LoadGameResources(void);
 
 // Frees the RAM used by the textures and models. Must be called once right before closing the program.
@@ -0,0 +1,236 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef SHADERS_H
+#define SHADERS_H
+
+// --- EMBEDDED GPU PROGRAMS ---
+// Small GLSL shaders, stored as plain C strings so they can't go missing from the resources folder.
+// They are compiled once in LoadGameResources() with LoadShaderFromMemory().
+// Desktop uses OpenGL 3.3 (GLSL 330); the web build uses WebGL 1 (GLSL 100).
+
+
+// --- RING INSTANCING SHADER ---
+// Draws EVERY ring of the circuit in a single draw call.
+// Each ring sends its own world matrix ('instanceTransform'). The bottom row of that matrix
+// is always (0, 0, 0, 1) for a normal 3D transform, so we use it to smuggle the ring's colour
+// (R, G, B, A) to the GPU, and put (0, 0, 0, 1) back before using the matrix.
+// 'matBase' is the model's own orientation (ringModel.transform), shared by all the rings.
+#if defined(__EMSCRIPTEN__)
+
+static const char *RING_INSTANCED_VS =
+    "#version 100\n"
+    "attribute vec3 vertexPosition;\n"
+    "attribute vec2 vertexTexCoord;\n"
+    "attribute vec4 vertexColor;\n"
+    "attribute mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat4 matBase;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "void main() {\n"
+    "    mat4 world = instanceTransform;\n"
+    "    vec4 tint = vec4(world[0][3], world[1][3], world[2][3], world[3][3]);\n"
+    "    world[0][3] = 0.0; world[1][3] = 0.0; world[2][3] = 0.0; world[3][3] = 1.0;\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragColor = vertexColor*tint;\n"
+    "    gl_Position = mvp*world*matBase*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char *RING_INSTANCED_FS =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main() {\n"
+    "    gl_FragColor = texture2D(texture0, fragTexCoord)*colDiffuse*fragColor;\n"
+    "}\n";
+
+#else
+
+static const char *RING_INSTANCED_VS =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec4 vertexColor;\n"
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat4 matBase;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    mat4 world = instanceTransform;\n"
+    "    vec4 tint = vec4(world[0][3], world[1][3], world[2][3], world[3][3]);\n"
+    "    world[0][3] = 0.0; world[1][3] = 0.0; world[2][3] = 0.0; world[3][3] = 1.0;\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragColor = vertexColor*tint;\n"
+    "    gl_Position = mvp*world*matBase*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char *RING_INSTANCED_FS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    finalColor = texture(texture0, fragTexCoord)*colDiffuse*fragColor;\n"
+    "}\n";
+
+#endif
+
+
+// --- GROUND GRID SHADER ---
+// Paints the endless green floor and its grid lines on ONE big flat quad, pixel by pixel.
+// Each pixel works out how close it is to the nearest grid line (in world units), and 'fwidth'
+// tells it how many world units one screen pixel covers there, so the lines are always about
+// one pixel wide and smoothly blended (anti-aliased) instead of flickering in the distance.
+// The lines fade out between 'gridFadeStart' and 'gridFadeEnd' units away from the camera.
+#if defined(__EMSCRIPTEN__)
+
+static const char *GROUND_GRID_VS =
+    "#version 100\n"
+    "attribute vec3 vertexPosition;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat4 matModel;\n"
+    "varying vec3 fragWorldPos;\n"
+    "void main() {\n"
+    "    fragWorldPos = (matModel*vec4(vertexPosition, 1.0)).xyz;\n"
+    "    gl_Position = mvp*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char *GROUND_GRID_FS =
+    "#version 100\n"
+    "#extension GL_OES_standard_derivatives : enable\n"
+    "precision highp float;\n"
+    "varying vec3 fragWorldPos;\n"
+    "uniform vec3 viewPos;\n"
+    "uniform float gridSpacing;\n"
+    "uniform float gridFadeStart;\n"
+    "uniform float gridFadeEnd;\n"
+    "uniform vec4 groundColor;\n"
+    "uniform vec4 lineColor;\n"
+    "void main() {\n"
+    "    vec2 coord = fragWorldPos.xz/gridSpacing;\n"
+    "    vec2 lineDistance = abs(fract(coord - 0.5) - 0.5)/fwidth(coord);\n"
+    "    float line = 1.0 - min(min(lineDistance.x, lineDistance.y), 1.0);\n"
+    "    float fade = 1.0 - smoothstep(gridFadeStart, gridFadeEnd, length(fragWorldPos.xz - viewPos.xz));\n"
+    "    gl_FragColor = mix(groundColor, lineColor, line*fade);\n"
+    "}\n";
+
+#else
+
+static const char *GROUND_GRID_VS =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat4 matModel;\n"
+    "out vec3 fragWorldPos;\n"
+    "void main() {\n"
+    "    fragWorldPos = (matModel*vec4(vertexPosition, 1.0)).xyz;\n"
+    "    gl_Position = mvp*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char *GROUND_GRID_FS =
+    "#version 330\n"
+    "in vec3 fragWorldPos;\n"
+    "uniform vec3 viewPos;\n"
+    "uniform float gridSpacing;\n"
+    "uniform float gridFadeStart;\n"
+    "uniform float gridFadeEnd;\n"
+    "uniform vec4 groundColor;\n"
+    "uniform vec4 lineColor;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec2 coord = fragWorldPos.xz/gridSpacing;\n"
+    "    vec2 lineDistance = abs(fract(coord - 0.5) - 0.5)/fwidth(coord);\n"
+    "    float line = 1.0 - min(min(lineDistance.x, lineDistance.y), 1.0);\n"
+    "    float fade = 1.0 - smoothstep(gridFadeStart, gridFadeEnd, length(fragWorldPos.xz - viewPos.xz));\n"
+    "    finalColor = mix(groundColor, lineColor, line*fade);\n"
+    "}\n";
+
+#endif
+
+
+// --- PARTICLE BILLBOARD SHADER ---
+// Draws EVERY smoke puff in a single draw call, as a flat square that always faces the camera.
+// Each puff sends one matrix: its position in the translation slots and its remaining life in [0][0].
+// The camera's right and up directions come straight out of the view matrix ('matView'),
+// so the square is built around the puff's centre without any rotation math on the CPU.
+// Same look as the old spheres: grows from 0.1 to 0.8 units of radius and fades from 60% to 0%.
+#if defined(__EMSCRIPTEN__)
+
+static const char *PARTICLE_BILLBOARD_VS =
+    "#version 100\n"
+    "attribute vec3 vertexPosition;\n"
+    "attribute vec2 vertexTexCoord;\n"
+    "attribute mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat4 matView;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying float fragAlpha;\n"
+    "void main() {\n"
+    "    float life = clamp(instanceTransform[0][0], 0.0, 1.0);\n"
+    "    float radius = 0.1 + (1.0 - life)*0.7;\n"
+    "    vec3 right = vec3(matView[0][0], matView[1][0], matView[2][0]);\n"
+    "    vec3 up = vec3(matView[0][1], matView[1][1], matView[2][1]);\n"
+    "    vec3 world = instanceTransform[3].xyz + (right*vertexPosition.x + up*vertexPosition.z)*(2.0*radius);\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragAlpha = life*0.6;\n"
+    "    gl_Position = mvp*vec4(world, 1.0);\n"
+    "}\n";
+
+static const char *PARTICLE_BILLBOARD_FS =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying float fragAlpha;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main() {\n"
+    "    float softEdge = 1.0 - smoothstep(0.3, 0.5, length(fragTexCoord - vec2(0.5)));\n"
+    "    float alpha = fragAlpha*softEdge;\n"
+    "    if (alpha <= 0.0) discard;\n"
+    "    gl_FragColor = vec4(colDiffuse.rgb, colDiffuse.a*alpha);\n"
+    "}\n";
+
+#else
+
+static const char *PARTICLE_BILLBOARD_VS =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat4 matView;\n"
+    "out vec2 fragTexCoord;\n"
+    "out float fragAlpha;\n"
+    "void main() {\n"
+    "    float life = clamp(instanceTransform[0][0], 0.0, 1.0);\n"
+    "    float radius = 0.1 + (1.0 - life)*0.7;\n"
+    "    vec3 right = vec3(matView[0][0], matView[1][0], matView[2][0]);\n"
+    "    vec3 up = vec3(matView[0][1], matView[1][1], matView[2][1]);\n"
+    "    vec3 world = instanceTransform[3].xyz + (right*vertexPosition.x + up*vertexPosition.z)*(2.0*radius);\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragAlpha = life*0.6;\n"
+    "    gl_Position = mvp*vec4(world, 1.0);\n"
+    "}\n";
+
+static const char *PARTICLE_BILLBOARD_FS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in float fragAlpha;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    float softEdge = 1.0 - smoothstep(0.3, 0.5, length(fragTexCoord - vec2(0.5)));\n"
+    "    float alpha = fragAlpha*softEdge;\n"
+    "    if (alpha <= 0.0) discard;\n"
+    "    finalColor = vec4(colDiffuse.rgb, colDiffuse.a*alpha);\n"
+    "}\n";
+
+#endif
+
+#endif // Ends the include guard
@@ -0,0 +1,23 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef SIM_H
+#define SIM_H
+
+// The simulation core only needs the player physics and the mission referee.
+#include "player.h"
+#include "race.h"
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Advances the whole game world by exactly ONE fixed tick of 'dt' seconds (normally SIM_DT).
+// This is the HEADLESS core of the game: it never reads the keyboard, the gamepad, the clock
+// or the window. Everything it needs comes through its parameters, so calling it twice with the
+// same state and the same input always gives the same result.
+// That lets tools and tests run millions of ticks per second without opening a window.
+void SimStep(Player *player, RaceSystem *race, const PilotInput *input, float dt);
+
+#endif // Ends the include guard
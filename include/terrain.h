@@ -0,0 +1,108 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+// Include the main Raylib library so the compiler knows what 'Ray', 'Model' and 'RayCollision' are.
+#include "raylib.h"
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// A single box of the Bounding Volume Hierarchy (BVH).
+// Every box wraps a group of triangles. If a ray misses the box, it is impossible
+// for the ray to hit any triangle inside it, so we can skip all of them at once.
+typedef struct TerrainBVHNode {
+    Vector3 boundsMin;  // Lowest corner of the box (X, Y, Z).
+    Vector3 boundsMax;  // Highest corner of the box (X, Y, Z).
+    int leftOrFirst;    // Internal node: index of the left child (the right child is the next one).
+                        // Leaf node: index of the first triangle stored in this box.
+    int triangleCount;  // 0 for internal nodes, number of triangles for leaf nodes.
+} TerrainBVHNode;
+
+// The collision copy of the scenario, built once from the 3D model.
+// The triangles are stored already transformed into world space and sorted in BVH order,
+// so a ray only has to visit a handful of boxes instead of every triangle of the terrain.
+typedef struct TerrainCollision {
+    Vector3 *vertices;       // 3 consecutive vertices per triangle, in world space.
+    int triangleCount;       // Total number of triangles in the terrain.
+
+    TerrainBVHNode *nodes;   // The tree of boxes (node 0 is the root that wraps everything).
+    int nodeCount;           // Number of boxes used by the tree.
+
+    bool isReady;            // False if there is no terrain loaded (the ground is then flat at Y = 0).
+} TerrainCollision;
+
+
+// A 2D grid of ground heights, "rasterized" from the terrain once at load time.
+// Looking up the ground under the aircraft then costs 4 memory reads and a bilinear blend,
+// no matter how many triangles the terrain has.
+typedef struct TerrainHeightfield {
+    float *heights;     // width * depth samples, stored row by row (Z rows of X samples).
+    int width;          // Number of samples along the X axis.
+    int depth;          // Number of samples along the Z axis.
+    float originX;      // World X coordinate of the first sample.
+    float originZ;      // World Z coordinate of the first sample.
+    float cellSize;     // World distance between two neighbouring samples.
+
+    bool isReady;       // False if there is no terrain (the ground is then flat at Y = 0).
+} TerrainHeightfield;
+
+
+// --- GLOBAL COLLISION DATA ---
+// Created in terrain.c and built by LoadGameResources() right after the terrain model.
+extern TerrainCollision terrainCollision;
+extern TerrainHeightfield terrainHeightfield;
+
+// Optional exact fallback: when true, GetTerrainHeight() ignores the grid and
+// casts the old satellite ray against the mesh instead (slower, but exact).
+extern bool terrainExactGround;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in player.c before defining what they actually do.
+
+// Copies every triangle of the model into world space and builds the BVH around them.
+// Must be called once after the terrain model has been loaded.
+void BuildTerrainCollision(Model model);
+
+// Frees the RAM used by the triangles and the boxes of the BVH.
+void UnloadTerrainCollision(void);
+
+// Casts a ray against the terrain and returns the CLOSEST hit.
+// Hits further away than 'maxDistance' are ignored, which lets short rays (like the
+// forward crash ray) discard almost the whole tree after the first few boxes.
+RayCollision GetRayCollisionTerrain(Ray ray, float maxDistance);
+
+// Loads the height grid from 'cacheFile' if it is still up to date with 'sourceFile' (terrain.glb).
+// Otherwise, it rasterizes the grid from the terrain BVH and saves it to 'cacheFile' for the next launch.
+// Must be called after BuildTerrainCollision().
+void BakeTerrainHeightfield(const char *cacheFile, const char *sourceFile);
+
+// Reads a previously baked grid from the hard drive. Returns false if it doesn't exist or is invalid.
+// This works without loading the terrain model at all.
+bool LoadTerrainHeightfield(const char *cacheFile);
+
+// Frees the RAM used by the height grid.
+void UnloadTerrainHeightfield(void);
+
+// Returns the ground height at the (X, Z) world position.
+// It uses the baked grid (bilinear lookup) unless 'terrainExactGround' is enabled.
+// Positions without terrain below them return 0.0f (the mathematical floor).
+float GetTerrainHeight(float x, float z);
+
+// Returns the exact ground height using a ray cast straight down from Y = 1000 against the BVH.
+float GetTerrainHeightExact(float x, float z);
+
+// Validation mode: compares the grid against the exact raycast at 'sampleCount' random
+// positions and prints the maximum and average error.
+void ValidateTerrainHeightfield(int sampleCount);
+
+// Microbenchmark: fires 'rayCount' random rays against the terrain with both the BVH
+// and the brute-force GetRayCollisionMesh() path, then prints the ns/ray of each one.
+void BenchmarkTerrainRaycasts(Model model, int rayCount);
+
+#endif // Ends the include guard
@@ -0,0 +1,53 @@
+// --- INCLUDE GUARD ---
+// Prevents this header file from being included multiple times in the same compilation process.
+// If it gets included twice, the compiler would complain about "redefinition" errors.
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+// Include the main Raylib library so the compiler knows what 'Color' and 'RenderTexture2D' are.
+#include "raylib.h"
+
+
+// --- CONSTANTS ---
+// How many different outlined strings are kept ready on the GPU at once.
+// The HUD shows about ten per frame; the rest of the slots soak up the values that keep changing
+// (timer, altitude) so they never push the static lines out.
+#define TEXT_CACHE_SIZE 64
+
+// Longest string (in bytes, without the final '\0') that can be cached.
+// Anything longer is still drawn, just the old way (nine passes every frame).
+#define TEXT_CACHE_MAX_LENGTH 127
+
+
+// --- DATA STRUCTURES ---
+// A 'struct' groups related variables into a single package.
+
+// One outlined string, already rendered (border and all) into its own small texture.
+// Drawing it again is a single textured quad instead of nine full DrawText() calls.
+typedef struct TextCacheEntry {
+    unsigned int hash;                        // Quick fingerprint of the key below (0 = empty slot).
+    char text[TEXT_CACHE_MAX_LENGTH + 1];     // The exact string (the hash alone could collide).
+    int fontSize;
+    Color color;
+    int outlineSize;
+
+    RenderTexture2D target;                   // The GPU image. May be bigger than the text (see 'width').
+    int width;                                // Size of the text inside 'target', border included.
+    int height;
+    unsigned int lastUsed;                    // When it was last drawn (for choosing which slot to reuse).
+} TextCacheEntry;
+
+
+// --- FUNCTION PROTOTYPES ---
+// These declarations tell the compiler the names of our functions and what parameters they take,
+// so it doesn't panic when we call them in main.c before defining what they actually do.
+
+// Draws text with a solid border. Shared across all mission modules and main UI.
+// The first time a (text, size, colour, border) combination is seen it is rendered once into a
+// texture; every frame after that it is a single quad. Must be called in 2D (outside BeginMode3D()).
+void DrawTextOutlined(const char *text, int posX, int posY, int fontSize, Color color, int outlineSize);
+
+// Frees every cached texture from the GPU. Call it before CloseWindow().
+void UnloadTextCache(void);
+
+#endif // Ends the include guard
@@ -12,6 +12,8 @@
 #include "player.h"
 #include "race.h"
 #include "leaderboard.h"
+#include "leaderboard_cache.h"
+#include "level_catalog.h"
 
 
 // --- FUNCTION PROTOTYPES ---
@@ -26,9 +28,10 @@
 void DrawMainMenu(int screenWidth, int screenHeight);
 
 // Draws the 5x5 dynamic mission grid.
-// It needs to know the 'currentLevel' to highlight it in GOLD, and 'maxLevels' 
-// to know which boxes should be drawn in blue (available) or gray (restricted).
-void DrawLevelSelectScreen(int currentLevel, int maxLevels, int screenWidth, int screenHeight);
+// It needs to know the 'currentLevel' to highlight it in GOLD, and the level 'catalog' (built once
+// at startup) for the mission names and to know which boxes are blue (available) or gray (restricted).
+// It reads only from the catalog: no file is opened while the menu is on screen.
+void DrawLevelSelectScreen(const LevelCatalog *catalog, int currentLevel, int screenWidth, int screenHeight);
 
 // Draws the screen where the player chooses between the SR-71 Blackbird and the AH-64 Apache.
 void DrawVehicleSelectScreen(int screenWidth, int screenHeight);
@@ -37,15 +40,21 @@ void DrawVehicleSelectScreen(int screenWidth, int screenHeight);
 // This includes the altitude, throttle percentage, controls helper, and delegates 
 // the mission-specific UI (like rings left or landing warnings) to the race system.
 // We pass POINTERS (*player and *race) to read their data without copying massive structs into RAM every frame.
-void DrawHUD(Player *player, RaceSystem *race, bool showControls, int screenWidth, int screenHeight);
+// 'target' is the leaderboard run to beat (see leaderboard_cache.h).
+void DrawHUD(Player *player, RaceSystem *race, const LeaderboardTarget *target, bool showControls, int screenWidth, int screenHeight);
 
 // Draws the arcade-style naming screen after a victory.
 // It needs the 'playerName' array to show what the user has typed so far, 
 // and the 'currentVirtualKey' to show which letter the gamepad joystick is currently hovering over.
 void DrawNameInputScreen(const char *playerName, char currentVirtualKey, int screenWidth, int screenHeight);
 
-// Draws the classic Top 10 High-Score terminal.
+// Draws the classic Top 10 High-Score terminal (or any later page of 10 ranks).
 // We pass a POINTER to the leaderboard to read the names, times, and vehicles efficiently.
-void DrawLeaderboardScreen(Leaderboard *lb, int screenWidth, int screenHeight);
+// 'playerRank' is the rank of the run just submitted (0 = none): its row is highlighted.
+void DrawLeaderboardScreen(Leaderboard *lb, int playerRank, int screenWidth, int screenHeight);
+
+// Draws the progress bar shown while the files a screen needs are still loading.
+// 'progress' goes from 0.0f (nothing loaded) to 1.0f (everything ready).
+void DrawLoadingScreen(float progress, int screenWidth, int screenHeight);
 
 #endif // Ends the include guard
\ No newline at end of file
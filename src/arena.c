@@ -0,0 +1,55 @@
+// Include standard library for memory allocation.
+#include <stdlib.h>
+
+// We include our own header file.
+#include "arena.h"
+
+
+// Every allocation starts on a multiple of 16 bytes, enough for any C type (and for SIMD loads).
+#define ARENA_ALIGNMENT 16
+
+
+size_t ArenaAllocSize(size_t size) {
+    // Round up to the next multiple of ARENA_ALIGNMENT.
+    return (size + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+MemoryArena CreateArena(size_t capacity) {
+    MemoryArena arena = { 0 };
+
+    if (capacity == 0) {
+        return arena;
+    }
+
+    // malloc() already returns memory aligned for any type, and we only ever hand out
+    // multiples of ARENA_ALIGNMENT from here, so every piece stays aligned.
+    arena.base = (unsigned char *)malloc(capacity);
+    if (arena.base != NULL) {
+        arena.capacity = capacity;
+    }
+
+    return arena;
+}
+
+void *ArenaAlloc(MemoryArena *arena, size_t size) {
+    size_t bytes = ArenaAllocSize(size);
+
+    if (arena->base == NULL || bytes > arena->capacity - arena->used) {
+        return NULL;
+    }
+
+    void *memory = arena->base + arena->used;
+    arena->used += bytes;
+    return memory;
+}
+
+void ResetArena(MemoryArena *arena) {
+    arena->used = 0;
+}
+
+void DestroyArena(MemoryArena *arena) {
+    free(arena->base);
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+}
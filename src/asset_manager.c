@@ -0,0 +1,675 @@
+// Include standard libraries for file input/output, memory and strings.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// We include our own header file.
+// We also need terrain.h to build the collision data once the terrain has arrived,
+// and mesh_cache.h to skip the glTF parsing of models loaded before.
+#include "asset_manager.h"
+#include "terrain.h"
+#include "mesh_cache.h"
+
+// The web build has no threads: there, the "workers" run one job per frame on the main thread.
+#if !defined(__EMSCRIPTEN__)
+    #define ASSET_THREADS 1
+    #include <pthread.h>
+#else
+    #define ASSET_THREADS 0
+#endif
+
+
+// --- ASSET LIST ---
+// What every asset is made from, in the order of the AssetID enum.
+typedef enum AssetKind {
+    ASSET_KIND_MODEL,
+    ASSET_KIND_SOUND,
+    ASSET_KIND_MUSIC
+} AssetKind;
+
+typedef struct AssetFile {
+    const char *fileName;
+    AssetKind kind;
+} AssetFile;
+
+static const AssetFile assetFiles[ASSET_COUNT] = {
+    [ASSET_TERRAIN]          = { "resources/models/terrain.glb",   ASSET_KIND_MODEL },
+    [ASSET_SKYBOX]           = { "resources/models/skybox.glb",    ASSET_KIND_MODEL },
+    [ASSET_RING]             = { "resources/models/ring.glb",      ASSET_KIND_MODEL },
+    [ASSET_PLANE_MODEL]      = { "resources/models/blackbird.glb", ASSET_KIND_MODEL },
+    [ASSET_HELICOPTER_MODEL] = { "resources/models/apache.glb",    ASSET_KIND_MODEL },
+    [ASSET_PLANE_SOUND]      = { "resources/sounds/plane.wav",     ASSET_KIND_SOUND },
+    [ASSET_HELICOPTER_SOUND] = { "resources/sounds/helicopter.wav", ASSET_KIND_SOUND },
+    [ASSET_MENU_MUSIC]       = { "resources/sounds/menu.mp3",      ASSET_KIND_MUSIC },
+    [ASSET_ENDING_MUSIC]     = { "resources/sounds/ending.mp3",    ASSET_KIND_MUSIC },
+};
+
+// The global (from resource_manager.c) each asset fills in. NULL if it is of another kind.
+static Model *GetAssetModel(AssetID id) {
+    switch (id) {
+        case ASSET_TERRAIN:          return &environmentModel;
+        case ASSET_SKYBOX:           return &skyboxModel;
+        case ASSET_RING:             return &ringModel;
+        case ASSET_PLANE_MODEL:      return &planeModel;
+        case ASSET_HELICOPTER_MODEL: return &helicopterModel;
+        default:                     return NULL;
+    }
+}
+
+// The rotation a model needs on top of its file (they are exported lying on their side or facing the wrong way).
+static Matrix GetAssetFixup(AssetID id) {
+    switch (id) {
+        case ASSET_RING:             return MatrixRotateX(90.0f * DEG2RAD);
+        case ASSET_PLANE_MODEL:
+        case ASSET_HELICOPTER_MODEL: return MatrixRotateY(90.0f * DEG2RAD);
+        default:                     return MatrixIdentity();
+    }
+}
+
+static Sound *GetAssetSound(AssetID id) {
+    switch (id) {
+        case ASSET_PLANE_SOUND:      return &planeSound;
+        case ASSET_HELICOPTER_SOUND: return &helicopterSound;
+        default:                     return NULL;
+    }
+}
+
+static Music *GetAssetMusic(AssetID id) {
+    switch (id) {
+        case ASSET_MENU_MUSIC:       return &menuMusic;
+        case ASSET_ENDING_MUSIC:     return &endingMusic;
+        default:                     return NULL;
+    }
+}
+
+
+// --- MANAGER STATE ---
+typedef struct AssetSlot {
+    AssetState state;
+    int refCount;             // How many screens hold it (never freed while above 0).
+    unsigned int lastUsed;    // 'clock' value of its last acquire, release or prefetch.
+    size_t bytes;             // Approximate memory it takes while loaded (RAM + GPU).
+    double requestTime;       // GetTime() when it was queued, to report how long it took.
+
+    // Passed from the worker to the main thread. Only whoever owns the current state touches them.
+    unsigned char *fileData;  // The whole file (models and music; music keeps it until it is freed).
+    int fileSize;
+    Wave wave;                // The decoded samples (sounds).
+    uint64_t sourceHash;      // Of 'fileData' (models), to tie the mesh cache to it.
+    bool isCached;            // True if 'cached' holds the model (read from the mesh cache).
+    CachedModel cached;
+} AssetSlot;
+
+// 'static' keeps these private to this file. 'state' and the job queue are shared with the
+// workers and protected by 'lock'; everything else is only touched by the main thread.
+static struct {
+    bool isRunning;
+    AssetSlot slots[ASSET_COUNT];
+    unsigned int clock;       // Counts every use, to find the least recently used asset.
+    size_t budget;
+
+    double startTime;         // GetTime() at StartAssetManager().
+    bool startupReported;     // The startup loading time was logged.
+    int modelsLoaded;         // Models finished so far...
+    int modelsFromCache;      // ...and how many of them came from the mesh cache.
+
+    // Jobs for the workers. An asset is never in the queue twice, so ASSET_COUNT places are enough.
+    AssetID queue[ASSET_COUNT];
+    int queueHead;
+    int queueCount;
+
+#if ASSET_THREADS
+    pthread_t workers[ASSET_WORKER_COUNT];
+    pthread_mutex_t lock;
+    pthread_cond_t hasJob;    // A job was queued (or it is time to quit).
+    pthread_cond_t jobDone;   // A worker finished one (FinishAssetLoading() waits for it).
+#endif
+} assets = { .budget = DEFAULT_ASSET_BUDGET };
+
+static void LockAssets(void) {
+#if ASSET_THREADS
+    pthread_mutex_lock(&assets.lock);
+#endif
+}
+
+static void UnlockAssets(void) {
+#if ASSET_THREADS
+    pthread_mutex_unlock(&assets.lock);
+#endif
+}
+
+static AssetState GetAssetState(AssetID id) {
+    LockAssets();
+    AssetState state = assets.slots[id].state;
+    UnlockAssets();
+    return state;
+}
+
+// Gives the asset a new state and its job to the workers. The lock must be held.
+static void QueueAssetJob(AssetID id, AssetState state) {
+    assets.slots[id].state = state;
+    assets.queue[(assets.queueHead + assets.queueCount) % ASSET_COUNT] = id;
+    assets.queueCount++;
+#if ASSET_THREADS
+    pthread_cond_signal(&assets.hasJob);
+#endif
+}
+
+
+// --- MEMORY ESTIMATES ---
+// Raylib keeps a copy of every mesh in RAM besides the GPU one, so the vertices count twice.
+static size_t EstimateModelBytes(Model model) {
+    size_t bytes = 0;
+
+    for (int i = 0; i < model.meshCount; i++) {
+        const Mesh *mesh = &model.meshes[i];
+
+        size_t vertexBytes = (3 + 3 + 2) * sizeof(float); // Position, normal and texture coordinates.
+        if (mesh->texcoords2 != NULL) vertexBytes += 2 * sizeof(float);
+        if (mesh->tangents != NULL)   vertexBytes += 4 * sizeof(float);
+        if (mesh->colors != NULL)     vertexBytes += 4;
+
+        bytes += 2 * (size_t)mesh->vertexCount * vertexBytes;
+        if (mesh->indices != NULL) {
+            bytes += 2 * (size_t)mesh->triangleCount * 3 * sizeof(unsigned short);
+        }
+    }
+
+    // Textures only live on the GPU (4 bytes per pixel).
+    for (int i = 0; i < model.materialCount; i++) {
+        if (model.materials[i].maps != NULL) {
+            Texture2D texture = model.materials[i].maps[MATERIAL_MAP_ALBEDO].texture;
+            bytes += (size_t)texture.width * (size_t)texture.height * 4;
+        }
+    }
+
+    return bytes;
+}
+
+
+// --- WORKER JOBS ---
+// Reads a whole file into a malloc() block (Raylib frees the blocks it gets from us with free()).
+static unsigned char *ReadWholeFile(const char *fileName, int *outSize) {
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char *data = (size > 0) ? (unsigned char *)malloc((size_t)size) : NULL;
+    if (data == NULL || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    *outSize = (int)size;
+    return data;
+}
+
+// Everything that doesn't need the GPU or the audio device. Returns false if the file is unusable.
+static bool ReadAsset(AssetID id) {
+    AssetSlot *slot = &assets.slots[id];
+    const AssetFile *asset = &assetFiles[id];
+
+    slot->fileData = ReadWholeFile(asset->fileName, &slot->fileSize);
+    if (slot->fileData == NULL) {
+        TraceLog(LOG_WARNING, "ASSETS: [%s] Failed to open file", asset->fileName);
+        return false;
+    }
+
+    // Models: if the mesh cache was built from these exact bytes, read it instead.
+    // Then the main thread only has to upload the arrays (no glTF parsing at all).
+    if (asset->kind == ASSET_KIND_MODEL) {
+        slot->sourceHash = HashMeshSource(slot->fileData, (size_t)slot->fileSize);
+
+        char cacheFile[256];
+        GetMeshCacheFileName(asset->fileName, cacheFile, sizeof(cacheFile));
+        slot->isCached = LoadMeshCache(cacheFile, (uint64_t)slot->fileSize, slot->sourceHash, GetAssetFixup(id), &slot->cached);
+        if (slot->isCached) {
+            free(slot->fileData);
+            slot->fileData = NULL;
+        }
+    }
+
+    // Sounds are decoded right here: the main thread only copies the samples into the audio device.
+    if (asset->kind == ASSET_KIND_SOUND) {
+        slot->wave = LoadWaveFromMemory(GetFileExtension(asset->fileName), slot->fileData, slot->fileSize);
+        free(slot->fileData);
+        slot->fileData = NULL;
+        return slot->wave.data != NULL;
+    }
+
+    return true;
+}
+
+// Runs the job of one asset: reading it (QUEUED) or building its collision data (BUILDING).
+static void RunAssetJob(AssetID id) {
+    LockAssets();
+    AssetState state = assets.slots[id].state;
+    if (state == ASSET_QUEUED) {
+        assets.slots[id].state = ASSET_READING;
+    }
+    UnlockAssets();
+
+    AssetState result;
+    if (state == ASSET_QUEUED) {
+        result = ReadAsset(id) ? ASSET_READ : ASSET_FAILED;
+    } else {
+        // Only the terrain gets here. Build the BVH once, so the per-frame raycasts don't have to test
+        // every triangle. Then rasterize the ground heights into a grid (or read the cached one).
+        // The model is already uploaded and never freed before shutdown, so reading it here is safe.
+        BuildTerrainCollision(environmentModel);
+        BakeTerrainHeightfield("resources/models/terrain.height", assetFiles[ASSET_TERRAIN].fileName);
+        result = ASSET_RESIDENT;
+    }
+
+    LockAssets();
+    assets.slots[id].state = result;
+#if ASSET_THREADS
+    pthread_cond_broadcast(&assets.jobDone);
+#endif
+    UnlockAssets();
+}
+
+#if ASSET_THREADS
+static void *AssetWorker(void *unused) {
+    (void)unused;
+
+    LockAssets();
+    while (true) {
+        while (assets.isRunning && assets.queueCount == 0) {
+            pthread_cond_wait(&assets.hasJob, &assets.lock);
+        }
+        if (!assets.isRunning) {
+            break;
+        }
+
+        AssetID id = assets.queue[assets.queueHead];
+        assets.queueHead = (assets.queueHead + 1) % ASSET_COUNT;
+        assets.queueCount--;
+
+        // The slow part runs without the lock, so the game (and the other worker) never wait for it.
+        UnlockAssets();
+        RunAssetJob(id);
+        LockAssets();
+    }
+    UnlockAssets();
+
+    return NULL;
+}
+#endif
+
+
+// --- MAIN THREAD ---
+// LoadModel() insists on reading the file itself. While it runs, this callback hands it the copy
+// a worker has already read. Anything else it asks for (external textures) is read normally.
+static struct {
+    const char *fileName;
+    unsigned char *data;
+    int size;
+} handoff = { 0 };
+
+static unsigned char *ServeReadFile(const char *fileName, int *dataSize) {
+    if (handoff.data != NULL && strcmp(fileName, handoff.fileName) == 0) {
+        unsigned char *data = handoff.data;
+        *dataSize = handoff.size;
+        handoff.data = NULL; // Raylib frees it now.
+        return data;
+    }
+
+    *dataSize = 0;
+    return ReadWholeFile(fileName, dataSize);
+}
+
+// Hands an asset a worker has read to the GPU / audio device and fills in its global.
+static void FinishAsset(AssetID id) {
+    AssetSlot *slot = &assets.slots[id];
+    const AssetFile *asset = &assetFiles[id];
+    AssetState result = ASSET_RESIDENT;
+    double finishStart = GetTime();
+
+    if (asset->kind == ASSET_KIND_MODEL && slot->isCached) {
+        // Warm start: the arrays are ready (fixup included), they only need to reach the GPU.
+        Model model = UploadCachedModel(&slot->cached);
+        slot->isCached = false;
+        assets.modelsFromCache++;
+
+        *GetAssetModel(id) = model;
+        slot->bytes = EstimateModelBytes(model);
+    } else if (asset->kind == ASSET_KIND_MODEL) {
+        // Cold start: Raylib parses the glTF and uploads it in the same call, so this stays on the main thread.
+        uint64_t sourceSize = (uint64_t)slot->fileSize;
+        handoff.fileName = asset->fileName;
+        handoff.data = slot->fileData;
+        handoff.size = slot->fileSize;
+        slot->fileData = NULL;
+
+        SetLoadFileDataCallback(ServeReadFile);
+        Model model = LoadModel(asset->fileName);
+        SetLoadFileDataCallback(NULL);
+
+        free(handoff.data); // Only if LoadModel() never asked for it.
+        handoff.data = NULL;
+
+        model.transform = MatrixMultiply(model.transform, GetAssetFixup(id));
+
+        // Save it for the next launch.
+        char cacheFile[256];
+        GetMeshCacheFileName(asset->fileName, cacheFile, sizeof(cacheFile));
+        if (WriteMeshCache(cacheFile, model, sourceSize, slot->sourceHash)) {
+            TraceLog(LOG_INFO, "ASSETS: Saved [%s] for the next launch", cacheFile);
+        }
+
+        *GetAssetModel(id) = model;
+        slot->bytes = EstimateModelBytes(model);
+
+        // The terrain still needs its collision data, built by a worker.
+        if (id == ASSET_TERRAIN) {
+            result = ASSET_BUILDING;
+        }
+    } else if (asset->kind == ASSET_KIND_SOUND) {
+        Sound sound = LoadSoundFromWave(slot->wave);
+        UnloadWave(slot->wave);
+        slot->wave = (Wave){ 0 };
+
+        SetSoundVolume(sound, (id == ASSET_PLANE_SOUND) ? 1.30f : 0.45f);
+
+        *GetAssetSound(id) = sound;
+        slot->bytes = (size_t)sound.frameCount * sound.stream.channels * (sound.stream.sampleSize / 8);
+    } else {
+        // Music is decoded bit by bit while it plays, straight from 'fileData' (kept until it is freed).
+        Music music = LoadMusicStreamFromMemory(GetFileExtension(asset->fileName), slot->fileData, slot->fileSize);
+        SetMusicVolume(music, (id == ASSET_MENU_MUSIC) ? 0.55f : 0.75f);
+
+        *GetAssetMusic(id) = music;
+        slot->bytes = (size_t)slot->fileSize;
+    }
+
+    LockAssets();
+    if (result == ASSET_BUILDING) {
+        QueueAssetJob(id, ASSET_BUILDING);
+    } else {
+        slot->state = result;
+    }
+    UnlockAssets();
+
+    // How long the main thread was busy with it is what the player could notice.
+    double now = GetTime();
+    TraceLog(LOG_INFO, "ASSETS: [%s] Loaded (%.1f MB) %.1f ms after the request, %.1f ms on the main thread",
+             asset->fileName, slot->bytes / (1024.0 * 1024.0),
+             (now - slot->requestTime) * 1000.0, (now - finishStart) * 1000.0);
+    if (asset->kind == ASSET_KIND_MODEL) {
+        assets.modelsLoaded++;
+    }
+}
+
+// Frees a loaded asset and zeroes its global, so it is safe to draw or play (it does nothing).
+static void UnloadAsset(AssetID id) {
+    AssetSlot *slot = &assets.slots[id];
+    const AssetFile *asset = &assetFiles[id];
+
+    if (asset->kind == ASSET_KIND_MODEL) {
+        if (id == ASSET_TERRAIN) {
+            UnloadTerrainHeightfield();
+            UnloadTerrainCollision();
+        }
+        UnloadModel(*GetAssetModel(id));
+        *GetAssetModel(id) = (Model){ 0 };
+    } else if (asset->kind == ASSET_KIND_SOUND) {
+        UnloadSound(*GetAssetSound(id));
+        *GetAssetSound(id) = (Sound){ 0 };
+    } else {
+        UnloadMusicStream(*GetAssetMusic(id));
+        *GetAssetMusic(id) = (Music){ 0 };
+    }
+
+    free(slot->fileData);
+    slot->fileData = NULL;
+    slot->bytes = 0;
+
+    LockAssets();
+    slot->state = ASSET_UNLOADED;
+    UnlockAssets();
+}
+
+// While the loaded assets take more than the budget, frees the one unused for the longest time
+// among those nobody holds.
+static void EvictUnusedAssets(void) {
+    size_t used = GetAssetMemoryUsage();
+
+    while (used > assets.budget) {
+        int victim = -1;
+        for (int id = 0; id < ASSET_COUNT; id++) {
+            const AssetSlot *slot = &assets.slots[id];
+            if (slot->refCount == 0 && GetAssetState((AssetID)id) == ASSET_RESIDENT &&
+                (victim < 0 || slot->lastUsed < assets.slots[victim].lastUsed)) {
+                victim = id;
+            }
+        }
+
+        if (victim < 0) {
+            break; // Everything left is held.
+        }
+
+        used -= assets.slots[victim].bytes;
+        TraceLog(LOG_INFO, "ASSETS: [%s] Freed (over the %.0f MB budget)", assetFiles[victim].fileName,
+                 assets.budget / (1024.0 * 1024.0));
+        UnloadAsset((AssetID)victim);
+    }
+}
+
+// Starts loading the asset if it isn't loaded (or on its way) already.
+static void RequestAsset(AssetID id) {
+    LockAssets();
+    if (assets.slots[id].state == ASSET_UNLOADED) {
+        assets.slots[id].requestTime = GetTime();
+        QueueAssetJob(id, ASSET_QUEUED);
+    }
+    UnlockAssets();
+}
+
+
+// --- PUBLIC FUNCTIONS ---
+
+void StartAssetManager(void) {
+    if (assets.isRunning) {
+        return;
+    }
+
+    assets.isRunning = true;
+    assets.startTime = GetTime();
+    assets.startupReported = false;
+
+#if ASSET_THREADS
+    pthread_mutex_init(&assets.lock, NULL);
+    pthread_cond_init(&assets.hasJob, NULL);
+    pthread_cond_init(&assets.jobDone, NULL);
+
+    for (int i = 0; i < ASSET_WORKER_COUNT; i++) {
+        pthread_create(&assets.workers[i], NULL, AssetWorker, NULL);
+    }
+#endif
+}
+
+void UpdateAssetManager(void) {
+    if (!assets.isRunning) {
+        return;
+    }
+
+#if !ASSET_THREADS
+    // No workers: do one of their jobs per frame right here.
+    if (assets.queueCount > 0) {
+        AssetID id = assets.queue[assets.queueHead];
+        assets.queueHead = (assets.queueHead + 1) % ASSET_COUNT;
+        assets.queueCount--;
+        RunAssetJob(id);
+    }
+#endif
+
+    // Sounds and music are cheap to finish, but every model is a GPU upload:
+    // at most one per frame, so the loading screen never freezes.
+    bool finishedModel = false;
+    for (int id = 0; id < ASSET_COUNT; id++) {
+        if (GetAssetState((AssetID)id) != ASSET_READ) {
+            continue;
+        }
+        if (assetFiles[id].kind == ASSET_KIND_MODEL) {
+            if (finishedModel) continue;
+            finishedModel = true;
+        }
+        FinishAsset((AssetID)id);
+    }
+
+    EvictUnusedAssets();
+
+    // The first time nothing is left on its way, report how long the startup loading took.
+    // Run the game twice to compare: the first launch parses every glTF (cold), the next ones
+    // read the mesh caches it saved (warm).
+    if (!assets.startupReported) {
+        bool isLoading = false;
+        for (int id = 0; id < ASSET_COUNT; id++) {
+            AssetState state = GetAssetState((AssetID)id);
+            if (state != ASSET_UNLOADED && state != ASSET_RESIDENT && state != ASSET_FAILED) {
+                isLoading = true;
+            }
+        }
+
+        if (!isLoading) {
+            assets.startupReported = true;
+            TraceLog(LOG_INFO, "ASSETS: Startup loading finished in %.1f ms (%d of %d models from the mesh cache: %s start)",
+                     (GetTime() - assets.startTime) * 1000.0, assets.modelsFromCache, assets.modelsLoaded,
+                     (assets.modelsFromCache == assets.modelsLoaded) ? "warm" : (assets.modelsFromCache == 0) ? "cold" : "partly warm");
+        }
+    }
+}
+
+void FinishAssetLoading(void) {
+    while (true) {
+        UpdateAssetManager();
+
+        // Done when nothing held is still on its way.
+        bool isLoading = false;
+        bool hasReadAsset = false;
+
+        LockAssets();
+        for (int id = 0; id < ASSET_COUNT; id++) {
+            AssetState state = assets.slots[id].state;
+            if (assets.slots[id].refCount > 0 && state != ASSET_RESIDENT && state != ASSET_FAILED) {
+                isLoading = true;
+            }
+            if (state == ASSET_READ) {
+                hasReadAsset = true;
+            }
+        }
+
+#if ASSET_THREADS
+        // Nothing for the main thread to finish yet: sleep until a worker is done with something.
+        if (isLoading && !hasReadAsset) {
+            pthread_cond_wait(&assets.jobDone, &assets.lock);
+        }
+#endif
+        UnlockAssets();
+
+        if (!isLoading) {
+            break;
+        }
+    }
+}
+
+void StopAssetManager(void) {
+    if (!assets.isRunning) {
+        return;
+    }
+
+#if ASSET_THREADS
+    // The workers finish the file they are reading and leave the rest of the queue.
+    LockAssets();
+    assets.isRunning = false;
+    pthread_cond_broadcast(&assets.hasJob);
+    UnlockAssets();
+
+    for (int i = 0; i < ASSET_WORKER_COUNT; i++) {
+        pthread_join(assets.workers[i], NULL);
+    }
+#endif
+    assets.isRunning = false;
+
+    // No worker is left, so every state can be read without the lock from here on.
+    for (int id = 0; id < ASSET_COUNT; id++) {
+        AssetSlot *slot = &assets.slots[id];
+
+        if (slot->state == ASSET_RESIDENT || slot->state == ASSET_BUILDING) {
+            UnloadAsset((AssetID)id);
+        } else if (slot->state == ASSET_READ) {
+            free(slot->fileData);
+            UnloadWave(slot->wave);
+            UnloadCachedModel(&slot->cached);
+        }
+
+        *slot = (AssetSlot){ 0 };
+    }
+    assets.queueHead = 0;
+    assets.queueCount = 0;
+
+#if ASSET_THREADS
+    pthread_cond_destroy(&assets.jobDone);
+    pthread_cond_destroy(&assets.hasJob);
+    pthread_mutex_destroy(&assets.lock);
+#endif
+}
+
+void AcquireAsset(AssetID id) {
+    assets.slots[id].refCount++;
+    assets.slots[id].lastUsed = ++assets.clock;
+    RequestAsset(id);
+}
+
+void ReleaseAsset(AssetID id) {
+    if (assets.slots[id].refCount > 0) {
+        assets.slots[id].refCount--;
+    }
+    assets.slots[id].lastUsed = ++assets.clock;
+}
+
+void PrefetchAsset(AssetID id) {
+    assets.slots[id].lastUsed = ++assets.clock;
+    RequestAsset(id);
+}
+
+float GetAssetLoadingProgress(const AssetID *ids, int count) {
+    if (count <= 0) {
+        return 1.0f;
+    }
+
+    // Each step of the way counts a little, so the bar keeps moving during a big file.
+    float progress = 0.0f;
+    for (int i = 0; i < count; i++) {
+        switch (GetAssetState(ids[i])) {
+            case ASSET_READING:  progress += 0.25f; break;
+            case ASSET_READ:     progress += 0.5f;  break;
+            case ASSET_BUILDING: progress += 0.75f; break;
+            case ASSET_RESIDENT:
+            case ASSET_FAILED:   progress += 1.0f;  break;
+            default:                                break;
+        }
+    }
+
+    return progress / count;
+}
+
+void SetAssetMemoryBudget(size_t bytes) {
+    assets.budget = bytes;
+}
+
+size_t GetAssetMemoryUsage(void) {
+    size_t used = 0;
+    for (int id = 0; id < ASSET_COUNT; id++) {
+        used += assets.slots[id].bytes;
+    }
+    return used;
+}
@@ -0,0 +1,101 @@
+// Include math library to use advanced mathematical functions.
+#include <math.h>
+
+// We include our own header file.
+// The camera lives in its own module because it reads the keyboard and the gamepad directly,
+// while the flight physics in player.c must keep working without any window or input device.
+#include "camera.h"
+
+
+// --- DYNAMIC CAMERA ---
+// Handles the mathematics for spherical orbit (3rd person) and cockpit view (1st person).
+// It runs once per rendered frame (not per simulation tick), using 'alpha' to interpolate the pose.
+void UpdateDynamicCamera(Camera3D *camera, Player *player, float alpha) {
+    
+    // Toggle camera mode when pressing 'C' (Keyboard) or 'A' (Gamepad).
+    if (IsKeyPressed(KEY_C) || (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
+        player->isFirstPerson = !player->isFirstPerson;
+    }
+
+    if (!player->isFirstPerson) {
+        // --- 3RD PERSON ORBIT LOGIC ---
+        
+        if (IsGamepadAvailable(0)) {
+            // Gamepad: Absolute positioning based on right thumbstick tilt.
+            float smoothFactor = 0.1f;
+
+            float rightStickX = GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_X);
+            float rightStickY = GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_Y);
+
+            // Deadzone check.
+            if (fabsf(rightStickX) < 0.15f) rightStickX = 0.0f;
+            if (fabsf(rightStickY) < 0.15f) rightStickY = 0.0f;
+
+            float targetYaw = -rightStickX * 2.5f; 
+            float targetPitch = rightStickY * 1.5f; 
+
+            player->cameraAngleYaw = Lerp(player->cameraAngleYaw, targetYaw, smoothFactor);
+            player->cameraAnglePitch = Lerp(player->cameraAnglePitch, targetPitch, smoothFactor);
+            
+        } else {
+            // Keyboard: Relative positioning using arrow keys.
+            float smoothFactor = 0.3f; 
+            
+            float targetYaw = player->cameraAngleYaw;
+            float targetPitch = player->cameraAnglePitch;
+
+            if (IsKeyDown(KEY_RIGHT)) targetYaw -= 0.08f;
+            if (IsKeyDown(KEY_LEFT))  targetYaw += 0.08f;
+            if (IsKeyDown(KEY_UP))    targetPitch -= 0.08f;
+            if (IsKeyDown(KEY_DOWN))  targetPitch += 0.08f;
+
+            // Auto-centering mechanism.
+            if (!IsKeyDown(KEY_RIGHT) && !IsKeyDown(KEY_LEFT)) targetYaw *= 0.90f;
+            if (!IsKeyDown(KEY_UP) && !IsKeyDown(KEY_DOWN))    targetPitch *= 0.90f;
+
+            // Clamp the target angles to prevent clipping.
+            if (targetPitch > 1.5f)  targetPitch = 1.5f;
+            if (targetPitch < -0.5f) targetPitch = -0.5f;
+            if (targetYaw > 2.5f)    targetYaw = 2.5f;
+            if (targetYaw < -2.5f)   targetYaw = -2.5f;
+
+            player->cameraAngleYaw = Lerp(player->cameraAngleYaw, targetYaw, smoothFactor);
+            player->cameraAnglePitch = Lerp(player->cameraAnglePitch, targetPitch, smoothFactor);
+        }
+    } else {
+        // Reset manual orbit angles when switching to First Person view for a clean transition.
+        player->cameraAngleYaw = player->rotation.y; 
+        player->cameraAnglePitch = 0.0f;
+    }
+
+    // --- APPLY CAMERA TRANSFORMATIONS ---
+    // The camera follows the INTERPOLATED pose (between the last two simulation ticks),
+    // so it moves smoothly even when the render rate and the tick rate don't match.
+    Vector3 renderPosition = Vector3Lerp(player->prevPosition, player->position, alpha);
+    Vector3 renderRotation = Vector3Lerp(player->prevRotation, player->rotation, alpha);
+
+    if (player->isFirstPerson) {
+        // 1st person (Cockpit).
+        camera->position = (Vector3){ renderPosition.x, renderPosition.y + 0.5f, renderPosition.z };
+        
+        // Calculate exactly where the nose of the vehicle is pointing using trigonometry.
+        camera->target.x = camera->position.x - (sinf(renderRotation.y) * cosf(renderRotation.x));
+        camera->target.y = camera->position.y +  sinf(renderRotation.x); 
+        camera->target.z = camera->position.z - (cosf(renderRotation.y) * cosf(renderRotation.x));
+        
+    } else {
+        // 3rd person (Orbit chase camera).
+        camera->target = renderPosition;
+        float cameraDistance = 4.0f;
+        float cameraHeight = 1.5f; 
+
+        // Combine player rotation with manual orbit input.
+        float totalYaw = renderRotation.y + player->cameraAngleYaw;
+        float totalPitch = player->cameraAnglePitch;
+
+        // Spherical coordinates calculation.
+        camera->position.x = renderPosition.x + (sinf(totalYaw) * cosf(totalPitch) * cameraDistance);
+        camera->position.y = renderPosition.y + (sinf(totalPitch) * cameraDistance) + cameraHeight;
+        camera->position.z = renderPosition.z + (cosf(totalYaw) * cosf(totalPitch) * cameraDistance);
+    }
+}
@@ -0,0 +1,282 @@
+// Include standard libraries for memory allocation and math.
+#include <stdlib.h>
+#include <math.h>
+
+// We include our own header file.
+#include "ghost.h"
+
+
+// --- FILE LAYOUT ---
+// [GhostFileHeader] followed by 'keyframeCount - 1' encoded keyframes of 13 bytes each:
+//   3 x int16 -> movement since the previous keyframe (X, Y, Z) in 1/GHOST_POSITION_SCALE units.
+//   3 x int16 -> rotation (pitch, yaw, roll), wrapped to -PI..PI and scaled to the full int16 range.
+//   1 x uint8 -> vehicle type.
+// Keyframe 0 is the spawn pose stored in the header.
+// The header is written as a raw struct, so a ghost file only plays back on the kind of machine
+// that recorded it (same endianness and struct layout), like the replays.
+typedef struct GhostFileHeader {
+    unsigned int magic;       // GHOST_MAGIC ("GHS1").
+    int version;              // GHOST_VERSION.
+    int keyframeCount;        // Keyframes in the file (including the spawn pose).
+    int keyframeTicks;        // Ticks between keyframes (GHOST_KEYFRAME_TICKS when recorded).
+    Vector3 startPosition;    // Position of keyframe 0.
+    Vector3 startRotation;    // Rotation of keyframe 0.
+    int startVehicle;         // Vehicle of keyframe 0.
+} GhostFileHeader;
+
+#define GHOST_KEYFRAME_BYTES 13
+
+// Seconds between two keyframes.
+#define GHOST_KEYFRAME_SECONDS (GHOST_KEYFRAME_TICKS * SIM_DT)
+
+
+// --- QUANTIZATION HELPERS ---
+
+static short QuantizeShort(float value) {
+    if (value > 32767.0f)  value = 32767.0f;
+    if (value < -32767.0f) value = -32767.0f;
+    return (short)lroundf(value);
+}
+
+// Angles can grow past a full turn (the yaw keeps adding up), so we wrap them first.
+static float WrapGhostAngle(float angle) {
+    angle = fmodf(angle + PI, 2.0f * PI);
+    if (angle < 0.0f) angle += 2.0f * PI;
+    return angle - PI;
+}
+
+static short QuantizeAngle(float angle) {
+    return QuantizeShort(WrapGhostAngle(angle) * (32767.0f / PI));
+}
+
+static float DequantizeAngle(short value) {
+    return (float)value * (PI / 32767.0f);
+}
+
+// Little-endian 16-bit write/read: the keyframes don't depend on how the CPU stores a 'short'.
+static void WriteShort(unsigned char *out, short value) {
+    out[0] = (unsigned char)(value & 0xFF);
+    out[1] = (unsigned char)((value >> 8) & 0xFF);
+}
+
+static short ReadShort(const unsigned char *in) {
+    return (short)(in[0] | (in[1] << 8));
+}
+
+
+// --- RECORDING ---
+
+void BeginGhostRecording(GhostRecorder *recorder, const Player *player) {
+    // Keep the buffer from the previous flight, just start writing from the beginning.
+    recorder->size = 0;
+    recorder->keyframeCount = 1;
+    recorder->tickCounter = 0;
+
+    // Keyframe 0 (the spawn pose) goes into the file header.
+    recorder->startPosition = player->position;
+    recorder->startRotation = player->rotation;
+    recorder->startVehicle = player->type;
+    recorder->lastPosition = player->position;
+}
+
+void RecordGhostTick(GhostRecorder *recorder, const Player *player) {
+    recorder->tickCounter++;
+    if (recorder->tickCounter < GHOST_KEYFRAME_TICKS) {
+        return;
+    }
+    recorder->tickCounter = 0;
+
+    if (recorder->size + GHOST_KEYFRAME_BYTES > recorder->capacity) {
+        recorder->capacity = (recorder->capacity > 0) ? recorder->capacity * 2 : 4096;
+        recorder->data = (unsigned char *)realloc(recorder->data, recorder->capacity);
+    }
+
+    // Movement since the previous keyframe, measured from where the DECODER thinks we were.
+    // That way the rounding errors never pile up over a long flight.
+    short dx = QuantizeShort((player->position.x - recorder->lastPosition.x) * GHOST_POSITION_SCALE);
+    short dy = QuantizeShort((player->position.y - recorder->lastPosition.y) * GHOST_POSITION_SCALE);
+    short dz = QuantizeShort((player->position.z - recorder->lastPosition.z) * GHOST_POSITION_SCALE);
+
+    recorder->lastPosition.x += (float)dx / GHOST_POSITION_SCALE;
+    recorder->lastPosition.y += (float)dy / GHOST_POSITION_SCALE;
+    recorder->lastPosition.z += (float)dz / GHOST_POSITION_SCALE;
+
+    unsigned char *out = &recorder->data[recorder->size];
+    WriteShort(&out[0], dx);
+    WriteShort(&out[2], dy);
+    WriteShort(&out[4], dz);
+    WriteShort(&out[6], QuantizeAngle(player->rotation.x));
+    WriteShort(&out[8], QuantizeAngle(player->rotation.y));
+    WriteShort(&out[10], QuantizeAngle(player->rotation.z));
+    out[12] = (unsigned char)player->type;
+
+    recorder->size += GHOST_KEYFRAME_BYTES;
+    recorder->keyframeCount++;
+}
+
+bool SaveGhost(GhostRecorder *recorder, const char *fileName) {
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "GHOST: Could not write [%s]", fileName);
+        return false;
+    }
+
+    GhostFileHeader header = { 0 };
+    header.magic = GHOST_MAGIC;
+    header.version = GHOST_VERSION;
+    header.keyframeCount = recorder->keyframeCount;
+    header.keyframeTicks = GHOST_KEYFRAME_TICKS;
+    header.startPosition = recorder->startPosition;
+    header.startRotation = recorder->startRotation;
+    header.startVehicle = (int)recorder->startVehicle;
+
+    fwrite(&header, sizeof(header), 1, file); // Raw, in this machine's byte order (see FILE LAYOUT).
+    if (recorder->size > 0) {
+        fwrite(recorder->data, 1, recorder->size, file);
+    }
+    fclose(file);
+
+    TraceLog(LOG_INFO, "GHOST: Saved [%s] (%d keyframes)", fileName, recorder->keyframeCount);
+    return true;
+}
+
+void UnloadGhostRecorder(GhostRecorder *recorder) {
+    free(recorder->data);
+    recorder->data = NULL;
+    recorder->size = 0;
+    recorder->capacity = 0;
+}
+
+
+// --- STREAMING PLAYBACK ---
+
+// Reads ONE keyframe from the file into 'ghost->next'. Returns false at the end of the file.
+static bool DecodeNextKeyframe(GhostPlayback *ghost) {
+    if (ghost->keyframesLeft <= 0) {
+        return false;
+    }
+
+    unsigned char in[GHOST_KEYFRAME_BYTES];
+    if (fread(in, 1, GHOST_KEYFRAME_BYTES, ghost->file) != GHOST_KEYFRAME_BYTES) {
+        ghost->keyframesLeft = 0;
+        return false;
+    }
+    ghost->keyframesLeft--;
+
+    ghost->decodedPosition.x += (float)ReadShort(&in[0]) / GHOST_POSITION_SCALE;
+    ghost->decodedPosition.y += (float)ReadShort(&in[2]) / GHOST_POSITION_SCALE;
+    ghost->decodedPosition.z += (float)ReadShort(&in[4]) / GHOST_POSITION_SCALE;
+
+    GhostKeyframe keyframe = { 0 };
+    keyframe.time = ghost->next.time + GHOST_KEYFRAME_SECONDS;
+    keyframe.position = ghost->decodedPosition;
+    keyframe.rotation = (Vector3){
+        DequantizeAngle(ReadShort(&in[6])),
+        DequantizeAngle(ReadShort(&in[8])),
+        DequantizeAngle(ReadShort(&in[10]))
+    };
+    keyframe.vehicle = (VehicleType)in[12];
+
+    ghost->previous = ghost->next;
+    ghost->next = keyframe;
+    return true;
+}
+
+GhostPlayback OpenGhost(const char *fileName) {
+    GhostPlayback ghost = { 0 };
+
+    ghost.file = fopen(fileName, "rb");
+    if (ghost.file == NULL) {
+        return ghost;
+    }
+
+    GhostFileHeader header = { 0 };
+    if (fread(&header, sizeof(header), 1, ghost.file) != 1 ||
+        header.magic != GHOST_MAGIC ||
+        header.version != GHOST_VERSION ||
+        header.keyframeTicks != GHOST_KEYFRAME_TICKS ||
+        header.keyframeCount < 1) {
+        TraceLog(LOG_WARNING, "GHOST: [%s] is not a valid ghost file", fileName);
+        fclose(ghost.file);
+        ghost.file = NULL;
+        return ghost;
+    }
+
+    // Keyframe 0 comes straight from the header.
+    ghost.start.time = 0.0f;
+    ghost.start.position = header.startPosition;
+    ghost.start.rotation = header.startRotation;
+    ghost.start.vehicle = (VehicleType)header.startVehicle;
+    ghost.keyframeCount = header.keyframeCount;
+
+    ghost.isActive = true;
+    RewindGhost(&ghost);
+    return ghost;
+}
+
+void RewindGhost(GhostPlayback *ghost) {
+    if (ghost->file == NULL) {
+        return;
+    }
+
+    // The keyframes start right after the header.
+    fseek(ghost->file, (long)sizeof(GhostFileHeader), SEEK_SET);
+
+    ghost->next = ghost->start;
+    ghost->previous = ghost->start;
+    ghost->decodedPosition = ghost->start.position;
+    ghost->keyframesLeft = ghost->keyframeCount - 1;
+
+    // Decode keyframe 1 so there is already a segment to interpolate.
+    DecodeNextKeyframe(ghost);
+}
+
+void UpdateGhost(GhostPlayback *ghost, float raceTime) {
+    if (!ghost->isActive) {
+        return;
+    }
+
+    // Move forward until 'raceTime' lies between 'previous' and 'next', within the budget.
+    // If we fall behind (e.g. after a freeze), we catch up over the next few frames.
+    int budget = GHOST_DECODE_BUDGET;
+    while (budget > 0 && ghost->next.time <= raceTime) {
+        if (!DecodeNextKeyframe(ghost)) {
+            break;
+        }
+        budget--;
+    }
+}
+
+GhostKeyframe GetGhostPose(const GhostPlayback *ghost, float raceTime) {
+    const GhostKeyframe *a = &ghost->previous;
+    const GhostKeyframe *b = &ghost->next;
+
+    float span = b->time - a->time;
+    float t = (span > 0.0f) ? (raceTime - a->time) / span : 1.0f;
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+
+    GhostKeyframe pose = *b;
+    pose.time = raceTime;
+    pose.position = Vector3Lerp(a->position, b->position, t);
+
+    // Angles take the shortest way around (e.g. from +179 to -179 degrees is a 2 degree turn).
+    pose.rotation.x = a->rotation.x + WrapGhostAngle(b->rotation.x - a->rotation.x) * t;
+    pose.rotation.y = a->rotation.y + WrapGhostAngle(b->rotation.y - a->rotation.y) * t;
+    pose.rotation.z = a->rotation.z + WrapGhostAngle(b->rotation.z - a->rotation.z) * t;
+
+    return pose;
+}
+
+void CloseGhost(GhostPlayback *ghost) {
+    if (ghost->file != NULL) {
+        fclose(ghost->file);
+    }
+    ghost->file = NULL;
+    ghost->isActive = false;
+}
+
+void GetGhostFileName(int levelID, uint32_t runID, char *outName, int outSize) {
+    // Same naming as the replays: the sequence number identifies the leaderboard entry.
+    snprintf(outName, outSize, "data/times_lvl%d_run%u.ghost", levelID, (unsigned int)runID);
+}
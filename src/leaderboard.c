@@ -1,152 +1,1017 @@
+// Include standard libraries for memory allocation and sorting.
+#include <stdlib.h>
+
 // We include our own header file.
+// mapped_file.h swaps a finished temporary file in for the real one (shared with the level and model caches).
 #include "leaderboard.h"
+#include "mapped_file.h"
 
-// Standard C doesn't have a built-in function to create folders, 
-// so we ask the Operating System (Windows or Linux/Mac) to do it.
+// Standard C doesn't have a built-in function to create folders (or to make sure a file really
+// reached the disk), so we ask the Operating System (Windows or Linux/Mac) to do it.
 #ifdef _WIN32
     #include <direct.h>
+    #include <io.h>
     #define MAKE_DIR(name) _mkdir(name)
+    #define SYNC_FILE(file) _commit(_fileno(file))
 #else
     #include <sys/stat.h>
+    #include <unistd.h>
     #define MAKE_DIR(name) mkdir(name, 0777)
+    #define SYNC_FILE(file) fsync(fileno(file))
+#endif
+
+// The web build has no threads: there, compaction runs right away on the main thread.
+#if !defined(__EMSCRIPTEN__)
+    #define LEADERBOARD_THREADS 1
+    #include <pthread.h>
+#else
+    #define LEADERBOARD_THREADS 0
+#endif
+
+
+// --- FILE LAYOUT ---
+// The board file is cut into pages of LEADERBOARD_PAGE_SIZE bytes. Page 0 holds the header,
+// every other page is one node of a B+tree sorted by (time, sequence):
+// - LEAF pages hold the runs themselves, sorted, and point to the next leaf (the next slower runs).
+// - INNER pages hold up to 255 children. For each child they keep its smallest key (to know where a
+//   time goes) and how many runs live below it (to know which rank that is).
+// With 145 runs per leaf and 255 children per inner page, 3 levels already hold 9 million runs.
+//
+// The board is never edited in place: compaction writes a complete new one beside it and swaps it
+// in with a rename, so a crash at any moment leaves either the old board or the new one.
+#define LEAF_CAPACITY ((LEADERBOARD_PAGE_SIZE - 16) / (int)sizeof(LeaderboardRecord))
+#define NODE_CAPACITY ((LEADERBOARD_PAGE_SIZE - 16) / 16)
+
+// What the tree sorts by. The sequence makes every key unique: on equal times, the run that was
+// submitted first stays ahead.
+typedef struct StoreKey {
+    float time;
+    uint32_t sequence;
+} StoreKey;
+
+typedef struct StoreLeaf {
+    uint32_t isLeaf;            // 1.
+    uint32_t count;             // Runs in this page.
+    uint32_t next;              // The next leaf (0 = this is the slowest one).
+    uint32_t unused;
+    LeaderboardRecord records[LEAF_CAPACITY];
+} StoreLeaf;
+
+typedef struct StoreNode {
+    uint32_t isLeaf;            // 0.
+    uint32_t count;             // Children in this page.
+    uint32_t unused[2];
+    StoreKey keys[NODE_CAPACITY];       // Smallest key under each child (keys[0] is never compared).
+    uint32_t children[NODE_CAPACITY];   // Page of each child.
+    uint32_t counts[NODE_CAPACITY];     // Runs under each child.
+} StoreNode;
+
+// One page as it sits in RAM. The 'bytes' member makes it exactly one page long.
+typedef union StorePage {
+    StoreLeaf leaf;
+    StoreNode node;
+    LeaderboardFileHeader header;
+    unsigned char bytes[LEADERBOARD_PAGE_SIZE];
+} StorePage;
+
+// A finished page of the level below, while a new board is being built bottom-up.
+typedef struct ChildRef {
+    StoreKey key;               // Smallest key in it.
+    uint32_t page;
+    uint32_t count;             // Runs under it.
+} ChildRef;
+
+// A position in the board, to read runs one after the other in rank order.
+typedef struct BoardCursor {
+    LeaderboardStore *store;
+    StorePage page;             // The leaf being read.
+    uint32_t position;          // Next run in that leaf.
+    uint32_t hops;              // Leaves visited (a damaged 'next' can't make us loop forever).
+    bool isValid;
+} BoardCursor;
+
+
+// --- BACKGROUND COMPACTION ---
+// One thread folds the journals into their boards, one level at a time.
+// The lock also keeps the main thread from reading a board and its journal halfway through a swap.
+#define COMPACTION_QUEUE_SIZE 16
+
+static struct {
+    bool isRunning;             // The thread exists.
+    bool isBusy;                // It is compacting 'busyLevel' right now.
+    int busyLevel;
+
+    int queue[COMPACTION_QUEUE_SIZE];   // Levels waiting.
+    int queueHead;
+    int queueCount;
+
+#if LEADERBOARD_THREADS
+    pthread_t worker;
+    pthread_mutex_t lock;
+    pthread_cond_t hasJob;      // A level was queued (or it is time to quit).
+#endif
+} compactor = {
+#if LEADERBOARD_THREADS
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .hasJob = PTHREAD_COND_INITIALIZER
+#endif
+};
+
+static void LockCompactor(void) {
+#if LEADERBOARD_THREADS
+    pthread_mutex_lock(&compactor.lock);
+#endif
+}
+
+static void UnlockCompactor(void) {
+#if LEADERBOARD_THREADS
+    pthread_mutex_unlock(&compactor.lock);
+#endif
+}
+
+
+// --- SMALL HELPERS ---
+// Orders two keys: negative if 'a' comes first, positive if 'b' does.
+static int CompareKeys(StoreKey a, StoreKey b) {
+    if (a.time < b.time) return -1;
+    if (a.time > b.time) return 1;
+    if (a.sequence < b.sequence) return -1;
+    if (a.sequence > b.sequence) return 1;
+    return 0;
+}
+
+static StoreKey RecordKey(const LeaderboardRecord *record) {
+    return (StoreKey){ record->time, record->sequence };
+}
+
+// The same order for qsort().
+static int CompareRecords(const void *a, const void *b) {
+    return CompareKeys(RecordKey(a), RecordKey(b));
+}
+
+// How many of 'count' sorted runs come before 'key' (binary search).
+static int RecordPosition(const LeaderboardRecord *records, int count, StoreKey key) {
+    int low = 0;
+    int high = count;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (CompareKeys(RecordKey(&records[middle]), key) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Which child of an inner page 'key' belongs to: the last one whose smallest key isn't above it.
+static int NodeChild(const StoreNode *node, StoreKey key) {
+    int low = 1;
+    int high = (int)node->count;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (CompareKeys(node->keys[middle], key) <= 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low - 1;
+}
+
+// Runs under the first 'childCount' children of an inner page.
+static uint32_t SumCounts(const StoreNode *node, int childCount) {
+    uint32_t sum = 0;
+    for (int i = 0; i < childCount; i++) {
+        sum += node->counts[i];
+    }
+    return sum;
+}
+
+// The same clean-up the old text file needed: no spaces, never empty.
+void SanitizeLeaderboardName(const char *name, char *outName) {
+    strcpy(outName, "UNKNOWN"); // Default fallback name.
+
+    if (name != NULL && strlen(name) > 0) {
+        strncpy(outName, name, MAX_NAME_LENGTH);
+        outName[MAX_NAME_LENGTH] = '\0'; // Force the null-terminator.
+
+        for (int i = 0; outName[i] != '\0'; i++) {
+            if (outName[i] == ' ') {
+                outName[i] = '_';
+            }
+        }
+    }
+}
+
+// FNV-1a over one run. Cheap, and any torn or flipped byte changes it.
+static uint32_t ChecksumRun(const LeaderboardRecord *run) {
+    const unsigned char *bytes = (const unsigned char *)run;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(*run); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// How many journal runs a level collects before its board gets rewritten (see leaderboard.h).
+static int CompactionThreshold(const LeaderboardStore *store) {
+    int threshold = (int)(store->header.runCount / LEADERBOARD_COMPACT_FRACTION);
+    return (threshold > LEADERBOARD_COMPACT_RUNS) ? threshold : LEADERBOARD_COMPACT_RUNS;
+}
+
+
+// --- BOARD PAGES ---
+// Reads one page and checks it is a sane tree page (so a damaged file can't send us out of bounds).
+static bool ReadPage(LeaderboardStore *store, uint32_t pageIndex, StorePage *page) {
+    if (pageIndex == 0 || pageIndex >= store->header.pageCount) return false;
+    if (fseek(store->file, (long)pageIndex * LEADERBOARD_PAGE_SIZE, SEEK_SET) != 0) return false;
+    if (fread(page->bytes, LEADERBOARD_PAGE_SIZE, 1, store->file) != 1) return false;
+
+    if (page->leaf.isLeaf == 1) return page->leaf.count <= LEAF_CAPACITY;
+    if (page->node.isLeaf == 0) return page->node.count >= 1 && page->node.count <= NODE_CAPACITY;
+    return false;
+}
+
+// Opens a board file and checks its header (and that it is as long as the header says).
+static bool OpenBoardFile(LeaderboardStore *store, const char *fileName, const char *mode) {
+    store->file = fopen(fileName, mode);
+    if (store->file == NULL) return false;
+
+    StorePage page;
+    LeaderboardFileHeader *header = &page.header;
+    bool isValid = fread(page.bytes, LEADERBOARD_PAGE_SIZE, 1, store->file) == 1 &&
+                   memcmp(header->magic, LEADERBOARD_MAGIC, 4) == 0 &&
+                   header->version == LEADERBOARD_VERSION &&
+                   header->pageSize == LEADERBOARD_PAGE_SIZE &&
+                   header->height >= 1 &&
+                   header->rootPage >= 1 && header->rootPage < header->pageCount;
+
+    if (isValid) {
+        fseek(store->file, 0, SEEK_END);
+        isValid = ftell(store->file) >= (long)header->pageCount * LEADERBOARD_PAGE_SIZE;
+    }
+
+    if (isValid) {
+        store->header = *header;
+        return true;
+    }
+
+    TraceLog(LOG_WARNING, "LEADERBOARD: [%s] is not a valid board file", fileName);
+    fclose(store->file);
+    store->file = NULL;
+    return false;
+}
+
+// How many runs of the board come before 'key'.
+static uint32_t BoardCountBefore(LeaderboardStore *store, StoreKey key) {
+    if (store->file == NULL) return 0;
+
+    uint32_t countBefore = 0;
+    uint32_t pageIndex = store->header.rootPage;
+
+    for (uint32_t level = 0; level < store->header.height; level++) {
+        StorePage page;
+        if (!ReadPage(store, pageIndex, &page)) break;
+
+        if (page.leaf.isLeaf) {
+            countBefore += RecordPosition(page.leaf.records, (int)page.leaf.count, key);
+            break;
+        }
+
+        int child = NodeChild(&page.node, key);
+        countBefore += SumCounts(&page.node, child);
+        pageIndex = page.node.children[child];
+    }
+
+    return countBefore;
+}
+
+// Puts the cursor on the run at 'index' (0 = the fastest), walking down by the counts:
+// whole children are skipped until the index falls inside one.
+static bool SeekBoard(BoardCursor *cursor, LeaderboardStore *store, uint32_t index) {
+    cursor->store = store;
+    cursor->hops = 0;
+    cursor->isValid = false;
+    if (store->file == NULL || index >= store->header.runCount) return false;
+
+    uint32_t pageIndex = store->header.rootPage;
+    for (uint32_t level = 0; ; level++) {
+        if (level >= store->header.height || !ReadPage(store, pageIndex, &cursor->page)) return false;
+        if (cursor->page.leaf.isLeaf) break;
+
+        StoreNode *node = &cursor->page.node;
+        int child = 0;
+        while (child < (int)node->count - 1 && index >= node->counts[child]) {
+            index -= node->counts[child];
+            child++;
+        }
+        pageIndex = node->children[child];
+    }
+
+    cursor->position = index;
+    cursor->isValid = true;
+    return true;
+}
+
+// Reads the run under the cursor and moves to the next one, hopping leaves when one runs out.
+static bool NextBoardRecord(BoardCursor *cursor, LeaderboardRecord *outRecord) {
+    if (!cursor->isValid) return false;
+
+    while (cursor->position >= cursor->page.leaf.count) {
+        uint32_t next = cursor->page.leaf.next;
+        if (next == 0 || ++cursor->hops > cursor->store->header.pageCount ||
+            !ReadPage(cursor->store, next, &cursor->page) || !cursor->page.leaf.isLeaf) {
+            cursor->isValid = false;
+            return false;
+        }
+        cursor->position = 0;
+    }
+
+    *outRecord = cursor->page.leaf.records[cursor->position++];
+    outRecord->name[MAX_NAME_LENGTH] = '\0';
+    return true;
+}
+
+
+// --- JOURNAL ---
+// Reads every intact record of a journal whose sequence is at least 'minSequence' (older ones are
+// already in the board). Records are all the same size, so a damaged one is simply skipped;
+// '*outDamaged' says whether there was any (a run cut short by a crash, usually the last one).
+static void ReadJournal(const char *fileName, uint32_t minSequence,
+                        LeaderboardRecord **outRuns, int *outCount, bool *outDamaged) {
+    *outRuns = NULL;
+    *outCount = 0;
+    if (outDamaged != NULL) *outDamaged = false;
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return;
+
+    int capacity = 0;
+    LeaderboardJournalRecord record;
+    size_t bytesRead;
+    while ((bytesRead = fread(&record, 1, sizeof(record), file)) > 0) {
+        if (bytesRead < sizeof(record) ||
+            memcmp(record.magic, LEADERBOARD_JOURNAL_MAGIC, 4) != 0 ||
+            record.checksum != ChecksumRun(&record.run)) {
+            if (outDamaged != NULL) *outDamaged = true;
+            continue;
+        }
+        if (record.run.sequence < minSequence) continue;
+
+        if (*outCount == capacity) {
+            int newCapacity = (capacity == 0) ? LEADERBOARD_COMPACT_RUNS : capacity * 2;
+            LeaderboardRecord *grown = realloc(*outRuns, newCapacity * sizeof(LeaderboardRecord));
+            if (grown == NULL) break;
+            *outRuns = grown;
+            capacity = newCapacity;
+        }
+
+        record.run.name[MAX_NAME_LENGTH] = '\0';
+        (*outRuns)[(*outCount)++] = record.run;
+    }
+
+    fclose(file);
+}
+
+static LeaderboardJournalRecord MakeJournalRecord(const LeaderboardRecord *run) {
+    LeaderboardJournalRecord record;
+    memcpy(record.magic, LEADERBOARD_JOURNAL_MAGIC, 4);
+    record.run = *run;
+    record.checksum = ChecksumRun(run);
+    return record;
+}
+
+// Appends one run and waits until it is really on the disk (not just in a cache).
+// Nothing already in the file is ever rewritten, so a power loss can only cut this one record short.
+static bool AppendJournal(const char *fileName, const LeaderboardRecord *run) {
+    FILE *file = fopen(fileName, "ab");
+    if (file == NULL) return false;
+
+    LeaderboardJournalRecord record = MakeJournalRecord(run);
+    bool isSaved = fwrite(&record, sizeof(record), 1, file) == 1 &&
+                   fflush(file) == 0 &&
+                   SYNC_FILE(file) == 0;
+
+    fclose(file);
+    return isSaved;
+}
+
+// Writes a clean journal holding just 'runs' (or deletes it if there are none).
+static bool RewriteJournal(const char *fileName, const LeaderboardRecord *runs, int count) {
+    if (count == 0) {
+        remove(fileName);
+        return true;
+    }
+
+    char tempName[80];
+    FILE *file = OpenReplacementFile(fileName, tempName, sizeof(tempName));
+    if (file == NULL) return false;
+
+    bool isSaved = true;
+    for (int i = 0; i < count && isSaved; i++) {
+        LeaderboardJournalRecord record = MakeJournalRecord(&runs[i]);
+        isSaved = fwrite(&record, sizeof(record), 1, file) == 1;
+    }
+    isSaved = isSaved && fflush(file) == 0 && SYNC_FILE(file) == 0;
+
+    return CommitReplacementFile(file, tempName, fileName, isSaved);
+}
+
+
+// --- BUILDING A BOARD ---
+// Writes a complete board into 'file' from two sorted streams: the runs of the old board
+// ('oldRuns', may be empty) and 'newRuns'. It is built bottom-up in one pass: packed leaves first,
+// then each level of inner pages above them, and the header last. 'totalCount' must be the sum of both.
+// The file stays open: the caller swaps it in (or throws it away) with CommitReplacementFile().
+static bool WriteBoardFile(FILE *file, BoardCursor *oldRuns, const LeaderboardRecord *newRuns,
+                           int newCount, uint32_t totalCount, uint32_t nextSequence) {
+    uint32_t leafCount = (totalCount + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+    if (leafCount == 0) leafCount = 1; // An empty board still has its (empty) root leaf.
+
+    ChildRef *level = malloc(leafCount * sizeof(ChildRef));
+    if (level == NULL) {
+        return false;
+    }
+
+    // Page 0 (the header) is written at the very end: until then the file is not a valid board.
+    StorePage page;
+    memset(&page, 0, sizeof(page));
+    bool isSaved = fwrite(page.bytes, LEADERBOARD_PAGE_SIZE, 1, file) == 1;
+    uint32_t pageCount = 1;
+
+    // 1. The leaves: merge both streams, 145 runs per page.
+    LeaderboardRecord oldRun;
+    bool hasOld = NextBoardRecord(oldRuns, &oldRun);
+    int newIndex = 0;
+    uint32_t written = 0;
+
+    for (uint32_t i = 0; i < leafCount && isSaved; i++) {
+        memset(&page, 0, sizeof(page));
+        page.leaf.isLeaf = 1;
+        page.leaf.next = (i + 1 < leafCount) ? pageCount + 1 : 0;
+
+        while (page.leaf.count < LEAF_CAPACITY && written < totalCount) {
+            LeaderboardRecord *slot = &page.leaf.records[page.leaf.count];
+            if (hasOld && (newIndex >= newCount || CompareRecords(&oldRun, &newRuns[newIndex]) < 0)) {
+                *slot = oldRun;
+                hasOld = NextBoardRecord(oldRuns, &oldRun);
+            } else if (newIndex < newCount) {
+                *slot = newRuns[newIndex++];
+            } else {
+                break; // The old board had fewer runs than its header said.
+            }
+            page.leaf.count++;
+            written++;
+        }
+
+        level[i].key = RecordKey(&page.leaf.records[0]);
+        level[i].page = pageCount++;
+        level[i].count = page.leaf.count;
+        isSaved = fwrite(page.bytes, LEADERBOARD_PAGE_SIZE, 1, file) == 1;
+    }
+
+    // A damaged old board must never replace itself with a shorter one.
+    if (written != totalCount) {
+        isSaved = false;
+    }
+
+    // 2. The inner pages: group 255 children per page until a single page (the root) is left.
+    uint32_t levelCount = leafCount;
+    uint32_t height = 1;
+    while (levelCount > 1 && isSaved) {
+        uint32_t parentCount = (levelCount + NODE_CAPACITY - 1) / NODE_CAPACITY;
+
+        for (uint32_t i = 0; i < parentCount && isSaved; i++) {
+            memset(&page, 0, sizeof(page));
+            uint32_t first = i * NODE_CAPACITY;
+            uint32_t sum = 0;
+
+            for (uint32_t j = first; j < levelCount && j < first + NODE_CAPACITY; j++) {
+                int child = (int)page.node.count++;
+                page.node.keys[child] = level[j].key;
+                page.node.children[child] = level[j].page;
+                page.node.counts[child] = level[j].count;
+                sum += level[j].count;
+            }
+
+            // The parents overwrite the start of the same array: entry 'i' is only written
+            // after children 'first' onwards (always >= i) have been read.
+            level[i].key = page.node.keys[0];
+            level[i].page = pageCount++;
+            level[i].count = sum;
+            isSaved = fwrite(page.bytes, LEADERBOARD_PAGE_SIZE, 1, file) == 1;
+        }
+
+        levelCount = parentCount;
+        height++;
+    }
+
+    // 3. The header, and make sure all of it reached the disk before anyone swaps it in.
+    if (isSaved) {
+        memset(&page, 0, sizeof(page));
+        memcpy(page.header.magic, LEADERBOARD_MAGIC, 4);
+        page.header.version = LEADERBOARD_VERSION;
+        page.header.pageSize = LEADERBOARD_PAGE_SIZE;
+        page.header.rootPage = level[0].page;
+        page.header.pageCount = pageCount;
+        page.header.height = height;
+        page.header.runCount = totalCount;
+        page.header.nextSequence = nextSequence;
+
+        isSaved = fseek(file, 0, SEEK_SET) == 0 &&
+                  fwrite(page.bytes, LEADERBOARD_PAGE_SIZE, 1, file) == 1 &&
+                  fflush(file) == 0 &&
+                  SYNC_FILE(file) == 0;
+    }
+
+    free(level);
+    return isSaved;
+}
+
+
+// --- COMPACTION ---
+// Folds the journal of a level into a new board and starts the journal over.
+static void CompactLevel(int levelID) {
+    char boardName[64];
+    char journalName[64];
+    char tempName[80];
+    GetLeaderboardFileName(levelID, boardName, sizeof(boardName));
+    GetLeaderboardJournalName(levelID, journalName, sizeof(journalName));
+
+    // 1. Take a snapshot: the current board and the journal runs it doesn't have yet.
+    //    Runs added while we work simply stay in the journal for next time.
+    LeaderboardStore old = { 0 };
+    LeaderboardRecord *runs = NULL;
+    int runCount = 0;
+
+    LockCompactor();
+    bool hasBoard = FileExists(boardName);
+    if (hasBoard && !OpenBoardFile(&old, boardName, "rb")) {
+        UnlockCompactor();
+        return; // Never replace a board we can't read.
+    }
+    ReadJournal(journalName, old.header.nextSequence, &runs, &runCount, NULL);
+    UnlockCompactor();
+
+    if (runCount == 0) {
+        CloseLeaderboardStore(&old);
+        return;
+    }
+
+    double startTime = GetTime();
+    qsort(runs, runCount, sizeof(LeaderboardRecord), CompareRecords);
+
+    uint32_t nextSequence = old.header.nextSequence;
+    for (int i = 0; i < runCount; i++) {
+        if (runs[i].sequence >= nextSequence) nextSequence = runs[i].sequence + 1;
+    }
+
+    // 2. The slow part, without the lock: write the whole new board beside the old one.
+    BoardCursor cursor;
+    SeekBoard(&cursor, &old, 0);
+    uint32_t totalCount = old.header.runCount + runCount;
+    FILE *file = OpenReplacementFile(boardName, tempName, sizeof(tempName));
+    bool isBuilt = (file != NULL) && WriteBoardFile(file, &cursor, runs, runCount, totalCount, nextSequence);
+    CloseLeaderboardStore(&old);
+    free(runs);
+
+    if (!isBuilt) {
+        if (file != NULL) CommitReplacementFile(file, tempName, boardName, false); // Deletes it.
+        TraceLog(LOG_WARNING, "LEADERBOARD: Could not compact level %d (its journal is kept)", levelID);
+        return;
+    }
+
+    // 3. Swap it in, then drop the journal runs it now holds (keeping the ones added meanwhile).
+    //    A crash between the two is harmless: on the next open, the new board's 'nextSequence'
+    //    tells which journal runs it already has.
+    LockCompactor();
+    bool isSwapped = CommitReplacementFile(file, tempName, boardName, true);
+    if (isSwapped) {
+        LeaderboardRecord *newer = NULL;
+        int newerCount = 0;
+        ReadJournal(journalName, nextSequence, &newer, &newerCount, NULL);
+        RewriteJournal(journalName, newer, newerCount);
+        free(newer);
+    }
+    UnlockCompactor();
+
+    if (isSwapped) {
+        TraceLog(LOG_INFO, "LEADERBOARD: Compacted level %d: %d journal runs folded in, %u runs in %.0f ms",
+                 levelID, runCount, totalCount, (GetTime() - startTime) * 1000.0);
+    } else {
+        TraceLog(LOG_WARNING, "LEADERBOARD: Could not replace [%s] (its journal is kept)", boardName);
+    }
+}
+
+#if LEADERBOARD_THREADS
+static void *CompactionWorker(void *unused) {
+    (void)unused;
+
+    LockCompactor();
+    while (true) {
+        while (compactor.isRunning && compactor.queueCount == 0) {
+            pthread_cond_wait(&compactor.hasJob, &compactor.lock);
+        }
+        if (!compactor.isRunning) {
+            break;
+        }
+
+        int levelID = compactor.queue[compactor.queueHead];
+        compactor.queueHead = (compactor.queueHead + 1) % COMPACTION_QUEUE_SIZE;
+        compactor.queueCount--;
+        compactor.isBusy = true;
+        compactor.busyLevel = levelID;
+
+        UnlockCompactor();
+        CompactLevel(levelID);
+        LockCompactor();
+
+        compactor.isBusy = false;
+    }
+    UnlockCompactor();
+
+    return NULL;
+}
+#endif
+
+// Hands a level to the background thread (starting it the first time).
+static void QueueCompaction(int levelID) {
+#if LEADERBOARD_THREADS
+    LockCompactor();
+
+    // A level being compacted right now isn't queued again: the runs added meanwhile are few,
+    // and the next run asks again if its journal is still over the threshold.
+    bool isQueued = compactor.isBusy && compactor.busyLevel == levelID;
+    for (int i = 0; i < compactor.queueCount; i++) {
+        if (compactor.queue[(compactor.queueHead + i) % COMPACTION_QUEUE_SIZE] == levelID) {
+            isQueued = true;
+        }
+    }
+
+    // A full queue is fine too: the level asks again on its next run.
+    if (!isQueued && compactor.queueCount < COMPACTION_QUEUE_SIZE) {
+        compactor.queue[(compactor.queueHead + compactor.queueCount) % COMPACTION_QUEUE_SIZE] = levelID;
+        compactor.queueCount++;
+
+        if (!compactor.isRunning) {
+            compactor.isRunning = true;
+            pthread_create(&compactor.worker, NULL, CompactionWorker, NULL);
+        }
+        pthread_cond_signal(&compactor.hasJob);
+    }
+
+    UnlockCompactor();
+#else
+    CompactLevel(levelID);
+#endif
+}
+
+void StopLeaderboardCompaction(void) {
+#if LEADERBOARD_THREADS
+    LockCompactor();
+    if (!compactor.isRunning) {
+        UnlockCompactor();
+        return;
+    }
+    compactor.isRunning = false;
+    compactor.queueCount = 0;
+    pthread_cond_broadcast(&compactor.hasJob);
+    UnlockCompactor();
+
+    pthread_join(compactor.worker, NULL);
 #endif
+}
 
 
-// --- LOAD FUNCTION ---
-// Reads the saved records from a text file when the game starts.
-Leaderboard LoadLeaderboard(const char *filename) {
+// --- OLD TEXT FILES ---
+// Reads the top 10 that older versions of the game saved ("data/times_lvl3.txt").
+static Leaderboard ReadLegacyLeaderboard(int levelID) {
     // We create a local Leaderboard variable and initialize all its memory to 0.
     // { 0 } is a great C trick to ensure no garbage data is left in memory.
     Leaderboard lb = { 0 };
-    
+    lb.firstRank = 1;
+
     // Open the file in "r" (Read) mode.
-    FILE *file = fopen(filename, "r");
-    
-    // If the file exists, we read it. If it doesn't (first time playing), 
-    // we just return the empty leaderboard.
-    if (file != NULL) {
-        // Read the first line: how many records are saved?
-        int expectedCount = 0;
-        if (fscanf(file, "%d", &expectedCount) == 1) {
-            
-            // Safety measure: Never read more than our array can hold.
-            if (expectedCount > MAX_LEADERBOARD) {
-                expectedCount = MAX_LEADERBOARD;
-            }
+    // (snprintf, not TextFormat: this can run on a background thread, and TextFormat's buffers are shared.)
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "data/times_lvl%d.txt", levelID);
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL) return lb;
+
+    // Read the first line: how many records are saved?
+    int expectedCount = 0;
+    if (fscanf(file, "%d", &expectedCount) == 1) {
+        // Safety measure: Never read more than our array can hold.
+        if (expectedCount > MAX_LEADERBOARD) {
+            expectedCount = MAX_LEADERBOARD;
+        }
 
-            int actualValidRecords = 0;
-            
-            // Loop through the file and read each name, time, and vehicle.
-            for (int i = 0; i < expectedCount; i++) {
-                int vType;
-                
-                // We must check that fscanf successfully found exactly 3 items.
-                // We use %15s to prevent buffer overflows if a name in the text file is too long.
-                // If a line in the .txt is corrupted or empty, this prevents "Ghost users".
-                if (fscanf(file, "%15s %f %d", lb.entries[actualValidRecords].name, &lb.entries[actualValidRecords].time, &vType) == 3) {
-                    
-                    lb.entries[actualValidRecords].vehicle = (VehicleType)vType;
-                    actualValidRecords++; // Only increment if the read was 100% successful.
-                }
+        // We use %15s to prevent buffer overflows if a name in the text file is too long.
+        // If a line in the .txt is corrupted or empty, it is skipped (no "Ghost users").
+        for (int i = 0; i < expectedCount; i++) {
+            int vType;
+            if (fscanf(file, "%15s %f %d", lb.entries[lb.count].name, &lb.entries[lb.count].time, &vType) == 3) {
+                lb.entries[lb.count].vehicle = (VehicleType)vType;
+                lb.entries[lb.count].sequence = (uint32_t)lb.count; // The order they get imported in.
+                lb.count++;
             }
-            
-            // Overwrite the count with the number of unbroken records we actually managed to load.
-            lb.count = actualValidRecords;
         }
-        
-        // The Golden Rule of File I/O: Always close the file when done!
-        fclose(file);
     }
-    
-    // Hand the loaded package back to main.c.
+
+    // The Golden Rule of File I/O: Always close the file when done!
+    fclose(file);
+
+    lb.totalCount = lb.count;
     return lb;
 }
 
 
-// --- SAVE FUNCTION ---
-// Writes the current records into a text file so they survive when the game closes.
-void SaveLeaderboard(Leaderboard *lb, const char *filename) {
-    // Create the directory safely before trying to open the file.
-    // If the folder already exists, this function will just silently fail and continue.
+// --- OPEN / CLOSE ---
+void GetLeaderboardFileName(int levelID, char *outName, int outSize) {
+    snprintf(outName, outSize, "data/times_lvl%d.board", levelID);
+}
+
+void GetLeaderboardJournalName(int levelID, char *outName, int outSize) {
+    snprintf(outName, outSize, "data/times_lvl%d.journal", levelID);
+}
+
+void CreateLeaderboardFolder(void) {
     MAKE_DIR("data");
-    
-    // Open the file in "w" (Write) mode. This will create the file if it doesn't exist,
-    // or completely overwrite it if it does.
-    FILE *file = fopen(filename, "w");
-    
-    // Safety check: If the OS denies permission to create the file, we abort.
-    if (file == NULL) return;
+}
+
+// Keeps the journal runs sorted like the board. Returns where 'run' went.
+static int AddPendingRun(LeaderboardStore *store, const LeaderboardRecord *run) {
+    int position = RecordPosition(store->pending, store->pendingCount, RecordKey(run));
 
-    // Write the total number of valid records at the very top.
-    fprintf(file, "%d\n", lb->count);
-    
-    // Loop through our array and write each entry line by line.
-    for (int i = 0; i < lb->count; i++) {
-        fprintf(file, "%s %f %d\n", lb->entries[i].name, lb->entries[i].time, lb->entries[i].vehicle);
+    if (store->pendingCount == store->pendingCapacity) {
+        int newCapacity = (store->pendingCapacity == 0) ? LEADERBOARD_COMPACT_RUNS : store->pendingCapacity * 2;
+        LeaderboardRecord *grown = realloc(store->pending, newCapacity * sizeof(LeaderboardRecord));
+        if (grown == NULL) return position;
+        store->pending = grown;
+        store->pendingCapacity = newCapacity;
     }
-    
-    fclose(file);
+
+    memmove(&store->pending[position + 1], &store->pending[position],
+            (store->pendingCount - position) * sizeof(LeaderboardRecord));
+    store->pending[position] = *run;
+    store->pendingCount++;
+    return position;
 }
 
+// Saves one run to the journal and adds it to the store. Returns how many runs stay ahead of it
+// (-1 if it couldn't be written).
+static int InsertRun(LeaderboardStore *store, const char *name, float time, int vehicle, uint32_t sequence) {
+    LeaderboardRecord record = { 0 };
+    record.time = time;
+    record.sequence = (sequence == LEADERBOARD_NEXT_SEQUENCE) ? store->nextSequence : sequence;
+    record.vehicle = vehicle;
+    SanitizeLeaderboardName(name, record.name);
 
-// --- ADD ENTRY FUNCTION ---
-// Evaluates a new time, finds its proper sorted position (lowest to highest), 
-// shifts the slower times down, and inserts the new record. Multiple identical names are allowed.
-void AddLeaderboardEntry(Leaderboard *lb, const char *name, float time, VehicleType vehicle) {
-    
-    // 1. Filtering worst times.
-    // If the board is full (10 entries) AND this new time is slower (greater) 
-    // than our absolute worst time (the one at index 9), we ignore it completely.
-    if (lb->count == MAX_LEADERBOARD && time >= lb->entries[MAX_LEADERBOARD - 1].time) {
-        return; 
+    char journalName[64];
+    GetLeaderboardJournalName(store->levelID, journalName, sizeof(journalName));
+
+    LockCompactor();
+    bool isSaved = AppendJournal(journalName, &record);
+    UnlockCompactor();
+    if (!isSaved) return -1;
+
+    if (record.sequence >= store->nextSequence) {
+        store->nextSequence = record.sequence + 1;
     }
+    uint32_t boardBefore = BoardCountBefore(store, RecordKey(&record));
+    int pendingBefore = AddPendingRun(store, &record);
+    return (int)boardBefore + pendingBefore;
+}
+
+// Opens the board file (if the level has one yet) and replays the journal on top of it.
+// 'forWriting' also repairs a damaged journal and imports the old top 10 of a brand new level.
+static bool OpenStore(LeaderboardStore *store, int levelID, bool forWriting) {
+    memset(store, 0, sizeof(*store));
+    store->levelID = levelID;
+
+    char boardName[64];
+    char journalName[64];
+    char tempName[80];
+    GetLeaderboardFileName(levelID, boardName, sizeof(boardName));
+    GetLeaderboardJournalName(levelID, journalName, sizeof(journalName));
+    snprintf(tempName, sizeof(tempName), "%s.tmp", boardName);
 
-    // 2. Finding the right spot.
-    // We search from the top (1st place) downwards to find where this new time belongs.
-    int targetIndex = 0;
-    while (targetIndex < lb->count && lb->entries[targetIndex].time < time) {
-        targetIndex++;
+    if (forWriting) {
+        CreateLeaderboardFolder();
     }
 
-    // 3. Shifting losers down.
-    // We must move everyone below 'targetIndex' down by one slot to make room.
-    // We start from the bottom (either the last empty item, or the 9th slot to drop the 10th).
-    int startShiftIndex;
-    if (lb->count < MAX_LEADERBOARD) {
-        startShiftIndex = lb->count;
-    } else {
-        startShiftIndex = MAX_LEADERBOARD - 1;
+    LockCompactor();
+
+    // A finished board waiting beside a missing one: a crash hit between the two steps of a
+    // Windows swap (remove, then rename). It is complete, so it simply takes its place.
+    bool isBeingBuilt = compactor.isBusy && compactor.busyLevel == levelID;
+    if (forWriting && !isBeingBuilt && !FileExists(boardName) && FileExists(tempName)) {
+        LeaderboardStore temp = { 0 };
+        bool isComplete = OpenBoardFile(&temp, tempName, "rb");
+        CloseLeaderboardStore(&temp);
+        if (isComplete) {
+            rename(tempName, boardName);
+        } else {
+            remove(tempName);
+        }
+    }
+
+    bool hasBoard = FileExists(boardName);
+    bool hasJournal = FileExists(journalName);
+    if (hasBoard && !OpenBoardFile(store, boardName, "rb")) {
+        UnlockCompactor();
+        return false;
     }
-    
-    for (int i = startShiftIndex; i > targetIndex; i--) {
-        lb->entries[i] = lb->entries[i - 1]; // Copy the entry above into this slot.
+
+    bool isDamaged = false;
+    ReadJournal(journalName, store->header.nextSequence, &store->pending, &store->pendingCount, &isDamaged);
+    store->pendingCapacity = store->pendingCount;
+
+    // Later runs must not be appended behind a broken record: rewrite the journal without it.
+    if (forWriting && isDamaged) {
+        RewriteJournal(journalName, store->pending, store->pendingCount);
+        TraceLog(LOG_WARNING, "LEADERBOARD: Dropped a damaged record from [%s]", journalName);
     }
 
-    // 4. Data sanitization (Anti-ghost protocol).
-    // We copy the name into a temporary safe string.
-    char safeName[MAX_NAME_LENGTH + 1] = "UNKNOWN"; // Default fallback name.
-    
-    if (name != NULL && strlen(name) > 0) {
-        strncpy(safeName, name, MAX_NAME_LENGTH);
-        safeName[MAX_NAME_LENGTH] = '\0'; // Force the null-terminator.
-        
-        // C's fscanf gets confused by spaces. We must replace spaces with underscores.
-        for (int i = 0; i < strlen(safeName); i++) {
-            if (safeName[i] == ' ') {
-                safeName[i] = '_';
-            }
+    UnlockCompactor();
+
+    if (store->pendingCount > 1) {
+        qsort(store->pending, store->pendingCount, sizeof(LeaderboardRecord), CompareRecords);
+    }
+    store->nextSequence = store->header.nextSequence;
+    for (int i = 0; i < store->pendingCount; i++) {
+        if (store->pending[i].sequence >= store->nextSequence) {
+            store->nextSequence = store->pending[i].sequence + 1;
         }
     }
 
-    // 5. Inserting the champion.
-    // Now that the data is clean, we assign it to the correct spot in the array.
-    strncpy(lb->entries[targetIndex].name, safeName, MAX_NAME_LENGTH + 1);
-    lb->entries[targetIndex].time = time;
-    lb->entries[targetIndex].vehicle = vehicle;
+    // First run on this level: bring the old top 10 over, in its order
+    // (so they get sequences 0 to 9, the same ones ReadLegacyLeaderboard hands out).
+    if (forWriting && !hasBoard && !hasJournal) {
+        Leaderboard legacy = ReadLegacyLeaderboard(levelID);
+        for (int i = 0; i < legacy.count; i++) {
+            InsertRun(store, legacy.entries[i].name, legacy.entries[i].time, legacy.entries[i].vehicle,
+                      legacy.entries[i].sequence);
+        }
+        if (legacy.count > 0) {
+            TraceLog(LOG_INFO, "LEADERBOARD: Imported %d runs from data/times_lvl%d.txt", legacy.count, levelID);
+        }
+    }
 
-    // 6. Update count.
-    // If the board wasn't full yet, we now have one more official entry.
-    if (lb->count < MAX_LEADERBOARD) {
-        lb->count++;
+    // Catch up on a compaction that never happened (the game was closed first).
+    if (forWriting && store->pendingCount >= CompactionThreshold(store)) {
+        QueueCompaction(levelID);
     }
-}
\ No newline at end of file
+
+    return true;
+}
+
+bool OpenLeaderboardStore(LeaderboardStore *store, int levelID) {
+    return OpenStore(store, levelID, true);
+}
+
+void CloseLeaderboardStore(LeaderboardStore *store) {
+    if (store->file != NULL) {
+        fclose(store->file);
+    }
+    free(store->pending);
+    memset(store, 0, sizeof(*store));
+}
+
+
+// --- QUERIES ---
+int AddLeaderboardRun(LeaderboardStore *store, const char *name, float time, VehicleType vehicle, uint32_t sequence) {
+    int rankBefore = InsertRun(store, name, time, vehicle, sequence);
+    if (rankBefore < 0) {
+        TraceLog(LOG_WARNING, "LEADERBOARD: Could not save the run (disk error)");
+        return 0;
+    }
+
+    // Once the journal reaches the threshold, it gets folded into the board.
+    // (A store kept open doesn't see the compactions it asked for, so it asks again every
+    // LEADERBOARD_COMPACT_RUNS runs after that.)
+    int threshold = CompactionThreshold(store);
+    if (store->pendingCount >= threshold && (store->pendingCount - threshold) % LEADERBOARD_COMPACT_RUNS == 0) {
+        QueueCompaction(store->levelID);
+    }
+
+    return rankBefore + 1;
+}
+
+int GetLeaderboardRank(LeaderboardStore *store, float time) {
+    // A new run gets the highest sequence so far, so it goes after every run with the same time.
+    StoreKey key = { time, UINT32_MAX };
+    return (int)BoardCountBefore(store, key) + RecordPosition(store->pending, store->pendingCount, key) + 1;
+}
+
+// Reads the runs of a store in rank order: a merge of the board and the journal runs.
+typedef struct RunMerger {
+    LeaderboardStore *store;
+    BoardCursor cursor;
+    LeaderboardRecord boardRun;     // Next run of the board...
+    bool hasBoard;
+    int pendingIndex;               // ...and of the journal.
+    uint32_t rank;                  // 0-based rank of the next run handed out.
+} RunMerger;
+
+static bool NextMergedRun(RunMerger *merger, LeaderboardRecord *outRun);
+
+// Places the merger on rank 'firstRank' (1 = the fastest). At most 'pendingCount' journal runs can
+// come before it, so the board is read from that many ranks earlier and the merge catches up.
+static void StartMerge(RunMerger *merger, LeaderboardStore *store, int firstRank) {
+    uint32_t wanted = (firstRank > 1) ? (uint32_t)(firstRank - 1) : 0;
+    uint32_t boardStart = (wanted > (uint32_t)store->pendingCount) ? wanted - store->pendingCount : 0;
+
+    merger->store = store;
+    merger->hasBoard = SeekBoard(&merger->cursor, store, boardStart) &&
+                       NextBoardRecord(&merger->cursor, &merger->boardRun);
+
+    // The rank of the first board run read, counting the journal runs ahead of it.
+    merger->pendingIndex = 0;
+    if (merger->hasBoard && boardStart > 0) {
+        merger->pendingIndex = RecordPosition(store->pending, store->pendingCount, RecordKey(&merger->boardRun));
+    }
+    merger->rank = boardStart + merger->pendingIndex;
+
+    LeaderboardRecord skipped;
+    while (merger->rank < wanted && NextMergedRun(merger, &skipped)) { }
+}
+
+static bool NextMergedRun(RunMerger *merger, LeaderboardRecord *outRun) {
+    LeaderboardStore *store = merger->store;
+
+    if (merger->hasBoard && (merger->pendingIndex >= store->pendingCount ||
+                             CompareRecords(&merger->boardRun, &store->pending[merger->pendingIndex]) < 0)) {
+        *outRun = merger->boardRun;
+        merger->hasBoard = NextBoardRecord(&merger->cursor, &merger->boardRun);
+    } else if (merger->pendingIndex < store->pendingCount) {
+        *outRun = store->pending[merger->pendingIndex++];
+    } else {
+        return false;
+    }
+
+    merger->rank++;
+    return true;
+}
+
+Leaderboard ReadLeaderboardPage(LeaderboardStore *store, int firstRank) {
+    Leaderboard lb = { 0 };
+    if (firstRank < 1) firstRank = 1;
+    lb.firstRank = firstRank;
+    lb.totalCount = (int)store->header.runCount + store->pendingCount;
+    if (firstRank > lb.totalCount) return lb;
+
+    RunMerger merger;
+    StartMerge(&merger, store, firstRank);
+
+    LeaderboardRecord run;
+    while (lb.count < MAX_LEADERBOARD && NextMergedRun(&merger, &run)) {
+        LeaderboardEntry *entry = &lb.entries[lb.count++];
+        memcpy(entry->name, run.name, MAX_NAME_LENGTH + 1);
+        entry->time = run.time;
+        entry->vehicle = (VehicleType)run.vehicle;
+        entry->sequence = run.sequence;
+    }
+
+    return lb;
+}
+
+int ReadLeaderboardTimes(LeaderboardStore *store, float *outTimes, int maxCount) {
+    RunMerger merger;
+    StartMerge(&merger, store, 1);
+
+    int count = 0;
+    LeaderboardRecord run;
+    while (count < maxCount && NextMergedRun(&merger, &run)) {
+        outTimes[count++] = run.time;
+    }
+    return count;
+}
+
+bool OpenLeaderboardStoreReadOnly(LeaderboardStore *store, int levelID) {
+    if (OpenStore(store, levelID, false) && (store->file != NULL || store->pendingCount > 0)) {
+        return true;
+    }
+    CloseLeaderboardStore(store);
+    return false;
+}
+
+Leaderboard LoadLeaderboard(int levelID, int firstRank) {
+    // Read-only: looking at a board never creates one.
+    LeaderboardStore store;
+    if (OpenLeaderboardStoreReadOnly(&store, levelID)) {
+        Leaderboard lb = ReadLeaderboardPage(&store, firstRank);
+        CloseLeaderboardStore(&store);
+        return lb;
+    }
+
+    // No board yet: the old top 10 (if any) is all there is, and it only has one page.
+    Leaderboard legacy = ReadLegacyLeaderboard(levelID);
+    if (firstRank <= 1) return legacy;
+
+    Leaderboard empty = { 0 };
+    empty.firstRank = firstRank;
+    empty.totalCount = legacy.totalCount;
+    return empty;
+}
@@ -0,0 +1,397 @@
+// Include standard libraries for memory allocation.
+#include <stdlib.h>
+
+// We include our own header file.
+// level_catalog.h tells us how many level slots there can be.
+#include "leaderboard_cache.h"
+#include "level_catalog.h"
+
+// The web build has no threads: there, every run is written right away on the main thread.
+#if !defined(__EMSCRIPTEN__)
+    #define CACHE_THREADS 1
+    #include <pthread.h>
+#else
+    #define CACHE_THREADS 0
+#endif
+
+
+// --- CONSTANTS ---
+// Runs that can wait for the writer thread at once. A full queue makes the next submission wait.
+#define WRITE_QUEUE_SIZE 64
+
+// Top runs kept with their names: the top 10, plus the 11th (whose replay is deleted when it drops out).
+#define CACHED_TOP_RUNS (MAX_LEADERBOARD + 1)
+
+
+// --- CACHE STATE ---
+// One level's board, as the game sees it.
+typedef struct CachedBoard {
+    bool isLoaded;
+    LeaderboardEntry top[CACHED_TOP_RUNS];      // Ranks 1 to 11.
+    int topCount;
+
+    float *times;                               // Every run, fastest first (4 bytes per run).
+    int count;
+    int capacity;
+
+    uint32_t nextSequence;                      // Id of the next submitted run (the writer stores it under that id).
+} CachedBoard;
+
+// A run waiting for the writer thread.
+typedef struct PendingWrite {
+    int levelID;
+    char name[MAX_NAME_LENGTH + 1];
+    float time;
+    VehicleType vehicle;
+    uint32_t sequence;          // The id the cache gave it (or LEADERBOARD_NEXT_SEQUENCE).
+} PendingWrite;
+
+// 'static' keeps these private to this file. The boards belong to the main thread only;
+// the writer thread only ever touches the queue, which is protected by 'lock'.
+static struct {
+    CachedBoard boards[MAX_CATALOG_LEVELS];     // Slot 0 is level 1, slot 1 is level 2...
+
+    PendingWrite queue[WRITE_QUEUE_SIZE];
+    int queueHead;
+    int queueCount;
+    bool isWriting;                             // The writer thread is saving a run right now.
+
+    bool isRunning;
+#if CACHE_THREADS
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t hasWork;                     // A run was queued (or it is time to quit).
+    pthread_cond_t workDone;                    // A run was saved (a full queue or a flush waits for it).
+#endif
+} cache = { 0 };
+
+
+// --- WRITER THREAD ---
+// Saves one run to its level's board file (one small journal append, see leaderboard.h).
+static void WriteRun(const PendingWrite *run) {
+    LeaderboardStore store;
+    if (!OpenLeaderboardStore(&store, run->levelID)) {
+        TraceLog(LOG_WARNING, "LEADERBOARD: Could not open the board of level %d, a run was not saved", run->levelID);
+        return;
+    }
+    AddLeaderboardRun(&store, run->name, run->time, run->vehicle, run->sequence);
+    CloseLeaderboardStore(&store);
+}
+
+#if CACHE_THREADS
+static void *LeaderboardWriter(void *unused) {
+    (void)unused;
+
+    pthread_mutex_lock(&cache.lock);
+    while (true) {
+        while (cache.isRunning && cache.queueCount == 0) {
+            pthread_cond_wait(&cache.hasWork, &cache.lock);
+        }
+        // Quitting still writes everything that was submitted.
+        if (cache.queueCount == 0) {
+            break;
+        }
+
+        PendingWrite run = cache.queue[cache.queueHead];
+        cache.queueHead = (cache.queueHead + 1) % WRITE_QUEUE_SIZE;
+        cache.queueCount--;
+        cache.isWriting = true;
+
+        // The disk work runs without the lock, so the game can keep queueing.
+        pthread_mutex_unlock(&cache.lock);
+        WriteRun(&run);
+        pthread_mutex_lock(&cache.lock);
+
+        cache.isWriting = false;
+        pthread_cond_broadcast(&cache.workDone);
+    }
+    pthread_mutex_unlock(&cache.lock);
+
+    return NULL;
+}
+#endif
+
+static void QueueWrite(const PendingWrite *run) {
+#if CACHE_THREADS
+    if (cache.isRunning) {
+        pthread_mutex_lock(&cache.lock);
+        while (cache.queueCount == WRITE_QUEUE_SIZE) {
+            pthread_cond_wait(&cache.workDone, &cache.lock);
+        }
+        cache.queue[(cache.queueHead + cache.queueCount) % WRITE_QUEUE_SIZE] = *run;
+        cache.queueCount++;
+        pthread_cond_signal(&cache.hasWork);
+        pthread_mutex_unlock(&cache.lock);
+        return;
+    }
+#endif
+    WriteRun(run);
+}
+
+void FlushLeaderboardWrites(void) {
+#if CACHE_THREADS
+    if (!cache.isRunning) {
+        return;
+    }
+    pthread_mutex_lock(&cache.lock);
+    while (cache.queueCount > 0 || cache.isWriting) {
+        pthread_cond_wait(&cache.workDone, &cache.lock);
+    }
+    pthread_mutex_unlock(&cache.lock);
+#endif
+}
+
+
+// --- LOADING ---
+// Makes room for one more time in a board.
+static bool GrowTimes(CachedBoard *board, int needed) {
+    if (needed <= board->capacity) {
+        return true;
+    }
+
+    int newCapacity = (board->capacity == 0) ? 64 : board->capacity;
+    while (newCapacity < needed) {
+        newCapacity *= 2;
+    }
+
+    float *grown = realloc(board->times, newCapacity * sizeof(float));
+    if (grown == NULL) {
+        return false;
+    }
+    board->times = grown;
+    board->capacity = newCapacity;
+    return true;
+}
+
+// Reads one level's board from the disk into its slot.
+static void LoadCachedBoard(int levelID, CachedBoard *board) {
+    *board = (CachedBoard){ 0 };
+    board->isLoaded = true;
+
+    LeaderboardStore store;
+    if (OpenLeaderboardStoreReadOnly(&store, levelID)) {
+        Leaderboard first = ReadLeaderboardPage(&store, 1);
+        Leaderboard next = ReadLeaderboardPage(&store, MAX_LEADERBOARD + 1);
+
+        for (int i = 0; i < first.count; i++) {
+            board->top[board->topCount++] = first.entries[i];
+        }
+        if (next.count > 0) {
+            board->top[board->topCount++] = next.entries[0];
+        }
+
+        if (GrowTimes(board, first.totalCount)) {
+            board->count = ReadLeaderboardTimes(&store, board->times, first.totalCount);
+        }
+        board->nextSequence = store.nextSequence;
+        CloseLeaderboardStore(&store);
+        return;
+    }
+
+    // No board yet: the old top 10 text file (if any) is the whole board. The writer thread
+    // imports it into the board file the first time a run is saved on this level.
+    Leaderboard legacy = LoadLeaderboard(levelID, 1);
+    if (GrowTimes(board, legacy.count)) {
+        for (int i = 0; i < legacy.count; i++) {
+            board->top[board->topCount++] = legacy.entries[i];
+            board->times[board->count++] = legacy.entries[i].time;
+        }
+    }
+    board->nextSequence = (uint32_t)legacy.count; // The import gives them sequences 0 to count - 1.
+}
+
+// The cached board of a level (read now if it wasn't yet), or NULL outside the level grid.
+static CachedBoard *GetCachedBoard(int levelID) {
+    if (levelID < 1 || levelID > MAX_CATALOG_LEVELS) {
+        return NULL;
+    }
+
+    CachedBoard *board = &cache.boards[levelID - 1];
+    if (!board->isLoaded) {
+        LoadCachedBoard(levelID, board);
+    }
+    return board;
+}
+
+void LoadLeaderboardCache(int levelCount) {
+    double startTime = GetTime();
+    int runCount = 0;
+
+    if (levelCount > MAX_CATALOG_LEVELS) {
+        levelCount = MAX_CATALOG_LEVELS;
+    }
+    for (int levelID = 1; levelID <= levelCount; levelID++) {
+        runCount += GetCachedBoard(levelID)->count;
+    }
+
+    TraceLog(LOG_INFO, "LEADERBOARD: Cached %d levels (%d runs) in %.1f ms",
+             levelCount, runCount, (GetTime() - startTime) * 1000.0);
+
+#if CACHE_THREADS
+    if (!cache.isRunning) {
+        cache.isRunning = true;
+        pthread_mutex_init(&cache.lock, NULL);
+        pthread_cond_init(&cache.hasWork, NULL);
+        pthread_cond_init(&cache.workDone, NULL);
+        pthread_create(&cache.writer, NULL, LeaderboardWriter, NULL);
+    }
+#endif
+}
+
+void UnloadLeaderboardCache(void) {
+#if CACHE_THREADS
+    if (cache.isRunning) {
+        // The writer empties the queue before it quits: nothing submitted is ever lost on a normal exit.
+        pthread_mutex_lock(&cache.lock);
+        cache.isRunning = false;
+        pthread_cond_broadcast(&cache.hasWork);
+        pthread_mutex_unlock(&cache.lock);
+
+        pthread_join(cache.writer, NULL);
+
+        pthread_cond_destroy(&cache.workDone);
+        pthread_cond_destroy(&cache.hasWork);
+        pthread_mutex_destroy(&cache.lock);
+    }
+#endif
+
+    for (int i = 0; i < MAX_CATALOG_LEVELS; i++) {
+        free(cache.boards[i].times);
+        cache.boards[i] = (CachedBoard){ 0 };
+    }
+}
+
+
+// --- LOOKUPS ---
+// How many runs of a board are as fast as 'time' or faster (binary search).
+// On equal times the earlier run ranks higher, so a new run goes after all of them.
+static int CountAtOrBelow(const CachedBoard *board, float time) {
+    int low = 0;
+    int high = board->count;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (board->times[middle] <= time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+int SubmitLeaderboardRun(int levelID, const char *name, float time, VehicleType vehicle) {
+    PendingWrite run = { 0 };
+    run.levelID = levelID;
+    SanitizeLeaderboardName(name, run.name);
+    run.time = time;
+    run.vehicle = vehicle;
+
+    // Read the level's board BEFORE queueing the run, or the writer could save it first and the
+    // cache would count it twice.
+    CachedBoard *board = GetCachedBoard(levelID);
+
+    // The board file stores the run under the id it gets here, the one its replay and ghost are named after.
+    run.sequence = (board != NULL) ? board->nextSequence : LEADERBOARD_NEXT_SEQUENCE;
+
+    // The replay and ghost of the run are saved right after this, before the writer thread has
+    // created the 'data' folder, so it must exist now.
+    CreateLeaderboardFolder();
+    QueueWrite(&run);
+
+    if (board == NULL) {
+        return 0;
+    }
+
+    // Every run gets the next id, whatever its rank, just like in the board file.
+    // 1. The times: shift the slower ones one slot to the right and drop it in.
+    int position = CountAtOrBelow(board, time);
+    if (GrowTimes(board, board->count + 1)) {
+        memmove(&board->times[position + 1], &board->times[position], (board->count - position) * sizeof(float));
+        board->times[position] = time;
+        board->count++;
+    }
+
+    // 2. The top runs: same thing, if it is fast enough to be one of them.
+    if (position < CACHED_TOP_RUNS) {
+        int last = (board->topCount < CACHED_TOP_RUNS) ? board->topCount : CACHED_TOP_RUNS - 1;
+        for (int i = last; i > position; i--) {
+            board->top[i] = board->top[i - 1];
+        }
+
+        LeaderboardEntry *entry = &board->top[position];
+        memcpy(entry->name, run.name, sizeof(entry->name));
+        entry->time = time;
+        entry->vehicle = vehicle;
+        entry->sequence = board->nextSequence;
+
+        if (board->topCount < CACHED_TOP_RUNS) {
+            board->topCount++;
+        }
+    }
+    board->nextSequence++;
+
+    return position + 1;
+}
+
+Leaderboard GetCachedLeaderboard(int levelID) {
+    Leaderboard lb = { 0 };
+    lb.firstRank = 1;
+
+    CachedBoard *board = GetCachedBoard(levelID);
+    if (board == NULL) {
+        return lb;
+    }
+
+    lb.count = (board->topCount < MAX_LEADERBOARD) ? board->topCount : MAX_LEADERBOARD;
+    memcpy(lb.entries, board->top, lb.count * sizeof(LeaderboardEntry));
+    lb.totalCount = board->count;
+    return lb;
+}
+
+Leaderboard GetLeaderboardPage(int levelID, int firstRank) {
+    if (firstRank <= 1) {
+        return GetCachedLeaderboard(levelID);
+    }
+
+    FlushLeaderboardWrites();
+    return LoadLeaderboard(levelID, firstRank);
+}
+
+bool GetCachedRun(int levelID, int rank, LeaderboardEntry *outEntry) {
+    CachedBoard *board = GetCachedBoard(levelID);
+    if (board == NULL || rank < 1 || rank > board->topCount) {
+        return false;
+    }
+
+    *outEntry = board->top[rank - 1];
+    return true;
+}
+
+int GetCachedRank(int levelID, float time) {
+    CachedBoard *board = GetCachedBoard(levelID);
+    if (board == NULL) {
+        return 1;
+    }
+    return CountAtOrBelow(board, time) + 1;
+}
+
+LeaderboardTarget GetLeaderboardTarget(int levelID, float raceTime) {
+    LeaderboardTarget target = { 0 };
+
+    CachedBoard *board = GetCachedBoard(levelID);
+    if (board == NULL) {
+        return target;
+    }
+
+    // Finishing now would put the player right in front of the first run slower than 'raceTime'.
+    int ahead = CountAtOrBelow(board, raceTime);
+    if (ahead >= board->count) {
+        return target;
+    }
+
+    target.hasTarget = true;
+    target.rank = ahead + 1;
+    target.time = board->times[ahead];
+    target.delta = raceTime - target.time;
+    return target;
+}
@@ -0,0 +1,214 @@
+// Include standard libraries for file input/output, memory and strings.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// File sizes and modification times.
+#include <sys/stat.h>
+
+// We include our own header file.
+// mapped_file.h has the checksum, the file mapping and the temporary-file swap (shared with the model cache).
+#include "level_binary.h"
+#include "mapped_file.h"
+
+
+// --- SOURCE STAMP ---
+// The size and last modification time of the text file. If either one changes, the binary is stale.
+static bool GetSourceStamp(const char *sourceFile, int64_t *outSize, int64_t *outModTime) {
+    struct stat info;
+    if (stat(sourceFile, &info) != 0) {
+        return false;
+    }
+
+    *outSize = (int64_t)info.st_size;
+    *outModTime = (int64_t)info.st_mtime;
+    return true;
+}
+
+
+// --- CHECKSUM ---
+static uint64_t ChecksumLevel(const LevelBinaryHeader *header, const unsigned char *payload) {
+    // The checksum can't include itself, so it is counted as 0.
+    LevelBinaryHeader copy;
+    memcpy(&copy, header, sizeof(copy));
+    copy.checksum = 0;
+
+    uint64_t hash = ChecksumBytes(CHECKSUM_SEED, (const unsigned char *)&copy, sizeof(copy));
+    return ChecksumBytes(hash, payload, (size_t)header->payloadSize);
+}
+
+
+// --- VALIDATION ---
+// Returns why the mapped file can't be used, or NULL if it is good.
+static const char *CheckLevelBinary(const unsigned char *data, size_t fileSize, int64_t sourceSize, int64_t sourceModTime) {
+    if (fileSize < LEVEL_BINARY_PAYLOAD_OFFSET) {
+        return "too short";
+    }
+
+    const LevelBinaryHeader *header = (const LevelBinaryHeader *)data;
+
+    if (memcmp(header->magic, LEVEL_BINARY_MAGIC, 4) != 0) {
+        return "not a compiled level";
+    }
+    if (header->version != LEVEL_BINARY_VERSION || header->headerSize != sizeof(LevelBinaryHeader) ||
+        header->ringSize != sizeof(Ring)) {
+        return "compiled by another version";
+    }
+    if (header->sourceSize != sourceSize || header->sourceModTime != sourceModTime) {
+        return "older than the text file";
+    }
+
+    // The ring arrays must be exactly as big as the ring count says, and fill the rest of the file.
+    if (header->ringCapacity < 0 || header->totalRings < 0 || header->totalRings > header->ringCapacity) {
+        return "damaged";
+    }
+    uint64_t expectedPayload = (header->ringCapacity > 0) ? GetRaceRingsSize(header->ringCapacity) : 0;
+    if (header->payloadSize != expectedPayload || LEVEL_BINARY_PAYLOAD_OFFSET + header->payloadSize != fileSize) {
+        return "damaged";
+    }
+
+    if (ChecksumLevel(header, data + LEVEL_BINARY_PAYLOAD_OFFSET) != header->checksum) {
+        return "checksum mismatch";
+    }
+
+    return NULL;
+}
+
+
+// --- WRITER (LEVEL COMPILER) ---
+bool WriteLevelBinary(const RaceSystem *race, const char *sourceFile, const char *binaryFile) {
+    LevelBinaryHeader header;
+    memset(&header, 0, sizeof(header)); // Also zeroes the padding bytes, so the checksum is repeatable.
+
+    if (!GetSourceStamp(sourceFile, &header.sourceSize, &header.sourceModTime)) {
+        return false;
+    }
+
+    // 1. Fill the header.
+    memcpy(header.magic, LEVEL_BINARY_MAGIC, 4);
+    header.version = LEVEL_BINARY_VERSION;
+    header.headerSize = sizeof(LevelBinaryHeader);
+    header.ringSize = sizeof(Ring);
+
+    header.missionType = race->missionType;
+    header.startPos = race->startPos;
+    header.startYaw = race->startYaw;
+
+    // The ring arrays are the whole ring arena, already filled by LoadRaceText() (transforms and
+    // collision data included), so the game has nothing left to calculate when it maps them.
+    const unsigned char *payload = race->ringArena.base;
+    if (payload != NULL) {
+        header.ringCapacity = race->declaredRings;
+        header.totalRings = race->totalRings;
+        header.payloadSize = GetRaceRingsSize(race->declaredRings);
+    }
+
+    header.landingZone = race->landingZone;
+    header.landingRadius = race->landingRadius;
+    header.maxLandingSpeed = race->maxLandingSpeed;
+    header.padMoveType = race->padMoveType;
+    header.padOrigin = race->padOrigin;
+    header.padVelocity = race->padVelocity;
+    header.padAccel = race->padAccel;
+    header.currentPadSpeed = race->currentPadSpeed;
+    header.currentPadAngle = race->currentPadAngle;
+    header.padRadius = race->padRadius;
+
+    header.checksum = ChecksumLevel(&header, payload);
+
+    // 2. Write header, alignment padding and arrays into a temporary file and swap it in with
+    //    one rename, so nobody ever maps a half-written level.
+    char tempFile[256];
+    FILE *file = OpenReplacementFile(binaryFile, tempFile, sizeof(tempFile));
+    if (file == NULL) {
+        return false;
+    }
+
+    static const unsigned char zeros[16] = { 0 };
+    size_t padding = LEVEL_BINARY_PAYLOAD_OFFSET - sizeof(header);
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(zeros, 1, padding, file) == padding &&
+                   (header.payloadSize == 0 || fwrite(payload, (size_t)header.payloadSize, 1, file) == 1);
+    return CommitReplacementFile(file, tempFile, binaryFile, written);
+}
+
+
+// --- LOADER (GAME AND TOOLS) ---
+bool LoadLevelBinary(const char *binaryFile, const char *sourceFile, RaceSystem *race) {
+    // The text file is the real level: without it, the binary means nothing.
+    int64_t sourceSize = 0;
+    int64_t sourceModTime = 0;
+    if (!GetSourceStamp(sourceFile, &sourceSize, &sourceModTime)) {
+        return false;
+    }
+
+    // No compiled level is perfectly normal (it is optional), so that case stays silent.
+    size_t fileSize = 0;
+
+    // The mapping is private and writable: the game flips 'Ring.active' while flying, and those
+    // writes only change our copy of the touched pages, never the file on disk.
+    unsigned char *data = MapFile(binaryFile, &fileSize, true);
+    if (data == NULL) {
+        return false;
+    }
+
+    const char *problem = CheckLevelBinary(data, fileSize, sourceSize, sourceModTime);
+    if (problem != NULL) {
+        TraceLog(LOG_INFO, "RACE: Ignoring [%s] (%s), parsing [%s] instead", binaryFile, problem, sourceFile);
+        UnmapFile(data, fileSize);
+        return false;
+    }
+
+    // Copy the few header values into a fresh mission...
+    const LevelBinaryHeader *header = (const LevelBinaryHeader *)data;
+    RaceSystem loaded = { 0 };
+
+    loaded.missionType = header->missionType;
+    loaded.startPos = header->startPos;
+    loaded.startYaw = header->startYaw;
+
+    loaded.landingZone = header->landingZone;
+    loaded.landingRadius = header->landingRadius;
+    loaded.maxLandingSpeed = header->maxLandingSpeed;
+    loaded.padMoveType = header->padMoveType;
+    loaded.padOrigin = header->padOrigin;
+    loaded.padVelocity = header->padVelocity;
+    loaded.padAccel = header->padAccel;
+    loaded.currentPadSpeed = header->currentPadSpeed;
+    loaded.currentPadAngle = header->currentPadAngle;
+    loaded.padRadius = header->padRadius;
+
+    // ...and point the ring arrays straight at the mapped file (the size was checked above, so they fit).
+    if (header->ringCapacity > 0) {
+        MemoryArena view = { 0 };
+        view.base = data + LEVEL_BINARY_PAYLOAD_OFFSET;
+        view.capacity = (size_t)header->payloadSize;
+
+        CarveRaceRings(&loaded, &view, header->ringCapacity);
+        loaded.declaredRings = header->ringCapacity;
+        loaded.totalRings = header->totalRings;
+
+        // The broadphase grid lives in its own arena (see BuildRingGrid), so it is still built here:
+        // one quick pass over the mapped ring frames.
+        if (!BuildRingGrid(&loaded)) {
+            TraceLog(LOG_WARNING, "RACE: Not enough memory for the ring grid of [%s]", binaryFile);
+        }
+    }
+
+    loaded.levelMapping = data;
+    loaded.levelMappingSize = fileSize;
+
+    *race = loaded;
+    return true;
+}
+
+
+// --- CLEANUP ---
+void UnloadLevelBinary(RaceSystem *race) {
+    if (race->levelMapping != NULL) {
+        UnmapFile(race->levelMapping, race->levelMappingSize);
+    }
+    race->levelMapping = NULL;
+    race->levelMappingSize = 0;
+}
@@ -0,0 +1,86 @@
+// Include stdio library to use file input/output operations.
+#include <stdio.h>
+
+// Include string library to use string manipulation functions.
+#include <string.h>
+
+// We include our own header file.
+#include "level_catalog.h"
+
+
+// --- HEADER READER ---
+// Reads the title, mission type, spawn point and ring count at the top of one level file.
+// Same format that InitRace() parses, but it stops before the ring list.
+static void ReadLevelHeader(const char *filename, LevelInfo *info) {
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) {
+        return;
+    }
+
+    // 1. The title. 'fgets' keeps the invisible 'newline' character, so we cut it off with 'strcspn'.
+    if (fgets(info->name, sizeof(info->name), file) != NULL) {
+        info->name[strcspn(info->name, "\r\n")] = 0;
+    } else {
+        strcpy(info->name, "UNKNOWN");
+    }
+
+    // 2. Mission type and spawn point.
+    fscanf(file, "%d", &info->missionType);
+    fscanf(file, "%f %f %f %f", &info->startPos.x, &info->startPos.y, &info->startPos.z, &info->startYaw);
+
+    // 3. Ring races declare their ring count right after the spawn point.
+    if (info->missionType == 0) {
+        if (fscanf(file, "%d", &info->ringCount) != 1 || info->ringCount < 0) {
+            info->ringCount = 0;
+        }
+    }
+
+    fclose(file);
+    info->exists = true;
+}
+
+
+// --- FACTORY FUNCTION ---
+LevelCatalog ScanLevelCatalog(const char *directory) {
+    LevelCatalog catalog = { 0 };
+
+    // 1. Ask the OS for the directory listing ONCE, instead of guessing filenames until one is missing.
+    FilePathList files = LoadDirectoryFiles(directory);
+
+    for (unsigned int i = 0; i < files.count; i++) {
+        // Only files called exactly 'lvl<number>.txt' are levels.
+        const char *fileName = GetFileName(files.paths[i]);
+        int levelID = 0;
+        int nameLength = 0;
+
+        if (sscanf(fileName, "lvl%d.txt%n", &levelID, &nameLength) != 1 || fileName[nameLength] != '\0') {
+            continue;
+        }
+        if (levelID < 1 || levelID > MAX_CATALOG_LEVELS) {
+            continue;
+        }
+
+        LevelInfo *info = &catalog.levels[levelID - 1];
+        ReadLevelHeader(files.paths[i], info);
+        info->modifiedTime = GetFileModTime(files.paths[i]);
+    }
+
+    UnloadDirectoryFiles(files);
+
+    // 2. The playable levels are the unbroken run from level 1 (a gap ends the list, as before).
+    while (catalog.count < MAX_CATALOG_LEVELS && catalog.levels[catalog.count].exists) {
+        catalog.count++;
+    }
+
+    TraceLog(LOG_INFO, "LEVELS: Found %d playable levels in [%s]", catalog.count, directory);
+    return catalog;
+}
+
+
+// --- LOOKUP ---
+const LevelInfo *GetLevelInfo(const LevelCatalog *catalog, int levelID) {
+    if (levelID < 1 || levelID > MAX_CATALOG_LEVELS) {
+        return NULL;
+    }
+    return &catalog->levels[levelID - 1];
+}
@@ -0,0 +1,236 @@
+// Include standard libraries for printing and strings.
+#include <stdio.h>
+#include <string.h>
+
+// We include our own header file.
+#include "level_watcher.h"
+
+// inotify (file change notifications) only exists on Linux.
+#if defined(__linux__)
+
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+
+// --- CONSTANTS ---
+// How often (milliseconds) the thread wakes up to see if the game wants it to stop.
+#define WATCHER_POLL_MS 250
+
+
+// --- WATCHER STATE ---
+// 'static' keeps these private to this file. Everything the two threads share is protected by 'lock'.
+static struct {
+    bool isRunning;            // False tells the thread to finish.
+    pthread_t thread;
+    int inotifyFd;             // The OS channel that reports file changes.
+    char directory[128];
+
+    pthread_mutex_t lock;
+    int watchedLevel;          // The level the game is playing (0 = none).
+    bool hasReload;            // True if 'reloaded' holds a fresh race nobody has taken yet.
+    RaceSystem reloaded;       // The mailbox.
+} watcher = { 0 };
+
+
+// --- BACKGROUND THREAD ---
+
+// Parses the watched level and drops it in the mailbox (replacing one that was never picked up).
+static void ReloadLevel(int levelID) {
+    char fileName[192];
+    snprintf(fileName, sizeof(fileName), "%s/lvl%d.txt", watcher.directory, levelID);
+
+    // The slow part (reading and parsing) happens here, outside the lock.
+    RaceSystem race = LoadRaceText(fileName);
+    TraceLog(LOG_INFO, "LEVELS: Reloaded [%s] (%d rings)", fileName, race.totalRings);
+
+    pthread_mutex_lock(&watcher.lock);
+    if (levelID != watcher.watchedLevel) {
+        // The player moved to another level while we were parsing: nobody wants this one.
+        pthread_mutex_unlock(&watcher.lock);
+        UnloadRace(&race);
+        return;
+    }
+
+    RaceSystem stale = watcher.hasReload ? watcher.reloaded : (RaceSystem){ 0 };
+    watcher.reloaded = race;
+    watcher.hasReload = true;
+    pthread_mutex_unlock(&watcher.lock);
+
+    UnloadRace(&stale);
+}
+
+static void *WatcherThread(void *unused) {
+    (void)unused;
+
+    // Room for several events at once. inotify events are aligned like this struct.
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    while (true) {
+        pthread_mutex_lock(&watcher.lock);
+        bool isRunning = watcher.isRunning;
+        int watchedLevel = watcher.watchedLevel;
+        pthread_mutex_unlock(&watcher.lock);
+
+        if (!isRunning) {
+            break;
+        }
+
+        // Sleep until the OS reports something (or the timeout lets us check 'isRunning' again).
+        struct pollfd request = { watcher.inotifyFd, POLLIN, 0 };
+        if (poll(&request, 1, WATCHER_POLL_MS) <= 0) {
+            continue;
+        }
+
+        ssize_t length = read(watcher.inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            continue;
+        }
+
+        // Editors often save the same file several times in a row (or in steps),
+        // so one batch of events only triggers one reload.
+        bool watchedChanged = false;
+
+        for (char *p = buffer; p < buffer + length; ) {
+            const struct inotify_event *event = (const struct inotify_event *)p;
+            p += sizeof(struct inotify_event) + event->len;
+
+            // Only files called exactly 'lvl<number>.txt' are levels.
+            int levelID = 0;
+            int nameLength = 0;
+            if (event->len == 0 ||
+                sscanf(event->name, "lvl%d.txt%n", &levelID, &nameLength) != 1 || event->name[nameLength] != '\0') {
+                continue;
+            }
+
+            if (levelID == watchedLevel) {
+                watchedChanged = true;
+            }
+        }
+
+        if (watchedChanged) {
+            ReloadLevel(watchedLevel);
+        }
+    }
+
+    return NULL;
+}
+
+
+// --- PUBLIC FUNCTIONS ---
+
+bool StartLevelWatcher(const char *directory) {
+    if (watcher.isRunning) {
+        return true;
+    }
+
+    watcher.inotifyFd = inotify_init1(IN_CLOEXEC);
+    if (watcher.inotifyFd < 0) {
+        return false;
+    }
+
+    // IN_CLOSE_WRITE: a file was saved in place. IN_MOVED_TO: an editor saved into a temporary
+    // file and renamed it over the level (the usual "safe save").
+    if (inotify_add_watch(watcher.inotifyFd, directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(watcher.inotifyFd);
+        return false;
+    }
+
+    snprintf(watcher.directory, sizeof(watcher.directory), "%s", directory);
+    pthread_mutex_init(&watcher.lock, NULL);
+    watcher.watchedLevel = 0;
+    watcher.hasReload = false;
+    watcher.isRunning = true;
+
+    if (pthread_create(&watcher.thread, NULL, WatcherThread, NULL) != 0) {
+        watcher.isRunning = false;
+        pthread_mutex_destroy(&watcher.lock);
+        close(watcher.inotifyFd);
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "LEVELS: Watching [%s] for changes", directory);
+    return true;
+}
+
+void WatchLevel(int levelID) {
+    if (!watcher.isRunning) {
+        return;
+    }
+
+    pthread_mutex_lock(&watcher.lock);
+    watcher.watchedLevel = levelID;
+
+    // A reload of the previous level is no use anymore.
+    RaceSystem stale = { 0 };
+    if (watcher.hasReload) {
+        stale = watcher.reloaded;
+        watcher.hasReload = false;
+    }
+    pthread_mutex_unlock(&watcher.lock);
+
+    UnloadRace(&stale);
+}
+
+bool PollLevelReload(RaceSystem *outRace) {
+    if (!watcher.isRunning) {
+        return false;
+    }
+
+    // Called every frame, so it only holds the lock long enough to move a struct.
+    pthread_mutex_lock(&watcher.lock);
+    bool hasReload = watcher.hasReload;
+    if (hasReload) {
+        *outRace = watcher.reloaded;
+        watcher.reloaded = (RaceSystem){ 0 };
+        watcher.hasReload = false;
+    }
+    pthread_mutex_unlock(&watcher.lock);
+
+    return hasReload;
+}
+
+void StopLevelWatcher(void) {
+    if (!watcher.isRunning) {
+        return;
+    }
+
+    pthread_mutex_lock(&watcher.lock);
+    watcher.isRunning = false;
+    pthread_mutex_unlock(&watcher.lock);
+
+    // The thread notices within WATCHER_POLL_MS (or after the reload it is doing).
+    pthread_join(watcher.thread, NULL);
+    close(watcher.inotifyFd);
+
+    if (watcher.hasReload) {
+        UnloadRace(&watcher.reloaded);
+    }
+    pthread_mutex_destroy(&watcher.lock);
+    watcher.hasReload = false;
+}
+
+#else
+
+// --- OTHER SYSTEMS ---
+// No inotify: the watcher is never available, and levels are only read when they are picked.
+
+bool StartLevelWatcher(const char *directory) {
+    (void)directory;
+    return false;
+}
+
+void WatchLevel(int levelID) {
+    (void)levelID;
+}
+
+bool PollLevelReload(RaceSystem *outRace) {
+    (void)outRace;
+    return false;
+}
+
+void StopLevelWatcher(void) {
+}
+
+#endif
@@ -4,6 +4,9 @@
 // Include stdio library to use file input/output operations.
 #include <stdio.h>
 
+// Include stdlib library to read numbers from the command line.
+#include <stdlib.h>
+
 // Include string library to use string manipulation functions.
 #include <string.h>
 
@@ -19,9 +22,20 @@
 // Notice we use quotes "" for our own files, and angle brackets <> for system libraries.
 #include "player.h"
 #include "resource_manager.h"
+#include "asset_manager.h"
 #include "race.h"
+#include "race_draw.h"
 #include "leaderboard.h"
+#include "leaderboard_cache.h"
 #include "ui.h"
+#include "terrain.h"
+#include "sim.h"
+#include "camera.h"
+#include "replay.h"
+#include "ghost.h"
+#include "particles.h"
+#include "level_watcher.h"
+#include "profiler.h"
 
 
 // --- GAME STATES (STATE MACHINE) ---
@@ -34,13 +48,186 @@ typedef enum GameState {
     STATE_VEHICLE_SELECT,
     STATE_PLAYING,
     STATE_NAME_INPUT,
-    STATE_LEADERBOARD
+    STATE_LEADERBOARD,
+    STATE_LOADING         // Waits for the files of the next state (at startup, or before a flight).
 } GameState;
 
 
+// --- INPUT ADAPTER ---
+// Reads the keyboard and the gamepad ONCE per frame and packs them into a PilotInput.
+// This is the only place that translates physical keys into flight controls;
+// the simulation core (SimStep) just receives the finished package.
+//
+// One value per axis means the sources are mixed here, not in the physics. Compared with the
+// old per-source code in UpdatePlayer() this plays slightly differently:
+// - Keyboard + triggers ramp the throttle as fast as one of them (it used to be twice as fast).
+// - A moved left stick replaces the keys on its axis (turn rate and climb used to add up).
+// - A and D held together cancel out, roll included (D used to win the roll, at -0.4).
+// - The helicopter descends at 2x acceleration with the stick too (the stick used to give 3x).
+static PilotInput ReadPilotInput(void) {
+    PilotInput input = { 0 };
+
+    // Keyboard: every key is a full +1.0f / -1.0f on its axis.
+    if (IsKeyDown(KEY_W))          input.throttle += 1.0f;
+    if (IsKeyDown(KEY_S))          input.throttle -= 1.0f;
+    if (IsKeyDown(KEY_A))          input.yaw += 1.0f;
+    if (IsKeyDown(KEY_D))          input.yaw -= 1.0f;
+    if (IsKeyDown(KEY_SPACE))      input.pitch += 1.0f;
+    if (IsKeyDown(KEY_LEFT_SHIFT)) input.pitch -= 1.0f;
+
+    if (IsGamepadAvailable(0)) {
+        // Triggers: RT to accelerate, LT to brake/reverse.
+        if (IsGamepadButtonDown(0, GAMEPAD_BUTTON_RIGHT_TRIGGER_2)) input.throttle += 1.0f;
+        if (IsGamepadButtonDown(0, GAMEPAD_BUTTON_LEFT_TRIGGER_2))  input.throttle -= 1.0f;
+
+        // Left stick. Deadzone check: we ignore inputs smaller than 0.15f to prevent stick drift.
+        // In aviation, pulling the stick BACK (positive Y) raises the nose.
+        float leftX = GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_X);
+        float leftY = GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_Y);
+        if (fabsf(leftX) > 0.15f) input.yaw = -leftX;
+        if (fabsf(leftY) > 0.15f) input.pitch = leftY;
+    }
+
+    // Keep every axis inside the -1.0f to +1.0f range (keyboard + gamepad at once).
+    input.throttle = Clamp(input.throttle, -1.0f, 1.0f);
+    input.yaw      = Clamp(input.yaw, -1.0f, 1.0f);
+    input.pitch    = Clamp(input.pitch, -1.0f, 1.0f);
+
+    return input;
+}
+
+
+// --- GHOST LOADER ---
+// Opens the ghost of the BEST run (1st place) of the level, if it has one.
+static GhostPlayback OpenBestGhost(int levelID) {
+    LeaderboardEntry best;
+    if (!GetCachedRun(levelID, 1, &best)) {
+        return (GhostPlayback){ 0 };
+    }
+
+    char ghostFile[64];
+    GetGhostFileName(levelID, best.sequence, ghostFile, sizeof(ghostFile));
+    return OpenGhost(ghostFile);
+}
+
+
+// Whether the run 'runID' is one of the top 10 of a level (its replay and ghost must stay).
+static bool IsTopTenRun(int levelID, uint32_t runID) {
+    LeaderboardEntry entry;
+    for (int rank = 1; rank <= MAX_LEADERBOARD; rank++) {
+        if (GetCachedRun(levelID, rank, &entry) && entry.sequence == runID) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// --- AIRCRAFT DRAWING ---
+// Draws the plane or the helicopter model with the given pose.
+// Used for both the player and the ghost of the best run.
+static void DrawAircraft(VehicleType type, Vector3 position, Vector3 rotation, Color tint) {
+    Model *currentModel;
+    if (type == VEHICLE_PLANE) {
+        currentModel = &planeModel;
+    } else {
+        currentModel = &helicopterModel;
+    }
+    
+    Matrix baseTransform = currentModel->transform;
+    Matrix matRoll  = MatrixRotateZ(rotation.z);
+    Matrix matPitch = MatrixRotateX(rotation.x);
+    Matrix matYaw   = MatrixRotateY(rotation.y);
+    Matrix dynamicRotation = MatrixMultiply(MatrixMultiply(matRoll, matPitch), matYaw);
+    
+    currentModel->transform = MatrixMultiply(baseTransform, dynamicRotation);
+    if (type == VEHICLE_PLANE) {
+        DrawModel(*currentModel, position, 0.08f, tint); 
+    } else if (type == VEHICLE_HELICOPTER) {
+        DrawModel(*currentModel, position, 0.8f, tint);
+    }
+    currentModel->transform = baseTransform;
+}
+
+
+// --- ASSET RESIDENCY ---
+// Adds 'id' to the list unless it is already there.
+static void AddStateAsset(AssetID *ids, int *count, AssetID id) {
+    for (int i = 0; i < *count; i++) {
+        if (ids[i] == id) return;
+    }
+    ids[(*count)++] = id;
+}
+
+// Lists the files 'state' uses (room for ASSET_COUNT). Returns how many there are.
+// A flight only needs the aircraft it flies (and the one of the ghost), and each screen only its own music.
+static int GetStateAssets(GameState state, VehicleType vehicle, const GhostPlayback *ghost, AssetID *ids) {
+    int count = 0;
+
+    switch (state) {
+        case STATE_MENU:
+        case STATE_LEVEL_SELECT:
+        case STATE_VEHICLE_SELECT:
+            AddStateAsset(ids, &count, ASSET_MENU_MUSIC);
+            break;
+
+        case STATE_PLAYING:
+            AddStateAsset(ids, &count, ASSET_TERRAIN);
+            AddStateAsset(ids, &count, ASSET_SKYBOX);
+            AddStateAsset(ids, &count, ASSET_RING);
+            AddStateAsset(ids, &count, (vehicle == VEHICLE_PLANE) ? ASSET_PLANE_MODEL : ASSET_HELICOPTER_MODEL);
+            AddStateAsset(ids, &count, (vehicle == VEHICLE_PLANE) ? ASSET_PLANE_SOUND : ASSET_HELICOPTER_SOUND);
+            if (ghost->isActive) {
+                AddStateAsset(ids, &count, (ghost->previous.vehicle == VEHICLE_PLANE) ? ASSET_PLANE_MODEL : ASSET_HELICOPTER_MODEL);
+                AddStateAsset(ids, &count, (ghost->next.vehicle == VEHICLE_PLANE) ? ASSET_PLANE_MODEL : ASSET_HELICOPTER_MODEL);
+            }
+            break;
+
+        case STATE_NAME_INPUT:
+        case STATE_LEADERBOARD:
+            AddStateAsset(ids, &count, ASSET_ENDING_MUSIC);
+            break;
+
+        case STATE_LOADING:
+            break; // The caller asks for the state being loaded instead.
+    }
+
+    return count;
+}
+
+// Acquires the files of the list that aren't held yet, and releases the held ones it no longer has.
+static void HoldStateAssets(bool held[ASSET_COUNT], const AssetID *ids, int count) {
+    bool wanted[ASSET_COUNT] = { false };
+    for (int i = 0; i < count; i++) {
+        wanted[ids[i]] = true;
+    }
+
+    for (int id = 0; id < ASSET_COUNT; id++) {
+        if (wanted[id] && !held[id]) AcquireAsset((AssetID)id);
+        if (!wanted[id] && held[id]) ReleaseAsset((AssetID)id);
+        held[id] = wanted[id];
+    }
+}
+
+
 // -- MAIN FUNCTION --
-int main(void) {
+// 'argc' and 'argv' hold the command line options (e.g. "game --bench-terrain").
+int main(int argc, char *argv[]) {
     // --- 1. INITIALIZATION (SETUP) ---
+
+    // Read the command line options before opening anything.
+    bool benchTerrain = false;
+    bool validateHeightfield = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench-terrain") == 0) benchTerrain = true;
+        if (strcmp(argv[i], "--validate-heightfield") == 0) validateHeightfield = true;
+        if (strcmp(argv[i], "--exact-ground") == 0) terrainExactGround = true;
+
+        // "--asset-budget 32": keep at most 32 MB of unused files in memory.
+        if (strcmp(argv[i], "--asset-budget") == 0 && i + 1 < argc) {
+            SetAssetMemoryBudget((size_t)(atof(argv[++i]) * 1024.0 * 1024.0));
+        }
+    }
     
     // Allow the user to resize the window.
     SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_VSYNC_HINT);
@@ -81,11 +268,32 @@ int main(void) {
     // Disable default ESC behavior
     SetExitKey(KEY_NULL);
 
-    // Call our custom module to load heavy files into RAM.
+    // Call our custom module to start loading the heavy files in the background.
     LoadGameResources(); 
 
-    // Set the initial game state to show the menu first.
-    GameState currentState = STATE_MENU;
+    // Benchmark/validation modes: measure the terrain and quit without starting the game.
+    // The window must stay open because Raylib needs it to load the models.
+    if (benchTerrain || validateHeightfield) {
+        FinishAssetLoading(); // These need the terrain right now, so wait for it.
+        if (benchTerrain) BenchmarkTerrainRaycasts(environmentModel, 2000);
+        if (validateHeightfield) ValidateTerrainHeightfield(100000);
+
+        UnloadGameResources();
+        CloseAudioDevice();
+        CloseWindow();
+        return 0;
+    }
+
+    // Set the initial game state to show the menu first (after its music has loaded).
+    // The flight files keep loading in the background while the player looks at the menus.
+    GameState currentState = STATE_LOADING;
+    GameState loadingNextState = STATE_MENU;
+
+    // The files the current screen holds (see ASSET RESIDENCY below).
+    bool heldAssets[ASSET_COUNT] = { false };
+
+    // True once the player has picked an aircraft: the next pick is probably the same one.
+    bool hasPickedVehicle = false;
     
     // Create an empty player. It will be properly initialized when the user selects a vehicle.
     Player player = { 0 };
@@ -105,34 +313,52 @@ int main(void) {
     // so we can tell the Track Designer which layout to build.
     int currentLevel = 1;
     
-    // Instead of a hardcoded constant, we probe the 'data' folder 
-    // to see how many level files actually exist in sequential order.
-    int MAX_LEVELS = 0;
-    while (true) {
-        // Guess the next filename.
-        const char *testFilename = TextFormat("levels/lvl%d.txt", MAX_LEVELS + 1);
-        
-        // Try to open it.
-        FILE *testFile = fopen(testFilename, "r");
-        
-        if (testFile != NULL) {
-            // The file exists! Close it immediately and increase our count.
-            fclose(testFile);
-            MAX_LEVELS++;
-        } else {
-            // The file doesn't exist. We have reached the end of the available levels.
-            break; 
-        }
-    }
+    // Instead of a hardcoded constant, we list the 'levels' folder ONCE and read every level's header.
+    // The menus only read from this catalog, so they never open a file while they are on screen.
+    LevelCatalog levelCatalog = ScanLevelCatalog("levels");
+    int MAX_LEVELS = levelCatalog.count;
+
+    // Same idea for the leaderboards: every level's board is read once, here, so the HUD can show
+    // the time to beat while flying without ever waiting for the hard drive.
+    LoadLeaderboardCache(levelCatalog.count);
 
     // Initialize the Race System (The track and the referee) using the default level.
-    RaceSystem race = InitRace(currentLevel);
+    // 'raceTemplate' is the level exactly as loaded, and is never flown: every start and every
+    // quick restart copies it into 'race' (RestoreRace), so restarting never touches the disk.
+    // It is only loaded again when a different level is picked.
+    RaceSystem raceTemplate = InitRace(currentLevel);
+    int templateLevel = currentLevel;
+    RaceSystem race = { 0 };
+    RestoreRace(&race, &raceTemplate);
+
+    // Level designers can edit the level file while flying it: a background thread re-parses it
+    // and the game swaps it in (see the LEVEL HOT-RELOAD step of the main loop). Linux only.
+    StartLevelWatcher("levels");
+    WatchLevel(templateLevel);
+
+    // Fixed timestep state.
+    // 'simAccumulator' stores the real time that hasn't been simulated yet.
+    // 'simAlpha' tells the renderer how far we are between the last two ticks (0.0f to 1.0f).
+    float simAccumulator = 0.0f;
+    float simAlpha = 0.0f;
+
+    // Input recorder. Every simulation tick of the current flight is captured here,
+    // and saved beside the leaderboard if the run makes it onto the board.
+    ReplayRecorder recorder = { 0 };
+
+    // Ghost of the best run: one recorder for the current flight, one stream for the best one.
+    GhostRecorder ghostRecorder = { 0 };
+    GhostPlayback ghost = { 0 };
+
+    // Smoke puffs of the plane: lose 2% of their life and rise 0.02 units per 60 Hz frame.
+    ParticleSystem smoke = CreateParticleSystem(PARTICLE_CAPACITY, 0.02f, 0.02f);
 
     
     // Leaderboard & text input setup.
     // We leave the leaderboard struct empty for now. 
     // It will be dynamically loaded when the player finishes a specific level.
     Leaderboard leaderboard = { 0 };
+    int playerRank = 0;     // Where the last submitted run landed (1 = the fastest ever).
 
     char playerName[MAX_NAME_LENGTH + 1] = "\0"; 
     int letterCount = 0;                         
@@ -164,6 +390,9 @@ int main(void) {
     // --- 2. THE MAIN GAME LOOP ---
     // This loop runs 60 times per second until the user clicks the X or presses ESC.
     while (!WindowShouldClose()) {
+        // The whole frame is one block in the profiler; every phase below is nested inside it.
+        PROFILE_BEGIN(frameScope, "Frame");
+
         // --- 0) GLOBAL BACK / EXIT LOGIC ---
         // We handle the ESC key (Keyboard) and the View/Back button (Gamepad).
         if (IsKeyPressed(KEY_ESCAPE) || 
@@ -171,7 +400,8 @@ int main(void) {
             if (currentState == STATE_PLAYING || 
                 currentState == STATE_VEHICLE_SELECT || 
                 currentState == STATE_NAME_INPUT || 
-                currentState == STATE_LEADERBOARD) 
+                currentState == STATE_LEADERBOARD ||
+               (currentState == STATE_LOADING && loadingNextState == STATE_PLAYING)) 
             {
                 // If flying or choosing vehicle, abort the mission and return to Level Select.
                 currentState = STATE_LEVEL_SELECT;
@@ -181,11 +411,28 @@ int main(void) {
                 StopSound(helicopterSound);
             } else if (currentState == STATE_MENU || currentState == STATE_LEVEL_SELECT) {
                 // If in any other menu, close the game completely.
+                // Close the frame's event first, or the trace would keep an unfinished "Frame".
+                PROFILE_END(frameScope);
                 break; 
             }
         }
 
 
+        // --- LEVEL HOT-RELOAD ---
+        // The level being played was saved, and the watcher thread has already parsed it.
+        // No tick is running at this point, so the new rings (or landing pad) are swapped in
+        // between two ticks, and the player keeps flying from where they are.
+        RaceSystem reloadedRace = { 0 };
+        if (PollLevelReload(&reloadedRace)) {
+            UnloadRace(&raceTemplate);
+            raceTemplate = reloadedRace;
+            if (currentState == STATE_PLAYING ||
+               (currentState == STATE_LOADING && loadingNextState == STATE_PLAYING)) {
+                HotSwapRace(&race, &raceTemplate);
+            }
+        }
+
+
         // --- A) UPDATE PHASE ---
         if (currentState == STATE_MENU) {
             UpdateMusicStream(menuMusic);
@@ -313,52 +560,144 @@ int main(void) {
             if (!IsMusicStreamPlaying(menuMusic)) {
                 PlayMusicStream(menuMusic);
             }
+
+            // While the player chooses, load the aircraft they will most likely pick:
+            // the one they flew last, or the one the mission is made for (the helicopter lands on pads).
+            VehicleType likelyVehicle = player.type;
+            if (!hasPickedVehicle) {
+                const LevelInfo *info = GetLevelInfo(&levelCatalog, currentLevel);
+                likelyVehicle = (info != NULL && info->missionType == 1) ? VEHICLE_HELICOPTER : VEHICLE_PLANE;
+            }
+            PrefetchAsset((likelyVehicle == VEHICLE_PLANE) ? ASSET_PLANE_MODEL : ASSET_HELICOPTER_MODEL);
+            PrefetchAsset((likelyVehicle == VEHICLE_PLANE) ? ASSET_PLANE_SOUND : ASSET_HELICOPTER_SOUND);
             
             if (IsKeyPressed(KEY_ONE) || 
                (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT))) {
                 StopMusicStream(menuMusic);
-                race = InitRace(currentLevel);
+                if (templateLevel != currentLevel) {                            // A different level: load it once.
+                    UnloadRace(&raceTemplate);
+                    raceTemplate = InitRace(currentLevel);
+                    templateLevel = currentLevel;
+                    WatchLevel(templateLevel);
+                }
+                RestoreRace(&race, &raceTemplate);
                 player = InitPlayer(VEHICLE_PLANE, race.startPos, race.startYaw);
-                currentState = STATE_PLAYING;       
+                BeginReplayRecording(&recorder, currentLevel, player.type);
+                BeginGhostRecording(&ghostRecorder, &player);
+                ClearParticles(&smoke);
+                CloseGhost(&ghost);
+                ghost = OpenBestGhost(currentLevel);
+                simAccumulator = 0.0f;
+                hasPickedVehicle = true;
+                currentState = STATE_LOADING;           // Goes straight on if the aircraft is already loaded.
+                loadingNextState = STATE_PLAYING;
             } 
             else if (IsKeyPressed(KEY_TWO) || 
                     (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_UP))) {
                 StopMusicStream(menuMusic);      
-                race = InitRace(currentLevel);
+                if (templateLevel != currentLevel) {                            // A different level: load it once.
+                    UnloadRace(&raceTemplate);
+                    raceTemplate = InitRace(currentLevel);
+                    templateLevel = currentLevel;
+                    WatchLevel(templateLevel);
+                }
+                RestoreRace(&race, &raceTemplate);
                 player = InitPlayer(VEHICLE_HELICOPTER, race.startPos, race.startYaw);
-                currentState = STATE_PLAYING;            
+                BeginReplayRecording(&recorder, currentLevel, player.type);
+                BeginGhostRecording(&ghostRecorder, &player);
+                ClearParticles(&smoke);
+                CloseGhost(&ghost);
+                ghost = OpenBestGhost(currentLevel);
+                simAccumulator = 0.0f;
+                hasPickedVehicle = true;
+                currentState = STATE_LOADING;           // Goes straight on if the aircraft is already loaded.
+                loadingNextState = STATE_PLAYING;
             }
             
         } else if (currentState == STATE_PLAYING) {
             // Mid-flight vehicle switching.
+            VehicleType switchedType = player.type;
             if (IsKeyPressed(KEY_ONE) || 
                (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT))) {
-                player.type = VEHICLE_PLANE;
+                switchedType = VEHICLE_PLANE;
             }
             if (IsKeyPressed(KEY_TWO) || 
                (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_UP))) {
-                player.type = VEHICLE_HELICOPTER;
+                switchedType = VEHICLE_HELICOPTER;
+            }
+
+            // Only the flown aircraft is held during a flight, so the other one may not be loaded yet:
+            // the flight waits on the loading screen (frozen, the race timer too) until its model and
+            // sound are in. Goes straight on, without a single loading frame, if they already are.
+            if (switchedType != player.type) {
+                player.type = switchedType;
+                StopSound(planeSound);
+                StopSound(helicopterSound);
+                currentState = STATE_LOADING;
+                loadingNextState = STATE_PLAYING;
             }
 
             // Quick restart.
             // If the player makes a mistake, press R to restart the race instantly.
             if (IsKeyPressed(KEY_R) || 
                (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT))) {
-                race = InitRace(currentLevel);                                  // Pass the current level.
+                RestoreRace(&race, &raceTemplate);                              // Flat copy of the level as loaded (no disk access).
                 player = InitPlayer(player.type, race.startPos, race.startYaw); // Teleports player back to origin.
+                BeginReplayRecording(&recorder, currentLevel, player.type);     // Throw away the old recording.
+                BeginGhostRecording(&ghostRecorder, &player);
+                ClearParticles(&smoke);
+                RewindGhost(&ghost);                                            // Rewind the ghost to the start.
+                simAccumulator = 0.0f;
             }
 
-            // Upate the vehicle's physics.
-            // Notice the '&' (address-of operator). We are passing a POINTER to our player
-            // so the UpdatePlayer function can modify the real data, not a copy.
-            UpdatePlayer(&player);
+            // --- FIXED TIMESTEP ---
+            // The physics always advance in steps of exactly SIM_DT seconds (120 ticks per second).
+            // We collect the real frame time and run as many ticks as fit inside it.
+            // At 60 FPS that's 2 ticks per frame, at 240 FPS it's 1 tick every 2 frames.
+            simAccumulator += GetFrameTime();
+
+            // Safety cap: after a long freeze (loading, dragging the window...) we don't want
+            // to simulate hundreds of ticks at once and freeze again ("spiral of death").
+            if (simAccumulator > 0.25f) simAccumulator = 0.25f;
+
+            // Sample the controls once per frame; every tick of this frame uses the same input.
+            // The input is rounded to the replay precision, so a replay reproduces this flight exactly.
+            PROFILE_BEGIN(inputScope, "Input");
+            PilotInput pilotInput = QuantizePilotInput(ReadPilotInput());
+            PROFILE_END(inputScope);
+
+            while (simAccumulator >= SIM_DT) {
+                // Advance the vehicle's physics and the race logic (stopwatch and ring collisions).
+                // Notice the '&' (address-of operator). We are passing POINTERS
+                // so the simulation can modify the real data, not a copy.
+                // Record the tick while the mission is still being decided.
+                bool isRecording = !race.isFinished && !race.missionFailed;
+                if (isRecording) {
+                    RecordReplayTick(&recorder, &pilotInput, player.type);
+                }
+
+                SimStep(&player, &race, &pilotInput, SIM_DT);
 
-            // Update the race logic (Stopwatch and ring collisions).
-            // We pass pointers to both the race and the player so the referee can check distances.
-            UpdateRace(&race, &player);
+                if (isRecording) {
+                    RecordGhostTick(&ghostRecorder, &player);
+                }
+
+                // The smoke is purely visual, so it is updated outside the simulation core.
+                UpdateSmokeTrails(&player, &smoke, SIM_DT);
+
+                simAccumulator -= SIM_DT;
+            }
+
+            // Leftover time that didn't fill a whole tick, used to blend the last two poses.
+            simAlpha = simAccumulator / SIM_DT;
+
+            // Stream the ghost up to the current race time (a few keyframes at most per frame).
+            UpdateGhost(&ghost, race.timer);
 
             // Update the camera (1st/3rd person logic and orbital math).
-            UpdateDynamicCamera(&camera, &player);
+            PROFILE_SCOPE("UpdateDynamicCamera") {
+                UpdateDynamicCamera(&camera, &player, simAlpha);
+            }
 
             // Dynamic audio logic.
             // We only play engine sounds if the vehicle is still intact!
@@ -419,6 +758,18 @@ int main(void) {
                (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_MIDDLE_RIGHT))) {
                 showControls = !showControls;
             }
+
+#if defined(GABRIEL_PROFILER)
+            // Profiling builds only: 'F9' saves the last frames as a Chrome trace (open it in ui.perfetto.dev).
+            if (IsKeyPressed(KEY_F9)) {
+                int eventCount = ExportProfileTrace("frame_trace.json");
+                if (eventCount >= 0) {
+                    TraceLog(LOG_INFO, "PROFILER: Saved %d events to frame_trace.json", eventCount);
+                } else {
+                    TraceLog(LOG_WARNING, "PROFILER: Could not write frame_trace.json");
+                }
+            }
+#endif
         
         } else if (currentState == STATE_NAME_INPUT) {
             UpdateMusicStream(endingMusic);
@@ -539,15 +890,37 @@ int main(void) {
             // Submit name and save (ENTER or START).
             if ((IsKeyPressed(KEY_ENTER) || 
                (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_MIDDLE_RIGHT))) && letterCount > 0) {
-                // 1. Generate a dynamic filename based on the level just played.
-                const char *filename = TextFormat("data/times_lvl%d.txt", currentLevel);
-                
-                // 2. Load, update, and save the specific leaderboard.
-                leaderboard = LoadLeaderboard(filename);
-                AddLeaderboardEntry(&leaderboard, playerName, race.timer, player.type);
-                SaveLeaderboard(&leaderboard, filename);
-                
-                // 3. Proceed to the viewing screen.
+                // 1. Add the run to the level's board. Every run is kept, whatever its rank.
+                //    The cache answers right away; the file is written in the background.
+                playerRank = SubmitLeaderboardRun(currentLevel, playerName, race.timer, player.type);
+
+                // Only the top 10 keep their replay and ghost.
+                // The run that just got pushed from 10th to 11th loses its files.
+                // Files are named by each run's unique id, so equal times never share (or delete) one.
+                LeaderboardEntry newRun;
+                bool madeTheBoard = (playerRank >= 1 && playerRank <= MAX_LEADERBOARD) &&
+                                    GetCachedRun(currentLevel, playerRank, &newRun);
+                char replayFile[64];
+                LeaderboardEntry dropped;
+
+                if (madeTheBoard && GetCachedRun(currentLevel, MAX_LEADERBOARD + 1, &dropped) &&
+                    !IsTopTenRun(currentLevel, dropped.sequence)) {
+                    GetReplayFileName(currentLevel, dropped.sequence, replayFile, sizeof(replayFile));
+                    remove(replayFile);
+                    GetGhostFileName(currentLevel, dropped.sequence, replayFile, sizeof(replayFile));
+                    remove(replayFile);
+                }
+
+                // The 'data' folder exists now (SubmitLeaderboardRun creates it), so the replay can go right beside it.
+                if (madeTheBoard) {
+                    GetReplayFileName(currentLevel, newRun.sequence, replayFile, sizeof(replayFile));
+                    SaveReplay(&recorder, replayFile, race.timer);
+                    GetGhostFileName(currentLevel, newRun.sequence, replayFile, sizeof(replayFile));
+                    SaveGhost(&ghostRecorder, replayFile);
+                }
+
+                // 2. Show the top 10 and proceed to the viewing screen.
+                leaderboard = GetCachedLeaderboard(currentLevel);
                 currentState = STATE_LEADERBOARD;
             }
             
@@ -557,6 +930,22 @@ int main(void) {
                 PlayMusicStream(endingMusic);
             }
 
+            // UP/DOWN (or the D-pad) flip through the board, 10 ranks at a time.
+            int pageStep = 0;
+            if (IsKeyPressed(KEY_DOWN) ||
+               (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_FACE_DOWN))) {
+                pageStep = MAX_LEADERBOARD;
+            }
+            if (IsKeyPressed(KEY_UP) ||
+               (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_FACE_UP))) {
+                pageStep = -MAX_LEADERBOARD;
+            }
+
+            int nextFirstRank = leaderboard.firstRank + pageStep;
+            if (pageStep != 0 && nextFirstRank >= 1 && nextFirstRank <= leaderboard.totalCount) {
+                leaderboard = GetLeaderboardPage(currentLevel, nextFirstRank);
+            }
+
             // Wait strictly for ENTER (Keyboard) or 'B' (Gamepad) to return to the main menu.
             if (IsKeyPressed(KEY_ENTER) ||
                (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT))) {
@@ -564,6 +953,21 @@ int main(void) {
             }
         }
 
+
+        // --- ASSET RESIDENCY ---
+        // Hold the files of the current screen (or of the one being loaded) and let go of the rest.
+        // Then finish the files the worker threads have read, and free unused ones over the budget.
+        AssetID stateAssets[ASSET_COUNT];
+        GameState assetState = (currentState == STATE_LOADING) ? loadingNextState : currentState;
+        int stateAssetCount = GetStateAssets(assetState, player.type, &ghost, stateAssets);
+        HoldStateAssets(heldAssets, stateAssets, stateAssetCount);
+        UpdateAssetManager();
+
+        float loadingProgress = GetAssetLoadingProgress(stateAssets, stateAssetCount);
+        if (currentState == STATE_LOADING && loadingProgress >= 1.0f) {
+            currentState = loadingNextState;
+        }
+
         
         // --- B) DRAW PHASE (RENDERING) ---
         // Now that all the math is done, we paint the results onto the screen.
@@ -587,79 +991,71 @@ int main(void) {
                 break;
                 
             case STATE_LEVEL_SELECT:
-                DrawLevelSelectScreen(currentLevel, MAX_LEVELS, screenWidth, screenHeight);
+                DrawLevelSelectScreen(&levelCatalog, currentLevel, screenWidth, screenHeight);
                 break;
                 
             case STATE_VEHICLE_SELECT:
                 DrawVehicleSelectScreen(screenWidth, screenHeight);
                 break;
                 
-            case STATE_PLAYING:
+            case STATE_PLAYING: {
+                // The physics run at a fixed tick rate, so we draw a copy of the player
+                // interpolated between the last two ticks. This keeps the motion smooth at any FPS.
+                Player renderPlayer = GetInterpolatedPlayer(&player, simAlpha);
+
                 // --- 3D WORLD RENDERING ---
                 // Switch Raylib into 3D rendering mode using our camera.
                 BeginMode3D(camera);
                     // 1. Draw the skybox exactly where the camera is. 
-                    DrawModel(skyboxModel, camera.position, 3.0f, WHITE);
+                    PROFILE_SCOPE("Skybox") {
+                        DrawModel(skyboxModel, camera.position, 3.0f, WHITE);
+                    }
 
                     // 2. Infinite green grid trick.
-                    DrawPlane((Vector3){ player.position.x, 0.0f, player.position.z }, (Vector2){ 10000.0f, 10000.0f }, DARKGREEN);
-
-                    float spacing = 50.0f; 
-                    int slices = 60;       
-
-                    float snapX = (int)(player.position.x / spacing) * spacing;
-                    float snapZ = (int)(player.position.z / spacing) * spacing;
-
-                    for (int i = -slices; i <= slices; i++) {
-                        float offset = i * spacing;
-                        float extent = slices * spacing;
-                        
-                        DrawLine3D((Vector3){ snapX + offset, 0.05f, snapZ - extent }, (Vector3){ snapX + offset, 0.05f, snapZ + extent }, LIME);
-                        DrawLine3D((Vector3){ snapX - extent, 0.05f, snapZ + offset }, (Vector3){ snapX + extent, 0.05f, snapZ + offset }, LIME);
+                    // One quad under the player; the shader paints the grid lines in world space,
+                    // so they stay still on the ground while the quad follows us around.
+                    PROFILE_SCOPE("Grid") {
+                        SetShaderValue(groundShader, groundShader.locs[SHADER_LOC_VECTOR_VIEW], &camera.position, SHADER_UNIFORM_VEC3);
+                        DrawModel(groundModel, (Vector3){ renderPlayer.position.x, 0.0f, renderPlayer.position.z }, 1.0f, WHITE);
                     }
 
                     // 3. Draw the floating 3D rings/helipads and the navigation arrow for the race.
-                    DrawRace3D(&race, &player);
+                    PROFILE_SCOPE("DrawRace3D") {
+                        DrawRace3D(&race, &renderPlayer);
+                    }
 
-                    // 4. Draw the physical aircraft if we are in 3rd person (orbit) view.
-                    if (!player.isFirstPerson) {
-                        Model *currentModel;
-                        if (player.type == VEHICLE_PLANE) {
-                            currentModel = &planeModel;
-                        } else {
-                            currentModel = &helicopterModel;
+                    PROFILE_SCOPE("Models") {
+                        // 4. Draw the physical aircraft if we are in 3rd person (orbit) view.
+                        if (!renderPlayer.isFirstPerson) {
+                            DrawAircraft(renderPlayer.type, renderPlayer.position, renderPlayer.rotation, WHITE);
                         }
-                        
-                        Matrix baseTransform = currentModel->transform;
-                        Matrix matRoll  = MatrixRotateZ(player.rotation.z);
-                        Matrix matPitch = MatrixRotateX(player.rotation.x);
-                        Matrix matYaw   = MatrixRotateY(player.rotation.y);
-                        Matrix dynamicRotation = MatrixMultiply(MatrixMultiply(matRoll, matPitch), matYaw);
-                        
-                        currentModel->transform = MatrixMultiply(baseTransform, dynamicRotation);
-                        if (player.type == VEHICLE_PLANE) {
-                            DrawModel(*currentModel, player.position, 0.08f, WHITE); 
-                        } else if (player.type == VEHICLE_HELICOPTER) {
-                            DrawModel(*currentModel, player.position, 0.8f, WHITE);
+
+                        // 4b. Draw the translucent ghost of the best run (drawn after the solid models).
+                        if (ghost.isActive) {
+                            float ghostTime = race.timer;
+                            if (race.isRaceActive) ghostTime += simAlpha * SIM_DT; // Smooth, like the player.
+
+                            GhostKeyframe ghostPose = GetGhostPose(&ghost, ghostTime);
+                            DrawAircraft(ghostPose.vehicle, ghostPose.position, ghostPose.rotation, Fade(SKYBLUE, 0.4f));
                         }
-                        currentModel->transform = baseTransform;
                     }
 
-                    // 5. Draw smoke particles.
-                    for (int i = 0; i < MAX_PARTICLES; i++) {
-                        if (player.smoke[i].active) {
-                            Color smokeColor = Fade(WHITE, player.smoke[i].life * 0.6f);
-                            float size = 0.1f + ((1.0f - player.smoke[i].life) * 0.7f);
-                            DrawSphere(player.smoke[i].position, size, smokeColor);
-                        }
+                    // 5. Draw smoke particles (all of them in one instanced draw call).
+                    PROFILE_SCOPE("Particles") {
+                        DrawParticles(&smoke);
                     }
                     
                 EndMode3D(); // Switch back to 2D rendering mode.
 
                 // --- 2D HUD RENDERING ---
                 // Call our unified HUD drawer from the UI module!
-                DrawHUD(&player, &race, showControls, screenWidth, screenHeight);
+                // The run to beat comes straight from the leaderboard cache (no file access).
+                PROFILE_SCOPE("HUD") {
+                    LeaderboardTarget target = GetLeaderboardTarget(currentLevel, race.timer);
+                    DrawHUD(&player, &race, &target, showControls, screenWidth, screenHeight);
+                }
                 break;
+            }
                 
             case STATE_NAME_INPUT:
                 // Pass the current virtual key character (using the index).
@@ -667,17 +1063,35 @@ int main(void) {
                 break;
                 
             case STATE_LEADERBOARD:
-                DrawLeaderboardScreen(&leaderboard, screenWidth, screenHeight);
+                DrawLeaderboardScreen(&leaderboard, playerRank, screenWidth, screenHeight);
+                break;
+
+            case STATE_LOADING:
+                DrawLoadingScreen(loadingProgress, screenWidth, screenHeight);
                 break;
         }
 
-        EndDrawing(); // Tell Raylib we are done painting this frame, display it!
+        // Presenting the frame includes waiting for the GPU and the vsync, so it gets its own block.
+        PROFILE_SCOPE("Present") {
+            EndDrawing(); // Tell Raylib we are done painting this frame, display it!
+        }
+        PROFILE_END(frameScope);
     }
 
 
     // --- 3. TEARDOWN (CLEANUP) ---
     // The loop is over (User closed the game). Time to clean up.
     UnloadGameResources(); // Our custom function to free RAM.
+    StopLevelWatcher();    // Stop the level watcher thread before freeing the races.
+    UnloadLeaderboardCache();    // Write the runs still waiting before the compaction thread stops.
+    StopLeaderboardCompaction(); // Let a board being rebuilt in the background finish.
+    UnloadRace(&race);
+    UnloadRace(&raceTemplate);
+    UnloadReplayRecorder(&recorder);
+    UnloadGhostRecorder(&ghostRecorder);
+    UnloadParticleSystem(&smoke);
+    CloseGhost(&ghost);
+    UnloadTextCache();     // The cached HUD text lives in GPU textures.
     CloseAudioDevice();    // Close audio device after unloading resources.
     CloseWindow();         // Raylib's function to close the OS window safely.
     return 0;              // Tell Windows the program finished successfully.
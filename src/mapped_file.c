@@ -0,0 +1,116 @@
+// Include standard libraries for memory allocation and strings.
+#include <stdlib.h>
+#include <string.h>
+
+// Memory-mapped files are a POSIX feature (Linux, macOS and the web build).
+// Windows gets a plain read of the whole file instead: still no parsing, just one copy.
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+// We include our own header file.
+#include "mapped_file.h"
+
+
+// --- CHECKSUM ---
+uint64_t ChecksumBytes(uint64_t hash, const unsigned char *data, size_t size) {
+    size_t words = size / 8;
+
+    for (size_t i = 0; i < words; i++) {
+        uint64_t word;
+        memcpy(&word, data + (i * 8), 8);
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (size_t i = words * 8; i < size; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+
+// --- FILE MAPPING ---
+unsigned char *MapFile(const char *fileName, size_t *outSize, bool isWritable) {
+#ifndef _WIN32
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+
+    // MAP_PRIVATE: even a writable mapping never writes back to the file.
+    int protection = isWritable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void *data = mmap(NULL, (size_t)info.st_size, protection, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the file is closed.
+
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+
+    *outSize = (size_t)info.st_size;
+    return (unsigned char *)data;
+#else
+    (void)isWritable; // Our own copy in RAM is always writable.
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char *data = (size > 0) ? (unsigned char *)malloc((size_t)size) : NULL;
+    if (data == NULL || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    *outSize = (size_t)size;
+    return data;
+#endif
+}
+
+void UnmapFile(void *data, size_t size) {
+#ifndef _WIN32
+    munmap(data, size);
+#else
+    (void)size;
+    free(data);
+#endif
+}
+
+
+// --- REPLACING FILES ---
+FILE *OpenReplacementFile(const char *fileName, char *outTempName, int tempNameSize) {
+    snprintf(outTempName, tempNameSize, "%s.tmp", fileName);
+    return fopen(outTempName, "wb");
+}
+
+bool CommitReplacementFile(FILE *file, const char *tempName, const char *fileName, bool isWritten) {
+    isWritten = (fclose(file) == 0) && isWritten;
+    if (!isWritten) {
+        remove(tempName);
+        return false;
+    }
+
+#ifdef _WIN32
+    remove(fileName); // Windows won't rename over an existing file.
+#endif
+    if (rename(tempName, fileName) != 0) {
+        remove(tempName);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,422 @@
+// Include standard libraries for file input/output, memory and strings.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// We include our own header file.
+// raymath.h applies the fixup to the vertices, rlgl.h tells us which texture is Raylib's default one,
+// arena.h has the 16-byte rounding the file layout uses, and mapped_file.h has the checksum, the file
+// mapping and the temporary-file swap (the same ones compiled levels use).
+#include "mesh_cache.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "arena.h"
+#include "mapped_file.h"
+
+
+// --- CHECKSUM ---
+static uint64_t ChecksumCache(const MeshCacheHeader *header, const unsigned char *payload) {
+    // The checksum can't include itself, so it is counted as 0.
+    MeshCacheHeader copy;
+    memcpy(&copy, header, sizeof(copy));
+    copy.checksum = 0;
+
+    uint64_t hash = ChecksumBytes(CHECKSUM_SEED, (const unsigned char *)&copy, sizeof(copy));
+    return ChecksumBytes(hash, payload, (size_t)header->payloadSize);
+}
+
+uint64_t HashMeshSource(const unsigned char *data, size_t size) {
+    return ChecksumBytes(CHECKSUM_SEED, data, size);
+}
+
+void GetMeshCacheFileName(const char *sourceFile, char *outFileName, int outSize) {
+    snprintf(outFileName, outSize, "%s", sourceFile);
+
+    // Only replace a real extension (a dot after the last folder separator).
+    char *extension = strrchr(outFileName, '.');
+    char *folder = strrchr(outFileName, '/');
+    if (extension != NULL && (folder == NULL || extension > folder) &&
+        (size_t)(extension - outFileName) + sizeof(".mesh") <= (size_t)outSize) {
+        strcpy(extension, ".mesh");
+    }
+}
+
+
+// --- VERTEX ARRAYS ---
+// The arrays of a Mesh in the order of the MESH_CACHE_* bits, so writing and reading are one loop.
+static size_t GetArrayBytes(int index, int vertexCount, int triangleCount) {
+    size_t vertices = (size_t)vertexCount;
+
+    switch (index) {
+        case 0:  return vertices * 3 * sizeof(float);                           // vertices
+        case 1:  return vertices * 2 * sizeof(float);                           // texcoords
+        case 2:  return vertices * 2 * sizeof(float);                           // texcoords2
+        case 3:  return vertices * 3 * sizeof(float);                           // normals
+        case 4:  return vertices * 4 * sizeof(float);                           // tangents
+        case 5:  return vertices * 4 * sizeof(unsigned char);                   // colors
+        default: return (size_t)triangleCount * 3 * sizeof(unsigned short);     // indices
+    }
+}
+
+static void *GetMeshArray(const Mesh *mesh, int index) {
+    switch (index) {
+        case 0:  return mesh->vertices;
+        case 1:  return mesh->texcoords;
+        case 2:  return mesh->texcoords2;
+        case 3:  return mesh->normals;
+        case 4:  return mesh->tangents;
+        case 5:  return mesh->colors;
+        default: return mesh->indices;
+    }
+}
+
+static void SetMeshArray(Mesh *mesh, int index, void *data) {
+    switch (index) {
+        case 0:  mesh->vertices = (float *)data; break;
+        case 1:  mesh->texcoords = (float *)data; break;
+        case 2:  mesh->texcoords2 = (float *)data; break;
+        case 3:  mesh->normals = (float *)data; break;
+        case 4:  mesh->tangents = (float *)data; break;
+        case 5:  mesh->colors = (unsigned char *)data; break;
+        default: mesh->indices = (unsigned short *)data; break;
+    }
+}
+
+// Rotates the copied positions, normals and tangents by the fixup, so the model can be drawn
+// with an identity transform. Directions ignore the translation part.
+static void ApplyFixup(int index, void *data, int vertexCount, Matrix fixup) {
+    if (index != 0 && index != 3 && index != 4) {
+        return; // Texture coordinates, colors and indices don't move.
+    }
+
+    Matrix rotation = fixup;
+    rotation.m12 = 0.0f;
+    rotation.m13 = 0.0f;
+    rotation.m14 = 0.0f;
+
+    float *values = (float *)data;
+    for (int i = 0; i < vertexCount; i++) {
+        if (index == 0 || index == 3) {
+            Vector3 *v = (Vector3 *)&values[i * 3];
+            *v = Vector3Transform(*v, (index == 0) ? fixup : rotation);
+        } else if (index == 4) {
+            Vector3 *v = (Vector3 *)&values[i * 4]; // The 4th value (handedness) stays.
+            *v = Vector3Transform(*v, rotation);
+        }
+    }
+}
+
+// Raylib gives every material a 1x1 white texture when the model has none. It isn't worth saving.
+static bool HasOwnTexture(Texture2D texture) {
+    return texture.id != 0 && texture.id != rlGetTextureIdDefault() && texture.width > 0 && texture.height > 0;
+}
+
+
+// --- WRITER ---
+bool WriteMeshCache(const char *cacheFile, Model model, uint64_t sourceSize, uint64_t sourceHash) {
+    // Skinned models keep their bones outside the meshes; they are simply parsed every time.
+    if (model.boneCount > 0 || model.meshCount <= 0 || model.materialCount <= 0) {
+        return false;
+    }
+
+    MeshCacheHeader header;
+    memset(&header, 0, sizeof(header)); // Also zeroes the padding bytes, so the checksum is repeatable.
+    memcpy(header.magic, MESH_CACHE_MAGIC, 4);
+    header.version = MESH_CACHE_VERSION;
+    header.headerSize = sizeof(MeshCacheHeader);
+    header.meshCount = model.meshCount;
+    header.materialCount = model.materialCount;
+    header.sourceSize = sourceSize;
+    header.sourceHash = sourceHash;
+    header.fixup = model.transform;
+
+    // 1. Work out how big everything is.
+    size_t meshTableBytes = ArenaAllocSize(model.meshCount * sizeof(MeshCacheMesh));
+    size_t materialTableBytes = ArenaAllocSize(model.materialCount * sizeof(MeshCacheMaterial));
+    size_t payloadSize = meshTableBytes + materialTableBytes;
+
+    for (int m = 0; m < model.meshCount; m++) {
+        const Mesh *mesh = &model.meshes[m];
+        for (int a = 0; a < MESH_CACHE_ARRAY_COUNT; a++) {
+            if (GetMeshArray(mesh, a) != NULL) {
+                payloadSize += ArenaAllocSize(GetArrayBytes(a, mesh->vertexCount, mesh->triangleCount));
+            }
+        }
+    }
+    for (int i = 0; i < model.materialCount; i++) {
+        Texture2D texture = model.materials[i].maps[MATERIAL_MAP_ALBEDO].texture;
+        if (HasOwnTexture(texture)) {
+            payloadSize += ArenaAllocSize((size_t)texture.width * texture.height * 4);
+        }
+    }
+
+    // calloc: the alignment gaps must be zero, so the checksum is repeatable.
+    unsigned char *payload = (unsigned char *)calloc(1, payloadSize);
+    if (payload == NULL) {
+        return false;
+    }
+
+    // 2. The tables...
+    MeshCacheMesh *meshTable = (MeshCacheMesh *)payload;
+    MeshCacheMaterial *materialTable = (MeshCacheMaterial *)(payload + meshTableBytes);
+    size_t offset = meshTableBytes + materialTableBytes;
+
+    Matrix identity = MatrixIdentity();
+    bool hasFixup = (memcmp(&model.transform, &identity, sizeof(Matrix)) != 0);
+
+    for (int m = 0; m < model.meshCount; m++) {
+        const Mesh *mesh = &model.meshes[m];
+        meshTable[m].vertexCount = mesh->vertexCount;
+        meshTable[m].triangleCount = mesh->triangleCount;
+        meshTable[m].material = (model.meshMaterial != NULL) ? model.meshMaterial[m] : 0;
+
+        // 3. ...every vertex array, with the fixup applied...
+        for (int a = 0; a < MESH_CACHE_ARRAY_COUNT; a++) {
+            const void *array = GetMeshArray(mesh, a);
+            if (array == NULL) continue;
+
+            size_t bytes = GetArrayBytes(a, mesh->vertexCount, mesh->triangleCount);
+            memcpy(payload + offset, array, bytes);
+            if (hasFixup) {
+                ApplyFixup(a, payload + offset, mesh->vertexCount, model.transform);
+            }
+
+            meshTable[m].arrays |= (1u << a);
+            offset += ArenaAllocSize(bytes);
+        }
+    }
+
+    // 4. ...and the texture pixels, read back from the GPU as plain RGBA.
+    for (int i = 0; i < model.materialCount; i++) {
+        const MaterialMap *albedo = &model.materials[i].maps[MATERIAL_MAP_ALBEDO];
+        materialTable[i].color = albedo->color;
+
+        if (HasOwnTexture(albedo->texture)) {
+            Image image = LoadImageFromTexture(albedo->texture);
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+            // A failed readback would leave a material without its pixels, and every texture after it
+            // would be read from the wrong place. Write no cache at all: the next launch tries again.
+            bool isRead = (image.data != NULL && image.width == albedo->texture.width &&
+                           image.height == albedo->texture.height);
+            if (!isRead) {
+                UnloadImage(image);
+                free(payload);
+                return false;
+            }
+
+            size_t bytes = (size_t)image.width * image.height * 4;
+            memcpy(payload + offset, image.data, bytes);
+            materialTable[i].width = image.width;
+            materialTable[i].height = image.height;
+            UnloadImage(image);
+            offset += ArenaAllocSize(bytes);
+        }
+    }
+
+    header.payloadSize = payloadSize;
+    header.checksum = ChecksumCache(&header, payload);
+
+    // 5. Write header and payload into a temporary file and swap it in with one rename,
+    // so the next launch never maps half a cache.
+    char tempFile[256];
+    FILE *file = OpenReplacementFile(cacheFile, tempFile, sizeof(tempFile));
+    if (file == NULL) {
+        free(payload);
+        return false;
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(payload, payloadSize, 1, file) == 1;
+    free(payload);
+    return CommitReplacementFile(file, tempFile, cacheFile, written);
+}
+
+
+// --- READER ---
+// Returns why the mapped file can't be used, or NULL if it is good.
+static const char *CheckMeshCache(const unsigned char *data, size_t fileSize,
+                                  uint64_t sourceSize, uint64_t sourceHash, Matrix fixup) {
+    if (fileSize < sizeof(MeshCacheHeader)) {
+        return "too short";
+    }
+
+    const MeshCacheHeader *header = (const MeshCacheHeader *)data;
+
+    if (memcmp(header->magic, MESH_CACHE_MAGIC, 4) != 0) {
+        return "not a mesh cache";
+    }
+    if (header->version != MESH_CACHE_VERSION || header->headerSize != sizeof(MeshCacheHeader)) {
+        return "built by another version";
+    }
+    if (header->sourceSize != sourceSize || header->sourceHash != sourceHash) {
+        return "the model has changed";
+    }
+    if (memcmp(&header->fixup, &fixup, sizeof(Matrix)) != 0) {
+        return "built with another fixup";
+    }
+    if (header->meshCount <= 0 || header->materialCount <= 0 ||
+        sizeof(MeshCacheHeader) + header->payloadSize != fileSize) {
+        return "damaged";
+    }
+    if (ChecksumCache(header, data + sizeof(MeshCacheHeader)) != header->checksum) {
+        return "checksum mismatch";
+    }
+
+    return NULL;
+}
+
+// Copies the next 'bytes' of the payload into a fresh malloc() block (Raylib frees it with free()).
+// Returns NULL if they would run past the end.
+static void *CopyBlock(const unsigned char *payload, size_t payloadSize, size_t *offset, size_t bytes) {
+    if (*offset > payloadSize || bytes > payloadSize - *offset) {
+        return NULL;
+    }
+
+    void *block = malloc(bytes > 0 ? bytes : 1);
+    if (block != NULL) {
+        memcpy(block, payload + *offset, bytes);
+    }
+    *offset += ArenaAllocSize(bytes);
+    return block;
+}
+
+bool LoadMeshCache(const char *cacheFile, uint64_t sourceSize, uint64_t sourceHash, Matrix fixup, CachedModel *outModel) {
+    *outModel = (CachedModel){ 0 };
+
+    // No cache yet is perfectly normal (the first launch), so that case stays silent.
+    size_t fileSize = 0;
+    unsigned char *data = MapFile(cacheFile, &fileSize, false);
+    if (data == NULL) {
+        return false;
+    }
+
+    const char *problem = CheckMeshCache(data, fileSize, sourceSize, sourceHash, fixup);
+    if (problem != NULL) {
+        TraceLog(LOG_INFO, "ASSETS: Ignoring [%s] (%s)", cacheFile, problem);
+        UnmapFile(data, fileSize);
+        return false;
+    }
+
+    const MeshCacheHeader *header = (const MeshCacheHeader *)data;
+    const unsigned char *payload = data + sizeof(MeshCacheHeader);
+    size_t payloadSize = (size_t)header->payloadSize;
+
+    size_t meshTableBytes = ArenaAllocSize(header->meshCount * sizeof(MeshCacheMesh));
+    size_t materialTableBytes = ArenaAllocSize(header->materialCount * sizeof(MeshCacheMaterial));
+    bool valid = (meshTableBytes + materialTableBytes <= payloadSize);
+
+    CachedModel model = { 0 };
+    model.meshCount = header->meshCount;
+    model.materialCount = header->materialCount;
+    model.meshes = (Mesh *)calloc(model.meshCount, sizeof(Mesh));
+    model.meshMaterial = (int *)calloc(model.meshCount, sizeof(int));
+    model.materialColors = (Color *)calloc(model.materialCount, sizeof(Color));
+    model.materialImages = (Image *)calloc(model.materialCount, sizeof(Image));
+    valid = valid && model.meshes != NULL && model.meshMaterial != NULL &&
+            model.materialColors != NULL && model.materialImages != NULL;
+
+    // Copy every array out of the mapping, checking each one fits (the checksum only proves
+    // the file wasn't damaged, not that the writer was sane).
+    size_t offset = meshTableBytes + materialTableBytes;
+
+    for (int m = 0; valid && m < model.meshCount; m++) {
+        MeshCacheMesh entry;
+        memcpy(&entry, payload + m * sizeof(MeshCacheMesh), sizeof(entry));
+
+        if (entry.vertexCount < 0 || entry.triangleCount < 0 ||
+            entry.material < 0 || entry.material >= model.materialCount) {
+            valid = false;
+            break;
+        }
+
+        Mesh *mesh = &model.meshes[m];
+        mesh->vertexCount = entry.vertexCount;
+        mesh->triangleCount = entry.triangleCount;
+        model.meshMaterial[m] = entry.material;
+
+        for (int a = 0; valid && a < MESH_CACHE_ARRAY_COUNT; a++) {
+            if ((entry.arrays & (1u << a)) == 0) continue;
+
+            void *array = CopyBlock(payload, payloadSize, &offset, GetArrayBytes(a, entry.vertexCount, entry.triangleCount));
+            SetMeshArray(mesh, a, array);
+            valid = (array != NULL);
+        }
+    }
+
+    for (int i = 0; valid && i < model.materialCount; i++) {
+        MeshCacheMaterial entry;
+        memcpy(&entry, payload + meshTableBytes + i * sizeof(MeshCacheMaterial), sizeof(entry));
+        model.materialColors[i] = entry.color;
+
+        if (entry.width < 0 || entry.height < 0) {
+            valid = false;
+        } else if (entry.width > 0 && entry.height > 0) {
+            void *pixels = CopyBlock(payload, payloadSize, &offset, (size_t)entry.width * entry.height * 4);
+            model.materialImages[i] = (Image){ pixels, entry.width, entry.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+            valid = (pixels != NULL);
+        }
+    }
+
+    UnmapFile(data, fileSize);
+
+    if (!valid) {
+        TraceLog(LOG_INFO, "ASSETS: Ignoring [%s] (damaged)", cacheFile);
+        UnloadCachedModel(&model);
+        return false;
+    }
+
+    *outModel = model;
+    return true;
+}
+
+
+// --- UPLOAD (MAIN THREAD) ---
+Model UploadCachedModel(CachedModel *cached) {
+    Model model = { 0 };
+    model.transform = MatrixIdentity(); // The fixup is already in the vertices.
+
+    model.meshCount = cached->meshCount;
+    model.meshes = cached->meshes;
+    model.meshMaterial = cached->meshMaterial;
+    for (int m = 0; m < model.meshCount; m++) {
+        UploadMesh(&model.meshes[m], false);
+    }
+
+    model.materialCount = cached->materialCount;
+    model.materials = (Material *)calloc(model.materialCount, sizeof(Material));
+    for (int i = 0; i < model.materialCount; i++) {
+        model.materials[i] = LoadMaterialDefault();
+        model.materials[i].maps[MATERIAL_MAP_ALBEDO].color = cached->materialColors[i];
+
+        Image image = cached->materialImages[i];
+        if (image.data != NULL) {
+            model.materials[i].maps[MATERIAL_MAP_ALBEDO].texture = LoadTextureFromImage(image);
+            UnloadImage(image);
+        }
+    }
+
+    // The Model owns the meshes now; only the material lists are ours to free.
+    free(cached->materialColors);
+    free(cached->materialImages);
+    *cached = (CachedModel){ 0 };
+
+    return model;
+}
+
+void UnloadCachedModel(CachedModel *cached) {
+    for (int m = 0; cached->meshes != NULL && m < cached->meshCount; m++) {
+        for (int a = 0; a < MESH_CACHE_ARRAY_COUNT; a++) {
+            free(GetMeshArray(&cached->meshes[m], a));
+        }
+    }
+    for (int i = 0; cached->materialImages != NULL && i < cached->materialCount; i++) {
+        free(cached->materialImages[i].data);
+    }
+
+    free(cached->meshes);
+    free(cached->meshMaterial);
+    free(cached->materialColors);
+    free(cached->materialImages);
+    *cached = (CachedModel){ 0 };
+}
@@ -11,10 +11,10 @@
 // --- UPDATE LOOP (WORKER) ---
 // This function acts as the Referee specifically for Precision Landing Missions.
 // It checks the player's 3D coordinates, throttle, and kinetic energy to determine a safe touchdown.
-void UpdateMissionLanding(RaceSystem *race, Player *player) {
+void UpdateMissionLanding(RaceSystem *race, Player *player, float dt) {
     
     // --- 0. DYNAMIC PAD MOVEMENT ---
-    float dt = GetFrameTime();
+    // 'dt' is the fixed simulation tick, so the pad follows the exact same path on every run.
     
     if (race->padMoveType == 1) {
         // --- LINEAR MOVEMENT ---
@@ -90,18 +90,21 @@ void UpdateMissionLanding(RaceSystem *race, Player *player) {
         // Failure 1: The "Off-Road" check. Missed the pad entirely.
         if (!isAbovePad) {
             race->missionFailed = true;
+            race->failReason = FAIL_MISSED_PAD;
         }
         
         // Failure 2: Vertical structural failure (Slammed into the ground too hard).
         // We check 'prevSpeed' which stores the vertical descent rate of the previous frame.
         else if (race->prevSpeed > race->maxLandingSpeed) {
             race->missionFailed = true;
+            race->failReason = FAIL_HARD_LANDING;
         }
         
         // Failure 3: Landing gear collapse (Sliding horizontally too fast relative to the pad).
         // We give a generous 3.0x multiplier to the limit so airplanes can touch down and brake.
         else if (horizontalSlip > race->maxLandingSpeed * 3.0f) {
             race->missionFailed = true;
+            race->failReason = FAIL_SLIDING;
         }
         
         // Success: Safe touchdown!
@@ -114,77 +117,3 @@ void UpdateMissionLanding(RaceSystem *race, Player *player) {
     // Store this frame's vertical sink rate for the next frame's impact evaluation.
     race->prevSpeed = verticalImpact;
 }
-
-
-// --- RENDERING FUNCTION (3D WORLD) ---
-// This draws exclusively the landing pad geometry and the navigation arrow.
-void DrawMissionLanding3D(RaceSystem *race, Player *player) {
-    if (race->isRaceActive || race->missionFailed) { 
-        DrawCylinder(race->landingZone, race->landingRadius, race->landingRadius, 0.5f, 32, ORANGE);
-        
-        // Middle layer: A solid white concrete area so it stands out against dark terrain.
-        // We lift it by 0.1f on the Y-axis to prevent "Z-fighting" (flickering textures).
-        Vector3 midLayer = { race->landingZone.x, race->landingZone.y + 0.1f, race->landingZone.z };
-        DrawCylinder(midLayer, race->landingRadius * 0.9f, race->landingRadius * 0.9f, 0.5f, 32, RAYWHITE);
-        
-        // Top layer: A red bullseye to mark the exact mathematical center of the landing zone.
-        // Lifted by 0.2f to sit perfectly on top of the white layer.
-        Vector3 bullseye = { race->landingZone.x, race->landingZone.y + 0.2f, race->landingZone.z };
-        DrawCylinder(bullseye, race->landingRadius * 0.2f, race->landingRadius * 0.2f, 0.5f, 16, RED);
-
-        if (!race->missionFailed) {
-            DrawNavArrow(player, race->landingZone);
-        }
-    }
-}
-
-
-// --- RENDERING FUNCTION (2D HUD) ---
-// This draws exclusively the UI elements for landing (speed warnings, distance, etc.).
-void DrawMissionLandingUI(RaceSystem *race) {
-    int screenWidth = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
-    
-    if (race->missionFailed) {
-        // --- MISSION FAILED SCREEN ---
-        const char *failText = "CRASH LANDING! MISSION FAILED";
-        int failWidth = MeasureText(failText, 40);
-        DrawTextOutlined(failText, (screenWidth - failWidth) / 2, screenHeight * 0.4f, 40, RED, 2);
-        
-        // Dynamic Restart Instructions based on hardware.
-        const char *restText;
-        if (IsGamepadAvailable(0)) {
-            restText = "Press [B] to Restart";
-        } else {
-            restText = "Press [R] to Restart";
-        }
-        
-        int restWidth = MeasureText(restText, 30);
-        DrawTextOutlined(restText, (screenWidth - restWidth) / 2, screenHeight * 0.5f, 30, GRAY, 2);
-        
-    } else if (race->isRaceActive) {
-        // --- NORMAL HUD ---
-        const char *timerText = TextFormat("MISSION TIME: %.2f", race->timer);
-        int timerWidth = MeasureText(timerText, 30);
-        DrawTextOutlined(timerText, (screenWidth - timerWidth) / 2, screenHeight * 0.05f, 30, WHITE, 2);
-
-        const char *objText;
-        if (race->padMoveType > 0) {
-            objText = "OBJECTIVE: LAND ON MOVING CARRIER";
-        } else {
-            objText = "OBJECTIVE: SAFE TOUCHDOWN";
-        }
-        int objWidth = MeasureText(objText, 20);
-        DrawTextOutlined(objText, (screenWidth - objWidth) / 2, screenHeight * 0.10f, 20, GOLD, 2);    
-        
-    } else if (race->isFinished && race->finishedTimer < 3.0f) {
-        // --- VICTORY SCREEN ---
-        const char *winText = "PERFECT LANDING!";
-        int winWidth = MeasureText(winText, 40);
-        DrawTextOutlined(winText, (screenWidth - winWidth) / 2, screenHeight * 0.4f, 40, GOLD, 2);
-        
-        const char *timeText = TextFormat("FINAL TIME: %.2f SECONDS", race->timer);
-        int timeWidth = MeasureText(timeText, 30);
-        DrawTextOutlined(timeText, (screenWidth - timeWidth) / 2, screenHeight * 0.5f, 30, WHITE, 2);
-    }
-}
\ No newline at end of file
@@ -1,185 +1,384 @@
 // Include math library to use advanced mathematical functions.
+// We also need stdlib.h for the temporary arrays used while building the ring grid.
 #include <math.h>
+#include <stdlib.h>
 
 // We include our own header files.
-// We also need resource_manager.h so this .c file knows what a 'ringModel' is.
 // We also need raymath.h to calculate the 3D distances between the player and the rings.
 #include "race.h"
 #include "mission_rings.h"
-#include "resource_manager.h"
 #include "raymath.h"
 
 
-// --- UPDATE LOOP (WORKER) ---
-// This function acts as the Referee specifically for Ring Missions.
-// It checks if the player has crossed the current target ring, or crashed into its physical frame.
-void UpdateMissionRings(RaceSystem *race, Player *player) {
-    
-    // --- 0) OMNIDIRECTIONAL MATH COLLISION (SCORING AND CRASHING) ---
-    // We loop through all active rings to check for physical crashes, 
-    // and check the target ring for scoring.
-    for (int i = 0; i < MAX_RINGS; i++) {
-        if (!race->rings[i].active) {
-            continue;
-        }
+// --- CONSTANTS ---
+// Extra room around every ring's bounding sphere. A ring crash pushes the player by up to
+// 0.25 units per tick, and the grid cell is looked up with the position from BEFORE those pushes.
+#define RING_BOUND_MARGIN 1.0f
+
+// The grid cubes are never smaller than this (keeps tiny rings from creating millions of cells).
+#define RING_GRID_MIN_CELL 32.0f
 
+
+// --- PRECOMPUTED RING FRAMES ---
+// Rings never move, so everything that only depends on the ring is calculated here, once.
+void BuildRingFrames(RaceSystem *race) {
+    RingFrames *frames = &race->ringFrames;
+
+    for (int i = 0; i < race->totalRings; i++) {
         Ring *ring = &race->rings[i];
 
-        // Calculate the vector pointing from the ring to the player.
-        Vector3 diff = Vector3Subtract(player->position, ring->position);
+        frames->centerX[i] = ring->position.x;
+        frames->centerY[i] = ring->position.y;
+        frames->centerZ[i] = ring->position.z;
+
+        // Which way the ring's hole is facing based on yaw and pitch.
+        frames->normalX[i] = -sinf(ring->yaw * DEG2RAD) * cosf(ring->pitch * DEG2RAD);
+        frames->normalY[i] = sinf(ring->pitch * DEG2RAD);
+        frames->normalZ[i] = -cosf(ring->yaw * DEG2RAD) * cosf(ring->pitch * DEG2RAD);
+
+        // The visual tube thickness plus a 2.0f buffer.
+        frames->radius[i] = ring->radius;
+        frames->tubeThickness[i] = (ring->radius * 0.05f) + 2.0f;
+
+        // Every point of the tube (and of the scoring hole) is closer to the centre than this.
+        float bound = ring->radius + frames->tubeThickness[i] + RING_BOUND_MARGIN;
+        frames->boundRadiusSqr[i] = bound * bound;
+    }
+}
+
+
+// --- FULL RING CHECK ---
+// The exact torus collision test for ONE ring (only for rings the player is close to).
+static void CheckRingCollision(RaceSystem *race, Player *player, int i, float dtScale) {
+    const RingFrames *frames = &race->ringFrames;
 
-        // Calculate which way the ring's hole is facing based on yaw and pitch.
-        Vector3 ringForward = { 
-            -sinf(ring->yaw * DEG2RAD) * cosf(ring->pitch * DEG2RAD), 
-            sinf(ring->pitch * DEG2RAD), 
-            -cosf(ring->yaw * DEG2RAD) * cosf(ring->pitch * DEG2RAD) 
-        };
+    Vector3 center = { frames->centerX[i], frames->centerY[i], frames->centerZ[i] };
+    Vector3 ringForward = { frames->normalX[i], frames->normalY[i], frames->normalZ[i] };
+    float radius = frames->radius[i];
 
-        // Calculate depth (Z) and radial (X-Y) distance to the ring's mathematical center.
-        float depthDistance = fabsf(Vector3DotProduct(diff, ringForward));
-        float totalDistanceSqr = Vector3LengthSqr(diff);
-        float distance2D = sqrtf(fabsf(totalDistanceSqr - (depthDistance * depthDistance)));
+    // Calculate the vector pointing from the ring to the player.
+    Vector3 diff = Vector3Subtract(player->position, center);
 
+    // Calculate depth (Z) and radial (X-Y) distance to the ring's mathematical center.
+    float depthDistance = fabsf(Vector3DotProduct(diff, ringForward));
+    float totalDistanceSqr = Vector3LengthSqr(diff);
+    float distance2D = sqrtf(fabsf(totalDistanceSqr - (depthDistance * depthDistance)));
 
-        // --- A) HARD COLLISION (MATHEMATICAL TORUS WITH RADIAL DEFLECTION) ---
-        // The core of the tube is located at exactly 'ring->radius' on the 2D plane.
-        float radialDiff = distance2D - ring->radius;
-        float distanceToTubeCore = sqrtf((radialDiff * radialDiff) + (depthDistance * depthDistance));
+
+    // --- A) HARD COLLISION (MATHEMATICAL TORUS WITH RADIAL DEFLECTION) ---
+    // The core of the tube is located at exactly 'radius' on the 2D plane.
+    float radialDiff = distance2D - radius;
+    float distanceToTubeCore = sqrtf((radialDiff * radialDiff) + (depthDistance * depthDistance));
+
+    if (distanceToTubeCore < frames->tubeThickness[i]) {
         
-        // The visual tube thickness plus a 2.0f buffer.
-        float tubeThickness = (ring->radius * 0.05f) + 2.0f;
-
-        if (distanceToTubeCore < tubeThickness) {
-            
-            // 1. Find where the player is relative to the flat plane of the ring.
-            float dot = Vector3DotProduct(diff, ringForward);
-            Vector3 planeProjection = Vector3Subtract(diff, Vector3Scale(ringForward, dot));
-            
-            // 2. Normalize to get the exact direction from ring center to player on that plane.
-            Vector3 planeDir = Vector3Normalize(planeProjection);
-            
-            // 3. Find the exact coordinate of the solid tube's core nearest to the player.
-            Vector3 corePoint = Vector3Add(ring->position, Vector3Scale(planeDir, ring->radius));
-            
-            // 4. Create a pushback vector pointing strictly outwards from the solid tube.
-            Vector3 pushOutward = Vector3Normalize(Vector3Subtract(player->position, corePoint));
-            
-            // 5. Deflect the player (Slide along the ring instead of a dead stop).
-            // We penalize the speed slightly (lose 20% speed) instead of killing the engine.
-            player->throttle *= 0.8f; 
-            
-            // Push the player radially away from the metal frame.
-            player->position.x += pushOutward.x * 0.5f;
-            player->position.y += pushOutward.y * 0.5f;
-            player->position.z += pushOutward.z * 0.5f;
-            
-            // Add a slight bounce to the velocity to make the impact feel real.
-            player->velocity.x += pushOutward.x * 0.05f;
-            player->velocity.y += pushOutward.y * 0.05f;
-            player->velocity.z += pushOutward.z * 0.05f;
+        // 1. Find where the player is relative to the flat plane of the ring.
+        float dot = Vector3DotProduct(diff, ringForward);
+        Vector3 planeProjection = Vector3Subtract(diff, Vector3Scale(ringForward, dot));
+        
+        // 2. Normalize to get the exact direction from ring center to player on that plane.
+        Vector3 planeDir = Vector3Normalize(planeProjection);
+        
+        // 3. Find the exact coordinate of the solid tube's core nearest to the player.
+        Vector3 corePoint = Vector3Add(center, Vector3Scale(planeDir, radius));
+        
+        // 4. Create a pushback vector pointing strictly outwards from the solid tube.
+        Vector3 pushOutward = Vector3Normalize(Vector3Subtract(player->position, corePoint));
+        
+        // 5. Deflect the player (Slide along the ring instead of a dead stop).
+        // We penalize the speed slightly (lose 20% speed) instead of killing the engine.
+        player->throttle *= powf(0.8f, dtScale);
+        
+        // Push the player radially away from the metal frame.
+        player->position.x += pushOutward.x * 0.5f * dtScale;
+        player->position.y += pushOutward.y * 0.5f * dtScale;
+        player->position.z += pushOutward.z * 0.5f * dtScale;
+        
+        // Add a slight bounce to the velocity to make the impact feel real.
+        player->velocity.x += pushOutward.x * 0.05f * dtScale;
+        player->velocity.y += pushOutward.y * 0.05f * dtScale;
+        player->velocity.z += pushOutward.z * 0.05f * dtScale;
+    }
+}
+
+
+// --- SWEPT RING CROSSING ---
+// Did the player fly through the scoring hole of ring 'i' at ANY moment between 'from' and 'to'?
+// Checking only the position at the end of the tick misses the ring when the aircraft moves more
+// than the hole's depth in one tick (high speed, a slow tick rate, or bots running faster than real time).
+// So we test the whole straight line travelled during the tick against the hole: a thin disc,
+// 'holeDepth' units thick on each side of the ring's plane.
+static bool SegmentCrossesRingHole(const RingFrames *frames, int i, Vector3 from, Vector3 to) {
+    Vector3 center = { frames->centerX[i], frames->centerY[i], frames->centerZ[i] };
+    Vector3 normal = { frames->normalX[i], frames->normalY[i], frames->normalZ[i] };
+
+    // We restrict the valid scoring zone to only the inner 10% of the ring for visual immersion,
+    // and to less than 1 unit in front of or behind its plane.
+    float holeRadius = frames->radius[i] * 0.10f;
+    float holeDepth = 1.0f;
+
+    // The movement as "start + t * step", with 't' going from 0.0f (start of the tick) to 1.0f (end).
+    Vector3 start = Vector3Subtract(from, center);
+    Vector3 step = Vector3Subtract(to, from);
+
+    // 1. Depth (distance in front of the plane) changes linearly along the line.
+    //    Find the part of the line (tMin to tMax) that is inside the disc's thickness.
+    float startDepth = Vector3DotProduct(start, normal);
+    float stepDepth = Vector3DotProduct(step, normal);
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+
+    if (fabsf(stepDepth) < 1e-6f) {
+        // Flying parallel to the plane: either always inside the thickness or never.
+        if (fabsf(startDepth) >= holeDepth) return false;
+    } else {
+        float tEnter = (-holeDepth - startDepth) / stepDepth;
+        float tExit = (holeDepth - startDepth) / stepDepth;
+        if (tEnter > tExit) {
+            float swap = tEnter;
+            tEnter = tExit;
+            tExit = swap;
         }
+        tMin = fmaxf(tMin, tEnter);
+        tMax = fminf(tMax, tExit);
+        if (tMin > tMax) return false;
+    }
+
+    // 2. Radial offset (the part along the plane) also changes linearly: 'radialStart + t * radialStep'.
+    //    Find the moment inside [tMin, tMax] when it is smallest, and compare it with the hole.
+    Vector3 radialStart = Vector3Subtract(start, Vector3Scale(normal, startDepth));
+    Vector3 radialStep = Vector3Subtract(step, Vector3Scale(normal, stepDepth));
 
+    float t = tMin;
+    float radialStepSqr = Vector3LengthSqr(radialStep);
+    if (radialStepSqr > 1e-12f) {
+        t = Clamp(-Vector3DotProduct(radialStart, radialStep) / radialStepSqr, tMin, tMax);
+    }
+
+    Vector3 closest = Vector3Add(radialStart, Vector3Scale(radialStep, t));
+    return Vector3LengthSqr(closest) <= holeRadius * holeRadius;
+}
 
-        // --- B) SCORING THE TARGET RING ---
-        // We only score points for the current target ring.
-        if (i == race->targetRing) {
-            
-            // We restrict the valid scoring zone to only the inner 15% of the ring
-            // for visual immersion.
-            float validHoleRadius = ring->radius * 0.10f;
 
-            if (distance2D <= validHoleRadius && depthDistance < 1.0f) {
-                ring->active = false;
-                race->targetRing++;
+// --- BROADPHASE GRID ---
 
-                // Check if this was the final ring.
-                if (race->targetRing >= race->totalRings) {
-                    race->isFinished = true;
-                    race->isRaceActive = false; 
+// Which cube of the grid a coordinate falls in.
+static int GetRingCell(float coordinate, float cellSize) {
+    return (int)floorf(coordinate / cellSize);
+}
+
+// Turns cube coordinates into a bucket number (large primes spread the cubes over the table).
+static unsigned int GetRingBucket(const RingGrid *grid, int x, int y, int z) {
+    unsigned int hash = ((unsigned int)x * 73856093u) ^ ((unsigned int)y * 19349663u) ^ ((unsigned int)z * 83492791u);
+    return hash & grid->bucketMask;
+}
+
+// Lists ring 'i' in every bucket its bounding sphere touches ('counts' mode) or writes it there ('fill' mode).
+// Two far apart cubes can share a bucket, so 'lastRing' makes sure a ring is listed once per bucket.
+static int ListRingInBuckets(RingGrid *grid, const RingFrames *frames, int i, int *lastRing, int *counts, int *cursor) {
+    float bound = sqrtf(frames->boundRadiusSqr[i]);
+    int minX = GetRingCell(frames->centerX[i] - bound, grid->cellSize);
+    int minY = GetRingCell(frames->centerY[i] - bound, grid->cellSize);
+    int minZ = GetRingCell(frames->centerZ[i] - bound, grid->cellSize);
+    int maxX = GetRingCell(frames->centerX[i] + bound, grid->cellSize);
+    int maxY = GetRingCell(frames->centerY[i] + bound, grid->cellSize);
+    int maxZ = GetRingCell(frames->centerZ[i] + bound, grid->cellSize);
+
+    int listed = 0;
+    for (int x = minX; x <= maxX; x++) {
+        for (int y = minY; y <= maxY; y++) {
+            for (int z = minZ; z <= maxZ; z++) {
+                unsigned int bucket = GetRingBucket(grid, x, y, z);
+                if (lastRing[bucket] == i) {
+                    continue;
+                }
+                lastRing[bucket] = i;
+
+                if (counts != NULL) {
+                    counts[bucket]++;
+                } else {
+                    grid->ringIndices[cursor[bucket]++] = i;
                 }
+                listed++;
             }
         }
     }
+    return listed;
 }
 
+bool BuildRingGrid(RaceSystem *race) {
+    RingGrid *grid = &race->ringGrid;
+    const RingFrames *frames = &race->ringFrames;
+    UnloadRingGrid(grid);
 
-// --- RENDERING FUNCTION (3D WORLD) ---
-// This draws exclusively the ring models and the navigation arrow.
-void DrawMissionRings3D(RaceSystem *race, Player *player) {
-    
-    // --- 1. DRAW ALL ACTIVE RINGS ---
-    for (int i = 0; i < MAX_RINGS; i++) {
-        if (race->rings[i].active) {
-            
-            Color ringColor;
-            
-            if (i == race->targetRing) {
-                ringColor = GOLD;
-            } else {
-                ringColor = Fade(LIGHTGRAY, 0.3f);
-            }
-            
-            // 1. Save the 3D model's original base matrix.
-            Matrix baseTransform = ringModel.transform;
-            
-            // 2. Generate the full rotation matrix.
-            Matrix matRoll  = MatrixRotateZ(race->rings[i].roll * DEG2RAD);
-            Matrix matPitch = MatrixRotateX(race->rings[i].pitch * DEG2RAD);
-            Matrix matYaw   = MatrixRotateY(race->rings[i].yaw * DEG2RAD);
-            Matrix dynamicRotation = MatrixMultiply(MatrixMultiply(matRoll, matPitch), matYaw);
-            
-            // 3. Apply the rotation to the model temporarily.
-            ringModel.transform = MatrixMultiply(baseTransform, dynamicRotation);
-            
-            // 4. Draw the model (We pass 0.0f rotation because it is already embedded in the transform).
-            Vector3 scale = { race->rings[i].radius, race->rings[i].radius, race->rings[i].radius };
-            DrawModelEx(ringModel, race->rings[i].position, (Vector3){0, 1, 0}, 0.0f, scale, ringColor);
-            
-            // 5. Restore the original matrix.
-            ringModel.transform = baseTransform;
-        }
+    if (race->totalRings == 0) {
+        return true;
+    }
+
+    // 1. The cubes are as wide as the biggest ring, so every ring touches at most 2x2x2 cubes.
+    float largestBound = 0.0f;
+    for (int i = 0; i < race->totalRings; i++) {
+        largestBound = fmaxf(largestBound, sqrtf(frames->boundRadiusSqr[i]));
     }
+    grid->cellSize = fmaxf(largestBound * 2.0f, RING_GRID_MIN_CELL);
 
-    // --- 2. VECTORIAL HUD ARROW (CHEVRON) ---
-    // We build a high-tech wireframe arrow (-->) using 3D lines and cross products.
-    if (race->isRaceActive) {
-        DrawNavArrow(player, race->rings[race->targetRing].position);
+    // 2. About two buckets per ring keeps the buckets short (the count must be a power of two).
+    unsigned int bucketCount = 1;
+    while (bucketCount < (unsigned int)race->totalRings * 2u) {
+        bucketCount *= 2;
     }
+    grid->bucketMask = bucketCount - 1;
+
+    // Temporary arrays: the per-bucket counters and "last ring listed here" markers.
+    int *counts = (int *)calloc(bucketCount, sizeof(int));
+    int *lastRing = (int *)malloc(sizeof(int) * bucketCount);
+    if (counts == NULL || lastRing == NULL) {
+        free(counts);
+        free(lastRing);
+        return false;
+    }
+
+    // 3. First pass: count how many rings land in every bucket.
+    for (unsigned int b = 0; b < bucketCount; b++) lastRing[b] = -1;
+
+    int totalEntries = 0;
+    for (int i = 0; i < race->totalRings; i++) {
+        totalEntries += ListRingInBuckets(grid, frames, i, lastRing, counts, NULL);
+    }
+
+    // 4. Reserve the final lists in one block.
+    grid->arena = CreateArena(ArenaAllocSize(sizeof(int) * (bucketCount + 1)) +
+                              ArenaAllocSize(sizeof(int) * totalEntries));
+    grid->bucketStart = (int *)ArenaAlloc(&grid->arena, sizeof(int) * (bucketCount + 1));
+    grid->ringIndices = (int *)ArenaAlloc(&grid->arena, sizeof(int) * totalEntries);
+
+    if (grid->bucketStart == NULL || grid->ringIndices == NULL) {
+        free(counts);
+        free(lastRing);
+        UnloadRingGrid(grid);
+        return false;
+    }
+
+    // 5. Every bucket starts where the previous one ends. 'counts' becomes the write cursor.
+    int runningTotal = 0;
+    for (unsigned int b = 0; b < bucketCount; b++) {
+        grid->bucketStart[b] = runningTotal;
+        runningTotal += counts[b];
+        counts[b] = grid->bucketStart[b];
+    }
+    grid->bucketStart[bucketCount] = runningTotal;
+
+    // 6. Second pass: write the ring numbers. Rings go in from first to last,
+    //    so every bucket ends up sorted (the update checks them in circuit order).
+    for (unsigned int b = 0; b < bucketCount; b++) lastRing[b] = -1;
+
+    for (int i = 0; i < race->totalRings; i++) {
+        ListRingInBuckets(grid, frames, i, lastRing, NULL, counts);
+    }
+
+    free(counts);
+    free(lastRing);
+    return true;
 }
 
+void UnloadRingGrid(RingGrid *grid) {
+    DestroyArena(&grid->arena);
+    *grid = (RingGrid){ 0 };
+}
 
-// --- RENDERING FUNCTION (2D HUD) ---
-// This draws exclusively the UI elements for the ring missions (like the target ring count).
-void DrawMissionRingsUI(RaceSystem *race) {
-    
-    // Get current screen dimensions dynamically.
-    int screenWidth = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
-    
-    if (race->isRaceActive) {
-        // 1. Draw the stopwatch at 5% from the top.
-        const char *timerText = TextFormat("RACE TIME: %.2f", race->timer);
-        int timerWidth = MeasureText(timerText, 30);
-        DrawTextOutlined(timerText, (screenWidth - timerWidth) / 2, screenHeight * 0.05f, 30, WHITE, 2);
-
-        // 2. Draw progress at 10% from the top.
-        const char *ringText = TextFormat("TARGET RING: %d / %d", race->targetRing + 1, race->totalRings);
-        int ringWidth = MeasureText(ringText, 20);
-        DrawTextOutlined(ringText, (screenWidth - ringWidth) / 2, screenHeight * 0.10f, 20, GOLD, 2);
-        
+
+// --- UPDATE LOOP (WORKER) ---
+// This function acts as the Referee specifically for Ring Missions.
+// It checks if the player has crossed the current target ring, or crashed into its physical frame.
+void UpdateMissionRings(RaceSystem *race, Player *player, float dt) {
+
+    // The deflection values below were tuned for 60 updates per second.
+    // 'dtScale' converts them to the fixed tick rate (0.5f at 120 Hz).
+    float dtScale = dt * 60.0f;
+
+    const RingFrames *frames = &race->ringFrames;
+    const RingGrid *grid = &race->ringGrid;
+
+    // --- A) SCORING THE TARGET RING ---
+    // We only score points for the current target ring. It is tested against the WHOLE path flown
+    // during this tick (from 'prevPosition' to 'position'), so a fast aircraft can't skip through it.
+    // A very fast aircraft may even cross the next ring within the same tick, so we keep going.
+    while (race->targetRing < race->totalRings &&
+           SegmentCrossesRingHole(frames, race->targetRing, player->prevPosition, player->position)) {
+        race->rings[race->targetRing].active = false;
+        race->targetRing++;
+
+        // Check if this was the final ring.
+        if (race->targetRing >= race->totalRings) {
+            race->isFinished = true;
+            race->isRaceActive = false; 
+        }
+    }
+
+    if (grid->bucketStart == NULL) {
+        return; // No rings (or no grid): nothing to hit.
     }
     
-    // Only draw the victory message if less than 3 seconds have passed.
-    else if (race->isFinished && race->finishedTimer < 3.0f) {
-        
-        // Victory message perfectly centered horizontally, at 40% height.
-        const char *winText = "CIRCUIT COMPLETE!";
-        int winWidth = MeasureText(winText, 40);
-        DrawTextOutlined(winText, (screenWidth - winWidth) / 2, screenHeight * 0.4f, 40, GOLD, 2);
-        
-        // Final time perfectly centered horizontally, at 50% height.
-        const char *timeText = TextFormat("FINAL TIME: %.2f SECONDS", race->timer);
-        int timeWidth = MeasureText(timeText, 30);
-        DrawTextOutlined(timeText, (screenWidth - timeWidth) / 2, screenHeight * 0.5f, 30, WHITE, 2);
+    // --- B) OMNIDIRECTIONAL MATH COLLISION (CRASHING) ---
+    // We check the nearby active rings for physical crashes.
+    // Only the rings listed in the player's grid cube can be close enough to matter;
+    // every other ring is at least one whole cube away.
+    unsigned int bucket = GetRingBucket(grid,
+        GetRingCell(player->position.x, grid->cellSize),
+        GetRingCell(player->position.y, grid->cellSize),
+        GetRingCell(player->position.z, grid->cellSize));
+
+    for (int entry = grid->bucketStart[bucket]; entry < grid->bucketStart[bucket + 1]; entry++) {
+        int i = grid->ringIndices[entry];
+
+        // Rings are crossed strictly in order, so everything before the target is already done.
+        if (i < race->targetRing || !race->rings[i].active) {
+            continue;
+        }
+
+        // Quick reject: outside the ring's bounding sphere (the bucket may also hold far away cubes).
+        float dx = player->position.x - frames->centerX[i];
+        float dy = player->position.y - frames->centerY[i];
+        float dz = player->position.z - frames->centerZ[i];
+        if ((dx * dx) + (dy * dy) + (dz * dz) > frames->boundRadiusSqr[i]) {
+            continue;
+        }
+
+        // The exact torus test.
+        CheckRingCollision(race, player, i, dtScale);
     }
-}
\ No newline at end of file
+}
+
+
+// --- CACHED RING TRANSFORMS ---
+// Writes a colour into the bottom row of a ring's matrix (m3, m7, m11, m15).
+// That row is always (0, 0, 0, 1) in a normal 3D transform, so the ring shader reads
+// the colour from it and then puts the (0, 0, 0, 1) back (see shaders.h).
+void SetRingInstanceColor(Matrix *transform, Color color) {
+    transform->m3  = color.r / 255.0f;
+    transform->m7  = color.g / 255.0f;
+    transform->m11 = color.b / 255.0f;
+    transform->m15 = color.a / 255.0f;
+}
+
+void BuildRingTransforms(RaceSystem *race) {
+    for (int i = 0; i < race->totalRings; i++) {
+        Ring *ring = &race->rings[i];
+
+        // Same order as before: roll, then pitch, then yaw, then the size, then the position.
+        // The model's own orientation (ringModel.transform) is applied by the shader, because
+        // the headless tools build races without ever loading the 3D models.
+        Matrix matRoll  = MatrixRotateZ(ring->roll * DEG2RAD);
+        Matrix matPitch = MatrixRotateX(ring->pitch * DEG2RAD);
+        Matrix matYaw   = MatrixRotateY(ring->yaw * DEG2RAD);
+        Matrix rotation = MatrixMultiply(MatrixMultiply(matRoll, matPitch), matYaw);
+
+        Matrix scale = MatrixScale(ring->radius, ring->radius, ring->radius);
+        Matrix translation = MatrixTranslate(ring->position.x, ring->position.y, ring->position.z);
+
+        race->ringTransforms[i] = MatrixMultiply(MatrixMultiply(rotation, scale), translation);
+
+        // Every ring starts as a "future" ring. The target one is painted GOLD when drawn.
+        SetRingInstanceColor(&race->ringTransforms[i], Fade(LIGHTGRAY, 0.3f));
+    }
+}
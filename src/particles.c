@@ -0,0 +1,223 @@
+// Include math library to use advanced mathematical functions.
+#include <math.h>
+
+// We include our own header file.
+// We also need resource_manager.h for the particle quad and its shader,
+// and rlgl.h to stop the see-through puffs from hiding each other in the depth buffer.
+#include "particles.h"
+#include "resource_manager.h"
+#include "rlgl.h"
+
+
+// --- FACTORY FUNCTION ---
+ParticleSystem CreateParticleSystem(int capacity, float fadePerFrame, float risePerFrame) {
+    ParticleSystem particles = { 0 };
+    particles.fadePerFrame = fadePerFrame;
+    particles.risePerFrame = risePerFrame;
+
+    if (capacity <= 0) {
+        return particles;
+    }
+
+    // Add up the exact size of the 7 float arrays and the GPU instance buffer, then reserve it once.
+    size_t floatArray = sizeof(float) * capacity;
+    particles.arena = CreateArena(ArenaAllocSize(floatArray) * 7 + ArenaAllocSize(sizeof(Matrix) * capacity));
+
+    particles.positionX = (float *)ArenaAlloc(&particles.arena, floatArray);
+    particles.positionY = (float *)ArenaAlloc(&particles.arena, floatArray);
+    particles.positionZ = (float *)ArenaAlloc(&particles.arena, floatArray);
+    particles.velocityX = (float *)ArenaAlloc(&particles.arena, floatArray);
+    particles.velocityY = (float *)ArenaAlloc(&particles.arena, floatArray);
+    particles.velocityZ = (float *)ArenaAlloc(&particles.arena, floatArray);
+    particles.life = (float *)ArenaAlloc(&particles.arena, floatArray);
+    particles.instances = (Matrix *)ArenaAlloc(&particles.arena, sizeof(Matrix) * capacity);
+
+    // The last array only fits if every one before it did.
+    if (particles.instances == NULL) {
+        TraceLog(LOG_WARNING, "PARTICLES: Not enough memory for %d particles", capacity);
+        DestroyArena(&particles.arena);
+        return (ParticleSystem){ 0 };
+    }
+
+    particles.capacity = capacity;
+    return particles;
+}
+
+
+// --- RING BUFFER ALLOCATOR ---
+
+void EmitParticle(ParticleSystem *particles, Vector3 position, Vector3 velocity) {
+    if (particles->capacity == 0) {
+        return;
+    }
+
+    // Full? Then the oldest particle makes room (it was about to fade out anyway).
+    if (particles->count == particles->capacity) {
+        particles->oldest = (particles->oldest + 1) % particles->capacity;
+        particles->count--;
+    }
+
+    // The new particle goes right after the newest one.
+    int i = (particles->oldest + particles->count) % particles->capacity;
+    particles->positionX[i] = position.x;
+    particles->positionY[i] = position.y;
+    particles->positionZ[i] = position.z;
+    particles->velocityX[i] = velocity.x;
+    particles->velocityY[i] = velocity.y;
+    particles->velocityZ[i] = velocity.z;
+    particles->life[i] = 1.0f;
+    particles->count++;
+}
+
+void ClearParticles(ParticleSystem *particles) {
+    particles->oldest = 0;
+    particles->count = 0;
+}
+
+
+// --- UPDATE LOOP ---
+
+// Moves the particles in slots 'start' to 'end - 1'.
+// No branches and no function calls: just the same math over every array, so it vectorizes.
+static void UpdateParticleSpan(ParticleSystem *particles, int start, int end, float dtScale) {
+    float fade = particles->fadePerFrame * dtScale;
+    float rise = particles->risePerFrame * dtScale;
+
+    float *restrict posX = particles->positionX;
+    float *restrict posY = particles->positionY;
+    float *restrict posZ = particles->positionZ;
+    const float *restrict velX = particles->velocityX;
+    const float *restrict velY = particles->velocityY;
+    const float *restrict velZ = particles->velocityZ;
+    float *restrict life = particles->life;
+
+    for (int i = start; i < end; i++) {
+        life[i] -= fade;
+        posY[i] += rise;
+
+        // Apply physical drift.
+        posX[i] += velX[i] * dtScale;
+        posY[i] += velY[i] * dtScale;
+        posZ[i] += velZ[i] * dtScale;
+    }
+}
+
+void UpdateParticles(ParticleSystem *particles, float dt) {
+    // Same 60 Hz time scale used by the physics.
+    float dtScale = dt * 60.0f;
+
+    if (particles->count == 0) {
+        return;
+    }
+
+    // The live block may wrap around the end of the arrays: then it is two straight pieces.
+    int end = particles->oldest + particles->count;
+    if (end <= particles->capacity) {
+        UpdateParticleSpan(particles, particles->oldest, end, dtScale);
+    } else {
+        UpdateParticleSpan(particles, particles->oldest, particles->capacity, dtScale);
+        UpdateParticleSpan(particles, 0, end - particles->capacity, dtScale);
+    }
+
+    // The oldest particles die first, so the dead ones are always at the front of the block.
+    while (particles->count > 0 && particles->life[particles->oldest] <= 0.0f) {
+        particles->oldest = (particles->oldest + 1) % particles->capacity;
+        particles->count--;
+    }
+}
+
+
+// --- RENDERING FUNCTION (3D WORLD) ---
+void DrawParticles(ParticleSystem *particles) {
+    if (particles->count == 0) {
+        return;
+    }
+
+    // 1. Pack every live particle into one 4x4 matrix for the GPU (see PARTICLE_BILLBOARD_VS in shaders.h):
+    //    the position goes in the translation slots (m12, m13, m14), and its life in m0.
+    //    The shader turns the life into the puff's size and transparency.
+    for (int n = 0; n < particles->count; n++) {
+        int i = (particles->oldest + n) % particles->capacity;
+
+        Matrix instance = { 0 };
+        instance.m0 = particles->life[i];
+        instance.m12 = particles->positionX[i];
+        instance.m13 = particles->positionY[i];
+        instance.m14 = particles->positionZ[i];
+        instance.m15 = 1.0f;
+        particles->instances[n] = instance;
+    }
+
+    // 2. One draw call for all of them. The puffs are see-through, so they test against the depth buffer
+    //    (hidden behind mountains and aircraft) but don't write to it (they never cut holes in each other).
+    rlDisableDepthMask();
+    DrawMeshInstanced(particleModel.meshes[0], particleModel.materials[0], particles->instances, particles->count);
+    rlEnableDepthMask();
+}
+
+
+// --- CLEANUP ---
+void UnloadParticleSystem(ParticleSystem *particles) {
+    DestroyArena(&particles->arena);
+    *particles = (ParticleSystem){ 0 };
+}
+
+
+// --- SMOKE TRAILS (EMITTER) ---
+// The smoke doesn't affect the flight at all, so it is kept out of UpdatePlayer().
+// This keeps the simulation core free of random numbers and cheap enough for batch runs.
+void UpdateSmokeTrails(Player *player, ParticleSystem *smoke, float dt) {
+
+    // Same 60 Hz time scale used by the physics.
+    float dtScale = dt * 60.0f;
+
+    if (player->type != VEHICLE_PLANE) {
+        // If it's not the plane, instantly kill all particles.
+        ClearParticles(smoke);
+        player->smokeDelayTimer = 0.0f; // Reset the timer.
+    } else {
+        // If it is the plane, advance the timer.
+        player->smokeDelayTimer += 1.0f  * dtScale;
+
+        // 1. Emit smoke only if accelerating AND 1 second (60 frames) has passed since switching.
+        if (player->throttle < -0.1f && player->smokeDelayTimer > 60.0f) {
+
+            // Calculate the "Right" vector based on where we are looking (Yaw).
+            float rightX =  cosf(player->rotation.y);
+            float rightZ = -sinf(player->rotation.y);
+            float engineOffset = 0.35f; // Distance from the center to each engine.
+
+            // One pair of puffs per 60 Hz frame, whatever the simulation tick rate is.
+            player->smokeEmitTimer += dtScale;
+
+            while (player->smokeEmitTimer >= 1.0f) {
+                player->smokeEmitTimer -= 1.0f;
+
+                // Right engine (1.0) first, then the left engine (-1.0).
+                for (int side = 0; side < 2; side++) {
+                    float sideDir = (side == 0) ? 1.0f : -1.0f;
+
+                    Vector3 position = {
+                        player->position.x + (rightX * engineOffset * sideDir),
+                        player->position.y - 0.15f,
+                        player->position.z + (rightZ * engineOffset * sideDir)
+                    };
+
+                    // Generate a tiny random velocity for horizontal spread (turbulence), plus an upward drift.
+                    Vector3 velocity = {
+                        (float)GetRandomValue(-15, 15) / 1000.0f,
+                        0.02f,
+                        (float)GetRandomValue(-15, 15) / 1000.0f
+                    };
+
+                    EmitParticle(smoke, position, velocity);
+                }
+            }
+        } else {
+            player->smokeEmitTimer = 0.0f;
+        }
+    }
+
+    // 2. Update active particles.
+    UpdateParticles(smoke, dt);
+}
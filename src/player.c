@@ -2,9 +2,11 @@
 #include <math.h>
 
 // We include our own header file.
-// We also need resource_manager.h so this .c file knows about the 'environmentModel'.
+// We also need terrain.h so this .c file can read the ground height and cast rays against the scenario,
+// and profiler.h to time those terrain queries in profiling builds.
 #include "player.h"
-#include "resource_manager.h"
+#include "terrain.h"
+#include "profiler.h"
 
 
 // --- FACTORY FUNCTION ---
@@ -19,11 +21,13 @@ Player InitPlayer(VehicleType type, Vector3 startPos, float startYaw) {
     // Set the starting physical properties based on the level data.
     p.position = startPos;
     p.rotation = (Vector3){ 0.0f, startYaw, 0.0f }; // Set initial yaw (direction the nose is pointing).
+    p.prevPosition = p.position;                    // No previous tick yet, so both poses are the same.
+    p.prevRotation = p.rotation;
     p.velocity = (Vector3){ 0.0f, 0.0f, 0.0f };     // Start completely stationary.
 
     p.throttle = 0.0f;                              // Engine is at 0% power.
-    p.acceleration = 0.010f;                        // Engine power gained per frame when accelerating.
-    p.friction = 0.95f;                             // Air resistance/drag (loses 5% of vertical momentum per frame).
+    p.acceleration = 0.010f;                        // Engine power gained per 60 Hz frame when accelerating.
+    p.friction = 0.95f;                             // Air resistance/drag (loses 5% of vertical momentum per 60 Hz frame).
     
     p.type = type;                                  // Assign the chosen vehicle model (Plane or Helicopter).
     
@@ -38,26 +42,33 @@ Player InitPlayer(VehicleType type, Vector3 startPos, float startYaw) {
 }
 
 
+// --- FRAME-RATE INDEPENDENT SMOOTHING ---
+// All the tuning values of this file were picked for 60 updates per second.
+// A Lerp factor of 0.05f "per 60 Hz frame" becomes this factor for a step of 'dtScale' frames,
+// so the smoothing looks exactly the same no matter how often we update.
+static float ScaleLerpFactor(float perFrameFactor, float dtScale) {
+    return 1.0f - powf(1.0f - perFrameFactor, dtScale);
+}
+
+
 // --- UPDATE LOOP ---
-// This function runs 60 times per second to update the vehicle's physics and visual tilt.
+// This function runs SIM_TICK_RATE times per second (fixed steps) to update the vehicle's physics and visual tilt.
 // We pass a POINTER (*player) so we edit the actual player in main.c, not a local copy.
-void UpdatePlayer(Player *player) {
+// The controls come already sampled in 'input', so this function never touches the hardware.
+void UpdatePlayer(Player *player, const PilotInput *input, float dt) {
     
     // --- 0. DELTA TIME (TIME SCALE) ---
-    // GetFrameTime() tells us the real time passed since last frame.
-    // By multiplying it by 60.0f, we get a scale factor.
-    float dtScale = GetFrameTime() * 60.0f;
+    // 'dt' is the fixed duration of one simulation tick in seconds.
+    // By multiplying it by 60.0f, we get a scale factor relative to the 60 Hz tuning values.
+    float dtScale = dt * 60.0f;
+
+    // Remember where we were before this tick, so the renderer can interpolate between both poses.
+    player->prevPosition = player->position;
+    player->prevRotation = player->rotation;
 
     // --- 1. THROTTLE (ENGINE POWER) ---
-    // Keyboard inputs.
-    if (IsKeyDown(KEY_W)) player->throttle -= player->acceleration; 
-    if (IsKeyDown(KEY_S)) player->throttle += player->acceleration;
-
-    // Gamepad inputs (RT to accelerate, LT to brake/reverse).
-    if (IsGamepadAvailable(0)) {
-        if (IsGamepadButtonDown(0, GAMEPAD_BUTTON_RIGHT_TRIGGER_2)) player->throttle -= player->acceleration;
-        if (IsGamepadButtonDown(0, GAMEPAD_BUTTON_LEFT_TRIGGER_2))  player->throttle += player->acceleration;
-    }
+    // Remember: a NEGATIVE throttle moves the vehicle forward (the nose points to -Z).
+    player->throttle -= player->acceleration * input->throttle * dtScale;
 
     // Limit the throttle based on the vehicle type so it doesn't accelerate to infinity.
     if (player->type == VEHICLE_PLANE) {
@@ -80,26 +91,10 @@ void UpdatePlayer(Player *player) {
     float targetRoll = 0.0f;  // Roll: Tilting wings left/right.
     float targetPitch = 0.0f; // Pitch: Pointing nose up/down.
 
-    // Keyboard Yaw (A/D)
-    if (IsKeyDown(KEY_A)) {
-        player->rotation.y += 0.02f * dtScale; // Rotate nose left.
-        targetRoll = 0.4f;                     // Target tilt left.
-    }
-    if (IsKeyDown(KEY_D)) {
-        player->rotation.y -= 0.02f * dtScale; // Rotate nose right.
-        targetRoll = -0.4f;                    // Target tilt right.
-    }
-
-    // Gamepad yaw/roll (Left stick x-axis).
-    if (IsGamepadAvailable(0)) {
-        float leftX = GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_X);
-        
-        // Deadzone check: We ignore inputs smaller than 0.15f to prevent stick drift.
-        if (fabsf(leftX) > 0.15f) {
-            player->rotation.y -= leftX * 0.02f * dtScale; 
-            targetRoll = -leftX * 0.4f;          
-        }
-    }
+    // Yaw: positive turns the nose left, negative turns it right.
+    // The wings tilt towards the turn (up to 0.4 radians).
+    player->rotation.y += input->yaw * 0.02f * dtScale;
+    targetRoll = input->yaw * 0.4f;
 
 
     // --- 3. CALCULATE VELOCITY DIRECTION VECTOR (TRIGONOMETRY) ---
@@ -110,9 +105,9 @@ void UpdatePlayer(Player *player) {
 
 
     // --- 4. PHYSICS: GRAVITY & LIFT ---
-    // A constant downward force pulling the vehicle to the ground every frame.
+    // A constant downward force pulling the vehicle to the ground (0.015f per 60 Hz frame).
     float gravity = 0.015f;
-    player->velocity.y -= gravity; 
+    player->velocity.y -= gravity * dtScale; 
 
     if (player->type == VEHICLE_PLANE) {
         // --- PLANE PHYSICS ---
@@ -124,58 +119,36 @@ void UpdatePlayer(Player *player) {
 
         // Generate lift based on speed to counteract gravity.
         float lift = forwardSpeed * 0.030f; 
-        player->velocity.y += lift;
+        player->velocity.y += lift * dtScale;
 
         // Pitch up/down only works well if we have forward speed (airflow over the wings).
-        // Keyboard pitch.
-        if (IsKeyDown(KEY_SPACE)) {
-            player->velocity.y += forwardSpeed * 0.05f; // Use speed to climb.
-            targetPitch = 0.3f;                         
-        }
-        if (IsKeyDown(KEY_LEFT_SHIFT)) {
-            player->velocity.y -= forwardSpeed * 0.05f; // Dive.
-            targetPitch = -0.3f;                        
-        }
-
-        // Gamepad pitch (Left stick y-axis).
-        // In aviation: Pulling stick BACK (positive Y) raises the nose. 
-        if (IsGamepadAvailable(0)) {
-            float leftY = GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_Y);
-            if (fabsf(leftY) > 0.15f) {
-                player->velocity.y += forwardSpeed * 0.05f * leftY;
-                targetPitch = 0.3f * leftY;
-            }
+        // Positive pitch uses the speed to climb, negative pitch dives.
+        if (input->pitch != 0.0f) {
+            player->velocity.y += forwardSpeed * 0.05f * input->pitch * dtScale;
+            targetPitch = 0.3f * input->pitch;
         }
     }
 
     else if (player->type == VEHICLE_HELICOPTER) {
         // --- HELICOPTER PHYSICS ---
         // Helicopters don't need forward speed to fly, they use raw rotor power.
-        if (IsKeyDown(KEY_SPACE)) {
+        if (input->pitch > 0.0f) {
             // Rotor thrust must be stronger than gravity to climb.
-            player->velocity.y += player->acceleration * 3.0f;
-            targetPitch = 0.15f;
+            player->velocity.y += player->acceleration * 3.0f * input->pitch * dtScale;
         }
-        if (IsKeyDown(KEY_LEFT_SHIFT)) {
+        if (input->pitch < 0.0f) {
             // Reduce collective (drop faster than normal gravity).
-            player->velocity.y -= player->acceleration * 2.0f;
-            targetPitch = -0.15f;
-        }
-
-        // Gamepad pitch (Left stick y-axis)
-        if (IsGamepadAvailable(0)) {
-            float leftY = GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_Y);
-            if (fabsf(leftY) > 0.15f) {
-                player->velocity.y += player->acceleration * 3.0f * leftY;
-                targetPitch = 0.15f * leftY;
-            }
+            // Same rate for the keys and the stick (see ReadPilotInput in main.c).
+            player->velocity.y += player->acceleration * 2.0f * input->pitch * dtScale;
         }
+        targetPitch = 0.15f * input->pitch;
     }
 
 
     // --- 5. APPLY FRICTION (MOMENTUM DECAY) ---
     // We only apply friction to the Y axis (vertical). X and Z are engine-driven.
-    player->velocity.y *= player->friction;
+    // Losing 5% per 60 Hz frame is the same as multiplying by 0.95 raised to the number of frames.
+    player->velocity.y *= powf(player->friction, dtScale);
 
 
     // --- 6. ADVANCED COLLISION DETECTION (DUAL RAYCASTING) ---
@@ -184,10 +157,9 @@ void UpdatePlayer(Player *player) {
     forwardRay.position = player->position;
     forwardRay.direction = GetPlayerForwardVector(player);
 
-    // B) Satellite Ray (Ground detection): Shoots from 1000 units directly downwards.
-    Ray downRay = { 0 };
-    downRay.position = (Vector3){ player->position.x, 1000.0f, player->position.z };
-    downRay.direction = (Vector3){ 0.0f, -1.0f, 0.0f };
+    // B) Ground detection: the terrain was rasterized into a height grid at load time,
+    // so the height under the aircraft is a bilinear lookup instead of a ray straight down.
+    // (Set 'terrainExactGround' to go back to the exact satellite raycast.)
 
     // Crash conditions.
     bool hasCrashed = false;
@@ -196,23 +168,22 @@ void UpdatePlayer(Player *player) {
     // so the mathematical floor is exactly at Y = 0.
     float groundHeight = 0.0f; 
 
-    for (int i = 0; i < environmentModel.meshCount; i++) {
-        // Check forward crash.
-        RayCollision forwardHit = GetRayCollisionMesh(forwardRay, environmentModel.meshes[i], environmentModel.transform);
-        if (forwardHit.hit && forwardHit.distance < 2.0f) {
-            hasCrashed = true;
-        }
+    // Both terrain queries show up as one block in the frame profiler.
+    PROFILE_BEGIN(terrainScope, "TerrainRaycasts");
 
-        // Check 3D floor underneath.
-        RayCollision groundHit = GetRayCollisionMesh(downRay, environmentModel.meshes[i], environmentModel.transform);
-        if (groundHit.hit) {
-            // Keep the highest ground point found (in case meshes overlap).
-            if (groundHit.point.y > groundHeight) {
-                groundHeight = groundHit.point.y;
-            }
-        }
+    // Check forward crash through the terrain BVH. We only care about mountains closer than 2.0f.
+    RayCollision forwardHit = GetRayCollisionTerrain(forwardRay, 2.0f);
+    if (forwardHit.hit) {
+        hasCrashed = true;
     }
 
+    // Check 3D floor underneath (terrain below Y = 0 never lowers the floor).
+    float terrainHeight = GetTerrainHeight(player->position.x, player->position.z);
+    if (terrainHeight > groundHeight) {
+        groundHeight = terrainHeight;
+    }
+    PROFILE_END(terrainScope);
+
     // Crash logic: Kill the engine and PUSH BACK.
     if (hasCrashed) {
         player->velocity = (Vector3){ 0.0f, 0.0f, 0.0f };
@@ -234,8 +205,8 @@ void UpdatePlayer(Player *player) {
 
     // --- 8. SMOOTH INTERPOLATION ---
     // Lerp gradually changes the current rotation towards the target rotation over time.
-    player->rotation.x = Lerp(player->rotation.x, targetPitch, 0.05f);
-    player->rotation.z = Lerp(player->rotation.z, targetRoll, 0.05f);
+    player->rotation.x = Lerp(player->rotation.x, targetPitch, ScaleLerpFactor(0.05f, dtScale));
+    player->rotation.z = Lerp(player->rotation.z, targetRoll, ScaleLerpFactor(0.05f, dtScale));
 
 
     // --- 9. DYNAMIC FLOOR COLLISION ---
@@ -251,7 +222,7 @@ void UpdatePlayer(Player *player) {
         }
         
         // When touching the ground, smoothly force the nose back to a level position.
-        player->rotation.x = Lerp(player->rotation.x, 0.0f, 0.1f);
+        player->rotation.x = Lerp(player->rotation.x, 0.0f, ScaleLerpFactor(0.1f, dtScale));
         
         // Zero-floor throttle kill.
         // If the player touches the absolute bottom (Y = 0, which means safeFloor is 0.5f).
@@ -260,164 +231,6 @@ void UpdatePlayer(Player *player) {
             player->throttle = 0.0f;
         }
     }
-
-    // --- 10. PARTICLE SYSTEM (TWIN SMOKE TRAILS) ---
-    if (player->type != VEHICLE_PLANE) {
-        // If it's not the plane, instantly kill all particles.
-        for (int i = 0; i < MAX_PARTICLES; i++) {
-            player->smoke[i].active = false;
-        }
-        player->smokeDelayTimer = 0.0f; // Reset the timer.
-    } else {
-        // If it is the plane, advance the timer.
-        player->smokeDelayTimer += 1.0f  * dtScale;
-        
-        // 1. Emit smoke only if accelerating AND 1 second (60 frames) has passed since switching.
-        if (player->throttle < -0.1f && player->smokeDelayTimer > 60.0f) {
-            
-            // Calculate the "Right" vector based on where we are looking (Yaw).
-            float rightX =  cosf(player->rotation.y);
-            float rightZ = -sinf(player->rotation.y);
-            float engineOffset = 0.35f; // Distance from the center to each engine.
-            
-            int spawned = 0;
-            
-            for (int i = 0; i < MAX_PARTICLES; i++) {
-                if (!player->smoke[i].active) {
-                    player->smoke[i].active = true;
-                    player->smoke[i].life = 1.0f; 
-                    
-                    // If spawned is 0, right engine (1.0). If 1, left engine (-1.0).
-                    float sideDir;
-                    
-                    if (spawned == 0) {
-                        sideDir = 1.0f;
-                    } else {
-                        sideDir = -1.0f;
-                    }
-                    
-                    player->smoke[i].position = (Vector3){ 
-                        player->position.x + (rightX * engineOffset * sideDir), 
-                        player->position.y - 0.15f, 
-                        player->position.z + (rightZ * engineOffset * sideDir) 
-                    };
-
-                    // Generate a tiny random velocity for horizontal spread (turbulence).
-                    player->smoke[i].velocity.x = (float)GetRandomValue(-15, 15) / 1000.0f;
-                    player->smoke[i].velocity.y = 0.02f; // Upward drift.
-                    player->smoke[i].velocity.z = (float)GetRandomValue(-15, 15) / 1000.0f;
-                    
-                    spawned++;
-                    if (spawned >= 2) break; // Exit the loop once both particles have spawned.
-                }
-            }
-        }
-    }
-
-    // 2. Update active particles.
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        if (player->smoke[i].active) {
-            player->smoke[i].life -= 0.02f; 
-            player->smoke[i].position.y += 0.02f;
-
-            // Apply physical drift.
-            player->smoke[i].position.x += player->smoke[i].velocity.x * dtScale;
-            player->smoke[i].position.y += player->smoke[i].velocity.y * dtScale;
-            player->smoke[i].position.z += player->smoke[i].velocity.z * dtScale;
-            
-            if (player->smoke[i].life <= 0.0f) {
-                player->smoke[i].active = false;
-            }
-        }
-    }
-}
-
-
-// --- DYNAMIC CAMERA ---
-// Handles the mathematics for spherical orbit (3rd person) and cockpit view (1st person).
-void UpdateDynamicCamera(Camera3D *camera, Player *player) {
-    
-    // Toggle camera mode when pressing 'C' (Keyboard) or 'A' (Gamepad).
-    if (IsKeyPressed(KEY_C) || (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
-        player->isFirstPerson = !player->isFirstPerson;
-    }
-
-    if (!player->isFirstPerson) {
-        // --- 3RD PERSON ORBIT LOGIC ---
-        
-        if (IsGamepadAvailable(0)) {
-            // Gamepad: Absolute positioning based on right thumbstick tilt.
-            float smoothFactor = 0.1f;
-
-            float rightStickX = GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_X);
-            float rightStickY = GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_Y);
-
-            // Deadzone check.
-            if (fabsf(rightStickX) < 0.15f) rightStickX = 0.0f;
-            if (fabsf(rightStickY) < 0.15f) rightStickY = 0.0f;
-
-            float targetYaw = -rightStickX * 2.5f; 
-            float targetPitch = rightStickY * 1.5f; 
-
-            player->cameraAngleYaw = Lerp(player->cameraAngleYaw, targetYaw, smoothFactor);
-            player->cameraAnglePitch = Lerp(player->cameraAnglePitch, targetPitch, smoothFactor);
-            
-        } else {
-            // Keyboard: Relative positioning using arrow keys.
-            float smoothFactor = 0.3f; 
-            
-            float targetYaw = player->cameraAngleYaw;
-            float targetPitch = player->cameraAnglePitch;
-
-            if (IsKeyDown(KEY_RIGHT)) targetYaw -= 0.08f;
-            if (IsKeyDown(KEY_LEFT))  targetYaw += 0.08f;
-            if (IsKeyDown(KEY_UP))    targetPitch -= 0.08f;
-            if (IsKeyDown(KEY_DOWN))  targetPitch += 0.08f;
-
-            // Auto-centering mechanism.
-            if (!IsKeyDown(KEY_RIGHT) && !IsKeyDown(KEY_LEFT)) targetYaw *= 0.90f;
-            if (!IsKeyDown(KEY_UP) && !IsKeyDown(KEY_DOWN))    targetPitch *= 0.90f;
-
-            // Clamp the target angles to prevent clipping.
-            if (targetPitch > 1.5f)  targetPitch = 1.5f;
-            if (targetPitch < -0.5f) targetPitch = -0.5f;
-            if (targetYaw > 2.5f)    targetYaw = 2.5f;
-            if (targetYaw < -2.5f)   targetYaw = -2.5f;
-
-            player->cameraAngleYaw = Lerp(player->cameraAngleYaw, targetYaw, smoothFactor);
-            player->cameraAnglePitch = Lerp(player->cameraAnglePitch, targetPitch, smoothFactor);
-        }
-    } else {
-        // Reset manual orbit angles when switching to First Person view for a clean transition.
-        player->cameraAngleYaw = player->rotation.y; 
-        player->cameraAnglePitch = 0.0f;
-    }
-
-    // --- APPLY CAMERA TRANSFORMATIONS ---
-    if (player->isFirstPerson) {
-        // 1st person (Cockpit).
-        camera->position = (Vector3){ player->position.x, player->position.y + 0.5f, player->position.z };
-        
-        // Calculate exactly where the nose of the vehicle is pointing using trigonometry.
-        camera->target.x = camera->position.x - (sinf(player->rotation.y) * cosf(player->rotation.x));
-        camera->target.y = camera->position.y +  sinf(player->rotation.x); 
-        camera->target.z = camera->position.z - (cosf(player->rotation.y) * cosf(player->rotation.x));
-        
-    } else {
-        // 3rd person (Orbit chase camera).
-        camera->target = player->position;
-        float cameraDistance = 4.0f;
-        float cameraHeight = 1.5f; 
-
-        // Combine player rotation with manual orbit input.
-        float totalYaw = player->rotation.y + player->cameraAngleYaw;
-        float totalPitch = player->cameraAnglePitch;
-
-        // Spherical coordinates calculation.
-        camera->position.x = player->position.x + (sinf(totalYaw) * cosf(totalPitch) * cameraDistance);
-        camera->position.y = player->position.y + (sinf(totalPitch) * cameraDistance) + cameraHeight;
-        camera->position.z = player->position.z + (cosf(totalYaw) * cosf(totalPitch) * cameraDistance);
-    }
 }
 
 
@@ -428,4 +241,17 @@ Vector3 GetPlayerForwardVector(Player *player) {
          sinf(player->rotation.x), 
         -cosf(player->rotation.y) * cosf(player->rotation.x) 
     };
-}
\ No newline at end of file
+}
+
+
+// --- RENDER INTERPOLATION ---
+// Returns a copy of the player placed between the previous and the current simulation tick.
+// alpha = 0.0f is the previous tick, alpha = 1.0f is the latest one.
+Player GetInterpolatedPlayer(const Player *player, float alpha) {
+    Player renderPlayer = *player;
+
+    renderPlayer.position = Vector3Lerp(player->prevPosition, player->position, alpha);
+    renderPlayer.rotation = Vector3Lerp(player->prevRotation, player->rotation, alpha);
+
+    return renderPlayer;
+}
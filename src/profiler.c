@@ -0,0 +1,133 @@
+// We include our own header file.
+#include "profiler.h"
+
+// Without GABRIEL_PROFILER this whole file compiles to nothing.
+#if defined(GABRIEL_PROFILER)
+
+// Include standard libraries for file output and the monotonic clock.
+#include <stdio.h>
+#include <time.h>
+
+
+// --- PROFILER STATE ---
+// One recorded block. 'sequence' is the slot's ticket number + 1 once its data is complete
+// (0 = never written), which is how the exporter knows the slot isn't half-written.
+typedef struct ProfileEvent {
+    const char *name;
+    uint64_t start;             // Nanoseconds.
+    uint64_t duration;
+    uint32_t thread;            // Small number given to each thread the first time it records.
+    uint32_t unused;
+    uint64_t sequence;
+} ProfileEvent;
+
+// 'static' keeps these private to this file. No lock anywhere: every thread that records takes
+// a ticket with one atomic add, and the ticket says which slot of the ring it may write.
+static struct {
+    ProfileEvent events[PROFILER_CAPACITY];
+    uint64_t nextTicket;        // Tickets handed out so far.
+    uint32_t threadCount;       // Thread numbers handed out so far.
+    uint64_t epoch;             // Clock when the first block started (the trace starts at 0).
+} profiler = { 0 };
+
+// Each thread remembers its own number (0 = not given yet).
+static __thread uint32_t threadNumber = 0;
+
+
+// --- CLOCK ---
+// Monotonic wall clock in nanoseconds (Raylib's GetTime() needs a window, and headless tools record too).
+static uint64_t ProfilerNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+
+// --- RECORDING ---
+ProfileScope BeginProfileScope(const char *name) {
+    ProfileScope scope;
+    scope.name = name;
+    scope.start = ProfilerNow();
+    scope.isOpen = true;
+
+    // The first block to START sets the zero of the trace. Taking it when the first block ends
+    // would pick a nested block (they always end first) and leave the enclosing "Frame" before 0.
+    if (__atomic_load_n(&profiler.epoch, __ATOMIC_RELAXED) == 0) {
+        uint64_t expected = 0;
+        __atomic_compare_exchange_n(&profiler.epoch, &expected, scope.start, false,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+    return scope;
+}
+
+void EndProfileScope(ProfileScope *scope) {
+    uint64_t end = ProfilerNow();
+    scope->isOpen = false;
+
+    if (threadNumber == 0) {
+        threadNumber = __atomic_add_fetch(&profiler.threadCount, 1, __ATOMIC_RELAXED);
+    }
+
+    // Take a ticket, mark the slot as being written, fill it, then publish it.
+    uint64_t ticket = __atomic_fetch_add(&profiler.nextTicket, 1, __ATOMIC_RELAXED);
+    ProfileEvent *event = &profiler.events[ticket & (PROFILER_CAPACITY - 1)];
+
+    __atomic_store_n(&event->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&event->name, scope->name, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->start, scope->start, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->duration, end - scope->start, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->thread, threadNumber, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->sequence, ticket + 1, __ATOMIC_RELEASE);
+}
+
+
+// --- EXPORT ---
+// Reads a slot if it still holds ticket 'ticket' from start to end (a writer may lap us meanwhile).
+static bool ReadEvent(uint64_t ticket, ProfileEvent *outEvent) {
+    ProfileEvent *event = &profiler.events[ticket & (PROFILER_CAPACITY - 1)];
+
+    if (__atomic_load_n(&event->sequence, __ATOMIC_ACQUIRE) != ticket + 1) return false;
+    outEvent->name = __atomic_load_n(&event->name, __ATOMIC_RELAXED);
+    outEvent->start = __atomic_load_n(&event->start, __ATOMIC_RELAXED);
+    outEvent->duration = __atomic_load_n(&event->duration, __ATOMIC_RELAXED);
+    outEvent->thread = __atomic_load_n(&event->thread, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&event->sequence, __ATOMIC_RELAXED) == ticket + 1;
+}
+
+int ExportProfileTrace(const char *fileName) {
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    // Everything handed out before this moment that is still in the ring.
+    uint64_t lastTicket = __atomic_load_n(&profiler.nextTicket, __ATOMIC_ACQUIRE);
+    uint64_t firstTicket = (lastTicket > PROFILER_CAPACITY) ? lastTicket - PROFILER_CAPACITY : 0;
+    uint64_t epoch = __atomic_load_n(&profiler.epoch, __ATOMIC_RELAXED);
+
+    // Chrome's "complete" events ("ph":"X"): a name, a start and a duration in microseconds.
+    // Blocks nested inside others (the terrain raycasts inside UpdatePlayer) show up stacked.
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    int written = 0;
+    for (uint64_t ticket = firstTicket; ticket < lastTicket; ticket++) {
+        ProfileEvent event;
+        if (!ReadEvent(ticket, &event)) continue; // Still being written, or already overwritten.
+
+        // Signed: if two threads raced for the epoch, the loser's first block starts slightly before 0.
+        int64_t start = (int64_t)(event.start - epoch);
+
+        fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                (written > 0) ? ",\n" : "", event.name, event.thread,
+                start / 1000.0, event.duration / 1000.0);
+        written++;
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    return written;
+}
+
+#endif
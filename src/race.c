@@ -9,57 +9,36 @@
 #include "race.h"
 #include "mission_rings.h"
 #include "mission_landing.h"
+#include "level_binary.h"
 
 
-// --- OUTLINED TEXT ---
-void DrawTextOutlined(const char *text, int posX, int posY, int fontSize, Color color, int outlineSize) {
-    DrawText(text, posX - outlineSize, posY, fontSize, BLACK);
-    DrawText(text, posX + outlineSize, posY, fontSize, BLACK);
-    DrawText(text, posX, posY - outlineSize, fontSize, BLACK);
-    DrawText(text, posX, posY + outlineSize, fontSize, BLACK);
-    DrawText(text, posX - outlineSize, posY - outlineSize, fontSize, BLACK);
-    DrawText(text, posX + outlineSize, posY - outlineSize, fontSize, BLACK);
-    DrawText(text, posX - outlineSize, posY + outlineSize, fontSize, BLACK);
-    DrawText(text, posX + outlineSize, posY + outlineSize, fontSize, BLACK);
-    DrawText(text, posX, posY, fontSize, color);
-}
+// --- FACTORY FUNCTION (THE MISSION BUILDER) ---
+// This acts as the "Track Designer". Instead of hardcoding the missions in C,
+// it dynamically loads the level from the hard drive based on the levelID.
+// The text file (levels/lvlN.txt) is what we write by hand; the level compiler turns it into
+// levels/lvlN.bin, which is mapped straight into memory with no parsing at all.
+// If the binary is missing, damaged or older than the text, the text is parsed as before.
+RaceSystem InitRace(int levelID) {
+    // We use our own buffers instead of TextFormat() because TextFormat() shares a few
+    // internal buffers, and headless tools build many races at once from different threads.
+    char textFile[64];
+    char binaryFile[64];
+    snprintf(textFile, sizeof(textFile), "levels/lvl%d.txt", levelID);
+    snprintf(binaryFile, sizeof(binaryFile), "levels/lvl%d.bin", levelID);
 
-// --- NAVIGATION ARROW ---
-void DrawNavArrow(Player *player, Vector3 targetPos) {
-    // 1. Get the direction the player is looking using our new centralized function.
-    Vector3 forwardVec = GetPlayerForwardVector(player);
-    
-    // 2. Position the hologram slightly above and in front of the cockpit.
-    float bounceOffset = sinf(GetTime() * 5.0f) * 0.1f; 
-    Vector3 arrowCenter = { 
-        player->position.x + (forwardVec.x * 2.0f), 
-        player->position.y + 1.2f + bounceOffset + (forwardVec.y * 2.0f), 
-        player->position.z + (forwardVec.z * 2.0f) 
-    };
-    
-    // 3. Mathematical calculation of the pointing vector and wings.
-    Vector3 dir = Vector3Normalize(Vector3Subtract(targetPos, arrowCenter));
-    Vector3 worldUp = { 0.0f, 1.0f, 0.0f };
-    Vector3 rightDir = Vector3Normalize(Vector3CrossProduct(dir, worldUp));
-    
-    Vector3 arrowTail = Vector3Subtract(arrowCenter, Vector3Scale(dir, 0.5f));
-    Vector3 arrowTip = Vector3Add(arrowCenter, Vector3Scale(dir, 0.5f));
-    Vector3 headBase = Vector3Subtract(arrowTip, Vector3Scale(dir, 0.4f)); 
-    
-    Vector3 leftWing = Vector3Add(headBase, Vector3Scale(rightDir, 0.25f));
-    Vector3 rightWing = Vector3Subtract(headBase, Vector3Scale(rightDir, 0.25f));
-    
-    // 4. Draw the 3D model.
-    DrawCylinderEx(arrowTail, arrowTip, 0.03f, 0.03f, 6, RED); 
-    DrawCylinderEx(leftWing, arrowTip, 0.03f, 0.03f, 6, RED);  
-    DrawCylinderEx(rightWing, arrowTip, 0.03f, 0.03f, 6, RED); 
+    RaceSystem race = { 0 };
+    if (LoadLevelBinary(binaryFile, textFile, &race)) {
+        // Same starting referee state as LoadRaceText() (everything else is already 0).
+        race.isRaceActive = true;
+        return race;
+    }
+
+    return LoadRaceText(textFile);
 }
 
 
-// --- FACTORY FUNCTION (THE MISSION BUILDER) ---
-// This acts as the "Track Designer". Instead of hardcoding the missions in C,
-// it dynamically reads a text file from the hard drive based on the levelID.
-RaceSystem InitRace(int levelID) {
+// --- TEXT LEVEL PARSER ---
+RaceSystem LoadRaceText(const char *filename) {
     RaceSystem race = { 0 };
     
     // 1. Setup the global Referee rules (Default starting state).
@@ -68,10 +47,7 @@ RaceSystem InitRace(int levelID) {
     race.isRaceActive = true;  
     race.isFinished = false;   
 
-    // 2. Build the filename string dynamically (e.g., "levels/lvl1.txt").
-    const char *filename = TextFormat("levels/lvl%d.txt", levelID);
-    
-    // 3. Open the file in Read ("r") mode.
+    // 2. Open the file in Read ("r") mode.
     FILE *file = fopen(filename, "r");
     
     if (file != NULL) {
@@ -95,18 +71,20 @@ RaceSystem InitRace(int levelID) {
             int ringCount = 0;
             
             // Read how many rings are in this level.
-            if (fscanf(file, "%d", &ringCount) == 1) {
+            if (fscanf(file, "%d", &ringCount) == 1 && ringCount > 0) {
+                race.declaredRings = ringCount;
                 
-                // Safety Check: Prevent buffer overflow if the file has too many rings.
-                if (ringCount > MAX_RINGS) {
-                    ringCount = MAX_RINGS;
+                // Reserve exactly the RAM this circuit needs, in ONE block, for all its ring arrays.
+                if (!AllocateRaceRings(&race, ringCount)) {
+                    TraceLog(LOG_WARNING, "RACE: Not enough memory for the %d rings of [%s]", ringCount, filename);
+                    ringCount = 0;
                 }
-                race.totalRings = ringCount;
 
                 // Loop through the file and read the properties for each ring.
+                // If the file ends early, the circuit simply ends at the last complete ring.
                 for (int i = 0; i < ringCount; i++) {
                     // fscanf reads the 7 floats separated by spaces.
-                    fscanf(file, "%f %f %f %f %f %f %f", 
+                    int fieldsRead = fscanf(file, "%f %f %f %f %f %f %f", 
                         &race.rings[i].position.x,
                         &race.rings[i].position.y,
                         &race.rings[i].position.z,
@@ -114,8 +92,20 @@ RaceSystem InitRace(int levelID) {
                         &race.rings[i].pitch,
                         &race.rings[i].yaw,
                         &race.rings[i].roll);
+
+                    if (fieldsRead != 7) {
+                        break;
+                    }
                     
                     race.rings[i].active = true; // Mark the ring as ready to be crossed.
+                    race.totalRings++;
+                }
+
+                // Rings never move, so their 3D transforms and collision data are calculated once, right here.
+                BuildRingTransforms(&race);
+                BuildRingFrames(&race);
+                if (!BuildRingGrid(&race)) {
+                    TraceLog(LOG_WARNING, "RACE: Not enough memory for the ring grid of [%s]", filename);
                 }
             }
         }
@@ -153,6 +143,7 @@ RaceSystem InitRace(int levelID) {
             // Initialize anti-crash variables.
             race.prevSpeed = 0.0f;
             race.missionFailed = false;
+            race.failReason = FAIL_NONE;
         }
         
         // Always close the file when you are done to free Operating System memory resources.
@@ -164,14 +155,171 @@ RaceSystem InitRace(int levelID) {
 }
 
 
+// --- RING STORAGE ---
+// Every ring array of the circuit is carved out of ONE block of memory, sized exactly for 'ringCount'.
+// The order below is also the layout of the compiled level files (see level_binary.h), so a
+// mapped file can be carved with the very same function.
+size_t GetRaceRingsSize(int ringCount) {
+    size_t floatArray = sizeof(float) * ringCount;
+
+    // Add up the exact size of every array (9 float arrays for the collision data).
+    return ArenaAllocSize(sizeof(Ring) * ringCount) +
+           ArenaAllocSize(sizeof(Matrix) * ringCount) +
+           ArenaAllocSize(floatArray) * 9;
+}
+
+bool CarveRaceRings(RaceSystem *race, MemoryArena *arena, int ringCount) {
+    size_t floatArray = sizeof(float) * ringCount;
+
+    race->rings = (Ring *)ArenaAlloc(arena, sizeof(Ring) * ringCount);
+    race->ringTransforms = (Matrix *)ArenaAlloc(arena, sizeof(Matrix) * ringCount);
+
+    RingFrames *frames = &race->ringFrames;
+    frames->centerX = (float *)ArenaAlloc(arena, floatArray);
+    frames->centerY = (float *)ArenaAlloc(arena, floatArray);
+    frames->centerZ = (float *)ArenaAlloc(arena, floatArray);
+    frames->normalX = (float *)ArenaAlloc(arena, floatArray);
+    frames->normalY = (float *)ArenaAlloc(arena, floatArray);
+    frames->normalZ = (float *)ArenaAlloc(arena, floatArray);
+    frames->radius = (float *)ArenaAlloc(arena, floatArray);
+    frames->tubeThickness = (float *)ArenaAlloc(arena, floatArray);
+    frames->boundRadiusSqr = (float *)ArenaAlloc(arena, floatArray);
+
+    race->declaredRings = ringCount;
+    race->totalRings = 0;
+    race->targetRing = 0;
+
+    // The last array only fits if every one before it did.
+    return frames->boundRadiusSqr != NULL;
+}
+
+bool AllocateRaceRings(RaceSystem *race, int ringCount) {
+    race->ringArena = CreateArena(GetRaceRingsSize(ringCount));
+
+    if (!CarveRaceRings(race, &race->ringArena, ringCount)) {
+        UnloadRace(race);
+        return false;
+    }
+    return true;
+}
+
+
+// --- CLEANUP ---
+// Frees the ring arena (or the mapped level file) and the ring grid. The struct keeps working afterwards as an empty mission.
+void UnloadRace(RaceSystem *race) {
+    UnloadRingGrid(&race->ringGrid);
+    DestroyArena(&race->ringArena);
+    UnloadLevelBinary(race);
+    race->rings = NULL;
+    race->ringTransforms = NULL;
+    race->ringFrames = (RingFrames){ 0 };
+    race->totalRings = 0;
+    race->targetRing = 0;
+}
+
+
+// --- RESTART FROM A TEMPLATE ---
+// Turns 'race' into an exact copy of 'raceTemplate' as it was when the level loaded.
+// Everything is a flat memory copy: the struct itself, then the ring block and the grid block.
+// The first restore reserves race's own blocks; restoring the same level again reuses them.
+void RestoreRace(RaceSystem *race, const RaceSystem *raceTemplate) {
+    size_t ringBytes = (raceTemplate->rings != NULL) ? GetRaceRingsSize(raceTemplate->declaredRings) : 0;
+    size_t gridBytes = raceTemplate->ringGrid.arena.used;
+
+    // 1. Reserve (or reuse) blocks exactly as big as the template's.
+    MemoryArena ringArena = race->ringArena;
+    MemoryArena gridArena = race->ringGrid.arena;
+    race->ringArena = (MemoryArena){ 0 };
+    race->ringGrid.arena = (MemoryArena){ 0 };
+
+    if (ringArena.capacity != ringBytes) {
+        DestroyArena(&ringArena);
+        ringArena = CreateArena(ringBytes);
+    }
+    if (gridArena.capacity != gridBytes) {
+        DestroyArena(&gridArena);
+        gridArena = CreateArena(gridBytes);
+    }
+
+    // A race restored before owns no mapped file, but one built by InitRace() might.
+    UnloadRace(race);
+
+    if ((ringBytes > 0 && ringArena.base == NULL) || (gridBytes > 0 && gridArena.base == NULL)) {
+        TraceLog(LOG_WARNING, "RACE: Not enough memory to restart the circuit");
+        DestroyArena(&ringArena);
+        DestroyArena(&gridArena);
+        *race = (RaceSystem){ 0 };
+        return;
+    }
+
+    // 2. Copy every value of the template (timers, landing pad, counters...).
+    //    Its pointers still lead into the template's memory, so they are replaced below.
+    *race = *raceTemplate;
+    race->levelMapping = NULL;
+    race->levelMappingSize = 0;
+    race->ringArena = ringArena;
+    race->ringGrid.arena = gridArena;
+
+    // 3. The ring arrays: same layout as the template (CarveRaceRings always uses the same order),
+    //    so the whole block is ONE copy, whether the template lives on the heap or in a mapped file.
+    if (ringBytes > 0) {
+        ResetArena(&race->ringArena);
+        CarveRaceRings(race, &race->ringArena, raceTemplate->declaredRings);
+        memcpy(race->ringArena.base, raceTemplate->rings, ringBytes);
+        race->totalRings = raceTemplate->totalRings;
+    }
+
+    // 4. The grid: one copy, then its two arrays are moved to the same spots inside our block.
+    if (gridBytes > 0) {
+        const unsigned char *templateBase = raceTemplate->ringGrid.arena.base;
+        memcpy(race->ringGrid.arena.base, templateBase, gridBytes);
+        race->ringGrid.arena.used = gridBytes;
+        race->ringGrid.bucketStart = (int *)(race->ringGrid.arena.base + ((const unsigned char *)raceTemplate->ringGrid.bucketStart - templateBase));
+        race->ringGrid.ringIndices = (int *)(race->ringGrid.arena.base + ((const unsigned char *)raceTemplate->ringGrid.ringIndices - templateBase));
+    }
+}
+
+
+// --- HOT RELOAD ---
+// Swaps in the freshly edited level, but the flight goes on: the stopwatch, the mission result and
+// (for ring races) the rings already crossed are carried over. The player is never touched.
+void HotSwapRace(RaceSystem *race, const RaceSystem *raceTemplate) {
+    RaceSystem progress = *race; // Only the plain values are read from this copy (its arrays are freed below).
+
+    RestoreRace(race, raceTemplate);
+
+    race->timer = progress.timer;
+    race->finishedTimer = progress.finishedTimer;
+    race->isRaceActive = progress.isRaceActive;
+    race->isFinished = progress.isFinished;
+    race->prevSpeed = progress.prevSpeed;
+    race->missionFailed = progress.missionFailed;
+    race->failReason = progress.failReason;
+
+    // Same rings already crossed. If the edit removed rings, the last one is still left to fly through
+    // (unless the race was already won).
+    if (race->missionType == 0 && progress.missionType == 0 && race->totalRings > 0) {
+        int lastTarget = race->isFinished ? race->totalRings : race->totalRings - 1;
+        int targetRing = progress.targetRing;
+        if (targetRing > lastTarget) {
+            targetRing = lastTarget;
+        }
+        for (int i = 0; i < targetRing; i++) {
+            race->rings[i].active = false;
+        }
+        race->targetRing = targetRing;
+    }
+}
+
+
 // --- UPDATE LOOP (THE GLOBAL REFEREE) ---
 // This function updates the global stopwatch and then DELEGATES the physical 
 // collision checks and logic to the specific mission workers.
-void UpdateRace(RaceSystem *race, Player *player) {
+void UpdateRace(RaceSystem *race, Player *player, float dt) {
     
     // If the mission is completely finished, just update the post-mission timer and stop.
     if (race->isFinished) {
-        race->finishedTimer += GetFrameTime();
+        race->finishedTimer += dt;
         return; 
     }
 
@@ -181,19 +329,19 @@ void UpdateRace(RaceSystem *race, Player *player) {
     }
 
     // --- 1. UPDATE THE GLOBAL STOPWATCH ---
-    race->timer += GetFrameTime();
+    race->timer += dt;
 
     // --- 2. DELEGATE LOGIC TO SPECIALIZED MODULES ---
     switch (race->missionType) {
         case 0:
             // Hand over control to the Rings module.
             // We pass the exact same pointers so the worker can modify the real data.
-            UpdateMissionRings(race, player);
+            UpdateMissionRings(race, player, dt);
             break;
             
         case 1:
             // Hand over control to the Landing module.
-            UpdateMissionLanding(race, player);
+            UpdateMissionLanding(race, player, dt);
             break;
             
         default:
@@ -201,62 +349,3 @@ void UpdateRace(RaceSystem *race, Player *player) {
             break;
     }
 }
-
-
-// --- RENDERING FUNCTION (3D WORLD) ---
-// This must be called inside BeginMode3D() in main.c.
-// It acts as a switchboard, routing the drawing commands to the correct worker.
-void DrawRace3D(RaceSystem *race, Player *player) {
-    
-    switch (race->missionType) {
-        case 0:
-            DrawMissionRings3D(race, player);
-            break;
-            
-        case 1:
-            DrawMissionLanding3D(race, player);
-            break;
-    }
-}
-
-
-// --- RENDERING FUNCTION (2D HUD) ---
-// This must be called outside BeginMode3D() in main.c, right next to your telemetry.
-// It routes the UI drawing commands to the correct worker.
-void DrawRaceUI(RaceSystem *race) {
-    
-    switch (race->missionType) {
-        case 0:
-            DrawMissionRingsUI(race);
-            break;
-            
-        case 1:
-            DrawMissionLandingUI(race);
-            break;
-    }
-}
-
-
-// --- GET LEVEL NAME ---
-// Opens the text file just to read the very first line (the mission title).
-// Used by the Menu Screen to display the names without loading the entire 3D track.
-void GetLevelName(int levelID, char *outName) {
-    const char *filename = TextFormat("levels/lvl%d.txt", levelID);
-    FILE *file = fopen(filename, "r");
-    
-    if (file != NULL) {
-        // Read the first line (up to 50 characters).
-        if (fgets(outName, 50, file) != NULL) {
-            // 'fgets' grabs the invisible 'newline' character at the end of the text line. 
-            // We must remove it using 'strcspn' so it prints cleanly on the screen.
-            outName[strcspn(outName, "\r\n")] = 0; 
-        } else {
-            strcpy(outName, "UNKNOWN");
-        }
-        fclose(file);
-    } else {
-        // If the file doesn't exist (e.g., trying to load level 15 when we only have 10),
-        // we show this placeholder text in the menu.
-        strcpy(outName, "RESTRICTED AREA"); 
-    }
-}
\ No newline at end of file
@@ -0,0 +1,222 @@
+// Include math library for the bobbing of the navigation arrow.
+#include <math.h>
+
+// We include our own header file.
+// We also need resource_manager.h so this .c file knows what a 'ringModel' is,
+// and raymath.h to build the navigation arrow.
+#include "race_draw.h"
+#include "resource_manager.h"
+#include "raymath.h"
+
+
+// --- NAVIGATION ARROW ---
+// Draws the 3D holographic navigation arrow pointing to a specific target.
+static void DrawNavArrow(Player *player, Vector3 targetPos) {
+    // 1. Get the direction the player is looking using our new centralized function.
+    Vector3 forwardVec = GetPlayerForwardVector(player);
+    
+    // 2. Position the hologram slightly above and in front of the cockpit.
+    float bounceOffset = sinf(GetTime() * 5.0f) * 0.1f; 
+    Vector3 arrowCenter = { 
+        player->position.x + (forwardVec.x * 2.0f), 
+        player->position.y + 1.2f + bounceOffset + (forwardVec.y * 2.0f), 
+        player->position.z + (forwardVec.z * 2.0f) 
+    };
+    
+    // 3. Mathematical calculation of the pointing vector and wings.
+    Vector3 dir = Vector3Normalize(Vector3Subtract(targetPos, arrowCenter));
+    Vector3 worldUp = { 0.0f, 1.0f, 0.0f };
+    Vector3 rightDir = Vector3Normalize(Vector3CrossProduct(dir, worldUp));
+    
+    Vector3 arrowTail = Vector3Subtract(arrowCenter, Vector3Scale(dir, 0.5f));
+    Vector3 arrowTip = Vector3Add(arrowCenter, Vector3Scale(dir, 0.5f));
+    Vector3 headBase = Vector3Subtract(arrowTip, Vector3Scale(dir, 0.4f)); 
+    
+    Vector3 leftWing = Vector3Add(headBase, Vector3Scale(rightDir, 0.25f));
+    Vector3 rightWing = Vector3Subtract(headBase, Vector3Scale(rightDir, 0.25f));
+    
+    // 4. Draw the 3D model.
+    DrawCylinderEx(arrowTail, arrowTip, 0.03f, 0.03f, 6, RED); 
+    DrawCylinderEx(leftWing, arrowTip, 0.03f, 0.03f, 6, RED);  
+    DrawCylinderEx(rightWing, arrowTip, 0.03f, 0.03f, 6, RED); 
+}
+
+
+// --- RINGS MISSION (3D WORLD) ---
+// This draws exclusively the ring models and the navigation arrow.
+// All the rings go to the GPU in ONE instanced draw call, so 5000 rings cost about the same as 5.
+static void DrawMissionRings3D(RaceSystem *race, Player *player) {
+    
+    // --- 1. DRAW ALL ACTIVE RINGS ---
+    // Rings are crossed strictly in order, so the ones still active are exactly
+    // 'targetRing' to 'totalRings - 1': one continuous block of the cached matrices.
+    int activeCount = race->totalRings - race->targetRing;
+
+    if (activeCount > 0) {
+        Matrix *activeTransforms = &race->ringTransforms[race->targetRing];
+
+        // Only the first ring of the block changes colour (the previous target isn't drawn anymore).
+        SetRingInstanceColor(&activeTransforms[0], GOLD);
+
+        // The model's own orientation is the same for every ring, so it goes in once as a uniform.
+        SetShaderValueMatrix(ringShader, ringShaderBaseLoc, ringModel.transform);
+
+        // One draw call per mesh of the model (usually just one), no matter how many rings there are.
+        for (int m = 0; m < ringModel.meshCount; m++) {
+            Material material = ringModel.materials[ringModel.meshMaterial[m]];
+            material.shader = ringShader;
+            DrawMeshInstanced(ringModel.meshes[m], material, activeTransforms, activeCount);
+        }
+    }
+
+    // --- 2. VECTORIAL HUD ARROW (CHEVRON) ---
+    // We build a high-tech wireframe arrow (-->) using 3D lines and cross products.
+    if (race->isRaceActive && race->targetRing < race->totalRings) {
+        DrawNavArrow(player, race->rings[race->targetRing].position);
+    }
+}
+
+
+// --- RINGS MISSION (2D HUD) ---
+// This draws exclusively the UI elements for the ring missions (like the target ring count).
+static void DrawMissionRingsUI(RaceSystem *race) {
+    
+    // Get current screen dimensions dynamically.
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
+    
+    if (race->isRaceActive) {
+        // 1. Draw the stopwatch at 5% from the top.
+        const char *timerText = TextFormat("RACE TIME: %.2f", race->timer);
+        int timerWidth = MeasureText(timerText, 30);
+        DrawTextOutlined(timerText, (screenWidth - timerWidth) / 2, screenHeight * 0.05f, 30, WHITE, 2);
+
+        // 2. Draw progress at 10% from the top.
+        const char *ringText = TextFormat("TARGET RING: %d / %d", race->targetRing + 1, race->totalRings);
+        int ringWidth = MeasureText(ringText, 20);
+        DrawTextOutlined(ringText, (screenWidth - ringWidth) / 2, screenHeight * 0.10f, 20, GOLD, 2);
+        
+    }
+    
+    // Only draw the victory message if less than 3 seconds have passed.
+    else if (race->isFinished && race->finishedTimer < 3.0f) {
+        
+        // Victory message perfectly centered horizontally, at 40% height.
+        const char *winText = "CIRCUIT COMPLETE!";
+        int winWidth = MeasureText(winText, 40);
+        DrawTextOutlined(winText, (screenWidth - winWidth) / 2, screenHeight * 0.4f, 40, GOLD, 2);
+        
+        // Final time perfectly centered horizontally, at 50% height.
+        const char *timeText = TextFormat("FINAL TIME: %.2f SECONDS", race->timer);
+        int timeWidth = MeasureText(timeText, 30);
+        DrawTextOutlined(timeText, (screenWidth - timeWidth) / 2, screenHeight * 0.5f, 30, WHITE, 2);
+    }
+}
+
+
+// --- LANDING MISSION (3D WORLD) ---
+// This draws exclusively the landing pad geometry and the navigation arrow.
+static void DrawMissionLanding3D(RaceSystem *race, Player *player) {
+    if (race->isRaceActive || race->missionFailed) { 
+        DrawCylinder(race->landingZone, race->landingRadius, race->landingRadius, 0.5f, 32, ORANGE);
+        
+        // Middle layer: A solid white concrete area so it stands out against dark terrain.
+        // We lift it by 0.1f on the Y-axis to prevent "Z-fighting" (flickering textures).
+        Vector3 midLayer = { race->landingZone.x, race->landingZone.y + 0.1f, race->landingZone.z };
+        DrawCylinder(midLayer, race->landingRadius * 0.9f, race->landingRadius * 0.9f, 0.5f, 32, RAYWHITE);
+        
+        // Top layer: A red bullseye to mark the exact mathematical center of the landing zone.
+        // Lifted by 0.2f to sit perfectly on top of the white layer.
+        Vector3 bullseye = { race->landingZone.x, race->landingZone.y + 0.2f, race->landingZone.z };
+        DrawCylinder(bullseye, race->landingRadius * 0.2f, race->landingRadius * 0.2f, 0.5f, 16, RED);
+
+        if (!race->missionFailed) {
+            DrawNavArrow(player, race->landingZone);
+        }
+    }
+}
+
+
+// --- LANDING MISSION (2D HUD) ---
+// This draws exclusively the UI elements for landing (speed warnings, distance, etc.).
+static void DrawMissionLandingUI(RaceSystem *race) {
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
+    
+    if (race->missionFailed) {
+        // --- MISSION FAILED SCREEN ---
+        const char *failText = "CRASH LANDING! MISSION FAILED";
+        int failWidth = MeasureText(failText, 40);
+        DrawTextOutlined(failText, (screenWidth - failWidth) / 2, screenHeight * 0.4f, 40, RED, 2);
+        
+        // Dynamic Restart Instructions based on hardware.
+        const char *restText;
+        if (IsGamepadAvailable(0)) {
+            restText = "Press [B] to Restart";
+        } else {
+            restText = "Press [R] to Restart";
+        }
+        
+        int restWidth = MeasureText(restText, 30);
+        DrawTextOutlined(restText, (screenWidth - restWidth) / 2, screenHeight * 0.5f, 30, GRAY, 2);
+        
+    } else if (race->isRaceActive) {
+        // --- NORMAL HUD ---
+        const char *timerText = TextFormat("MISSION TIME: %.2f", race->timer);
+        int timerWidth = MeasureText(timerText, 30);
+        DrawTextOutlined(timerText, (screenWidth - timerWidth) / 2, screenHeight * 0.05f, 30, WHITE, 2);
+
+        const char *objText;
+        if (race->padMoveType > 0) {
+            objText = "OBJECTIVE: LAND ON MOVING CARRIER";
+        } else {
+            objText = "OBJECTIVE: SAFE TOUCHDOWN";
+        }
+        int objWidth = MeasureText(objText, 20);
+        DrawTextOutlined(objText, (screenWidth - objWidth) / 2, screenHeight * 0.10f, 20, GOLD, 2);    
+        
+    } else if (race->isFinished && race->finishedTimer < 3.0f) {
+        // --- VICTORY SCREEN ---
+        const char *winText = "PERFECT LANDING!";
+        int winWidth = MeasureText(winText, 40);
+        DrawTextOutlined(winText, (screenWidth - winWidth) / 2, screenHeight * 0.4f, 40, GOLD, 2);
+        
+        const char *timeText = TextFormat("FINAL TIME: %.2f SECONDS", race->timer);
+        int timeWidth = MeasureText(timeText, 30);
+        DrawTextOutlined(timeText, (screenWidth - timeWidth) / 2, screenHeight * 0.5f, 30, WHITE, 2);
+    }
+}
+
+
+// --- RENDERING FUNCTION (3D WORLD) ---
+// This must be called inside BeginMode3D() in main.c.
+// It acts as a switchboard, routing the drawing commands to the correct worker.
+void DrawRace3D(RaceSystem *race, Player *player) {
+    
+    switch (race->missionType) {
+        case 0:
+            DrawMissionRings3D(race, player);
+            break;
+            
+        case 1:
+            DrawMissionLanding3D(race, player);
+            break;
+    }
+}
+
+
+// --- RENDERING FUNCTION (2D HUD) ---
+// This must be called outside BeginMode3D() in main.c, right next to your telemetry.
+// It routes the UI drawing commands to the correct worker.
+void DrawRaceUI(RaceSystem *race) {
+    
+    switch (race->missionType) {
+        case 0:
+            DrawMissionRingsUI(race);
+            break;
+            
+        case 1:
+            DrawMissionLandingUI(race);
+            break;
+    }
+}
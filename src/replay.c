@@ -0,0 +1,266 @@
+// Include standard libraries for file input/output, memory allocation and math.
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// We include our own header file.
+#include "replay.h"
+
+
+// --- FILE LAYOUT ---
+// [ReplayFileHeader] followed by 'dataSize' bytes of encoded runs.
+// Every run is stored as:
+//   1 byte   -> "change mask": bit 0 = throttle, bit 1 = yaw, bit 2 = pitch, bit 3 = vehicle.
+//   N bytes  -> the new value of every field whose bit is set (1 signed byte each).
+//   1-5 byte -> how many ticks the run lasts (variable length: 7 bits per byte, top bit = "more bytes").
+typedef struct ReplayFileHeader {
+    unsigned int magic;       // REPLAY_MAGIC ("GRP1").
+    int version;              // REPLAY_VERSION.
+    int levelID;              // Level the run was flown on.
+    int startVehicle;         // Vehicle chosen at the start.
+    int tickCount;            // Total number of ticks.
+    float finalTime;          // Race time of the original run.
+    int dataSize;             // Bytes of encoded runs that follow.
+} ReplayFileHeader;
+
+#define REPLAY_FIELDS 4
+
+
+// --- QUANTIZATION ---
+// Axes go from -1.0f to +1.0f and are stored as whole numbers from -127 to +127.
+// The keyboard always gives exactly -1, 0 or +1, so only analog sticks lose a tiny bit of precision.
+static signed char QuantizeAxis(float value) {
+    if (value > 1.0f)  value = 1.0f;
+    if (value < -1.0f) value = -1.0f;
+    return (signed char)lroundf(value * 127.0f);
+}
+
+static float DequantizeAxis(signed char value) {
+    return (float)value / 127.0f;
+}
+
+PilotInput QuantizePilotInput(PilotInput input) {
+    PilotInput rounded = { 0 };
+    rounded.throttle = DequantizeAxis(QuantizeAxis(input.throttle));
+    rounded.yaw      = DequantizeAxis(QuantizeAxis(input.yaw));
+    rounded.pitch    = DequantizeAxis(QuantizeAxis(input.pitch));
+    return rounded;
+}
+
+
+// --- RECORDING ---
+
+// Makes sure there is room for 'extra' more bytes, doubling the buffer when needed.
+static void ReserveReplayBytes(ReplayRecorder *recorder, int extra) {
+    if (recorder->size + extra <= recorder->capacity) {
+        return;
+    }
+
+    int newCapacity = (recorder->capacity > 0) ? recorder->capacity * 2 : 4096;
+    while (newCapacity < recorder->size + extra) {
+        newCapacity *= 2;
+    }
+
+    recorder->data = (unsigned char *)realloc(recorder->data, newCapacity);
+    recorder->capacity = newCapacity;
+}
+
+// Writes the current run (only the fields that changed since the previous run, plus its length).
+static void FlushReplayRun(ReplayRecorder *recorder) {
+    if (recorder->runLength == 0) {
+        return;
+    }
+
+    // Worst case: mask + 4 fields + 5 length bytes.
+    ReserveReplayBytes(recorder, 1 + REPLAY_FIELDS + 5);
+
+    unsigned char mask = 0;
+    for (int i = 0; i < REPLAY_FIELDS; i++) {
+        if (recorder->runValues[i] != recorder->lastWritten[i]) {
+            mask |= (unsigned char)(1 << i);
+        }
+    }
+
+    recorder->data[recorder->size++] = mask;
+    for (int i = 0; i < REPLAY_FIELDS; i++) {
+        if (mask & (1 << i)) {
+            recorder->data[recorder->size++] = (unsigned char)recorder->runValues[i];
+            recorder->lastWritten[i] = recorder->runValues[i];
+        }
+    }
+
+    // Variable length number: small runs take 1 byte, very long ones take more.
+    unsigned int length = (unsigned int)recorder->runLength;
+    do {
+        unsigned char byte = length & 0x7F;
+        length >>= 7;
+        if (length > 0) byte |= 0x80;
+        recorder->data[recorder->size++] = byte;
+    } while (length > 0);
+
+    recorder->runLength = 0;
+}
+
+void BeginReplayRecording(ReplayRecorder *recorder, int levelID, VehicleType vehicle) {
+    // Keep the buffer (no need to free and allocate it again on every restart).
+    recorder->size = 0;
+    recorder->levelID = levelID;
+    recorder->startVehicle = vehicle;
+    recorder->tickCount = 0;
+    recorder->runLength = 0;
+
+    for (int i = 0; i < REPLAY_FIELDS; i++) {
+        recorder->runValues[i] = 0;
+        recorder->lastWritten[i] = 0;
+    }
+}
+
+void RecordReplayTick(ReplayRecorder *recorder, const PilotInput *input, VehicleType vehicle) {
+    signed char values[REPLAY_FIELDS] = {
+        QuantizeAxis(input->throttle),
+        QuantizeAxis(input->yaw),
+        QuantizeAxis(input->pitch),
+        (signed char)vehicle
+    };
+
+    // Same controls as the previous tick? Then the current run just gets one tick longer.
+    bool sameAsRun = (recorder->runLength > 0);
+    for (int i = 0; i < REPLAY_FIELDS && sameAsRun; i++) {
+        if (values[i] != recorder->runValues[i]) sameAsRun = false;
+    }
+
+    if (!sameAsRun) {
+        FlushReplayRun(recorder);
+        for (int i = 0; i < REPLAY_FIELDS; i++) {
+            recorder->runValues[i] = values[i];
+        }
+    }
+
+    recorder->runLength++;
+    recorder->tickCount++;
+}
+
+bool SaveReplay(ReplayRecorder *recorder, const char *fileName, float finalTime) {
+    // Close the run in progress so the file contains every tick.
+    FlushReplayRun(recorder);
+
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "REPLAY: Could not write [%s]", fileName);
+        return false;
+    }
+
+    ReplayFileHeader header = { 0 };
+    header.magic = REPLAY_MAGIC;
+    header.version = REPLAY_VERSION;
+    header.levelID = recorder->levelID;
+    header.startVehicle = (int)recorder->startVehicle;
+    header.tickCount = recorder->tickCount;
+    header.finalTime = finalTime;
+    header.dataSize = recorder->size;
+
+    fwrite(&header, sizeof(header), 1, file);
+    if (recorder->size > 0) {
+        fwrite(recorder->data, 1, recorder->size, file);
+    }
+    fclose(file);
+
+    TraceLog(LOG_INFO, "REPLAY: Saved [%s] (%d ticks in %d bytes)", fileName, recorder->tickCount, recorder->size);
+    return true;
+}
+
+void UnloadReplayRecorder(ReplayRecorder *recorder) {
+    free(recorder->data);
+    recorder->data = NULL;
+    recorder->size = 0;
+    recorder->capacity = 0;
+}
+
+
+// --- PLAYBACK ---
+
+Replay LoadReplay(const char *fileName) {
+    Replay replay = { 0 };
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return replay;
+    }
+
+    ReplayFileHeader header = { 0 };
+    bool valid = (fread(&header, sizeof(header), 1, file) == 1) &&
+                 header.magic == REPLAY_MAGIC &&
+                 header.version == REPLAY_VERSION &&
+                 header.dataSize >= 0;
+
+    if (valid) {
+        replay.data = (unsigned char *)malloc(header.dataSize > 0 ? header.dataSize : 1);
+        valid = (fread(replay.data, 1, header.dataSize, file) == (size_t)header.dataSize);
+    }
+    fclose(file);
+
+    if (!valid) {
+        free(replay.data);
+        replay.data = NULL;
+        TraceLog(LOG_WARNING, "REPLAY: [%s] is not a valid replay file", fileName);
+        return replay;
+    }
+
+    replay.size = header.dataSize;
+    replay.levelID = header.levelID;
+    replay.startVehicle = (VehicleType)header.startVehicle;
+    replay.tickCount = header.tickCount;
+    replay.finalTime = header.finalTime;
+    replay.isReady = true;
+
+    return replay;
+}
+
+bool ReadReplayTick(Replay *replay, PilotInput *outInput, VehicleType *outVehicle) {
+    // Current run finished? Decode the next one.
+    if (replay->ticksLeft == 0) {
+        if (replay->cursor >= replay->size) {
+            return false;
+        }
+
+        unsigned char mask = replay->data[replay->cursor++];
+        for (int i = 0; i < REPLAY_FIELDS; i++) {
+            if ((mask & (1 << i)) && replay->cursor < replay->size) {
+                replay->values[i] = (signed char)replay->data[replay->cursor++];
+            }
+        }
+
+        unsigned int length = 0;
+        int shift = 0;
+        while (replay->cursor < replay->size && shift < 32) {
+            unsigned char byte = replay->data[replay->cursor++];
+            length |= (unsigned int)(byte & 0x7F) << shift;
+            shift += 7;
+            if (!(byte & 0x80)) break;
+        }
+
+        if (length == 0) {
+            return false; // Broken data, stop here.
+        }
+        replay->ticksLeft = (int)length;
+    }
+
+    outInput->throttle = DequantizeAxis(replay->values[0]);
+    outInput->yaw      = DequantizeAxis(replay->values[1]);
+    outInput->pitch    = DequantizeAxis(replay->values[2]);
+    *outVehicle = (VehicleType)replay->values[3];
+
+    replay->ticksLeft--;
+    return true;
+}
+
+void UnloadReplay(Replay *replay) {
+    free(replay->data);
+    replay->data = NULL;
+    replay->isReady = false;
+}
+
+void GetReplayFileName(int levelID, uint32_t runID, char *outName, int outSize) {
+    // The sequence number of the leaderboard entry identifies the replay (no two runs share one).
+    snprintf(outName, outSize, "data/times_lvl%d_run%u.replay", levelID, (unsigned int)runID);
+}
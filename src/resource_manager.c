@@ -1,5 +1,10 @@
 // We include our own header file.
+// The file-based assets are loaded (and freed) by the asset manager.
 #include "resource_manager.h"
+#include "asset_manager.h"
+
+// The GPU programs are stored as text inside the executable.
+#include "shaders.h"
 
 
 // --- GLOBAL VARIABLE DEFINITIONS ---
@@ -9,11 +14,18 @@ Texture2D mapTexture;
 Model mapModel;
 Model environmentModel;
 Model skyboxModel;
+Model groundModel;
+Shader groundShader;
 
 Model planeModel;
 Model helicopterModel;
 
 Model ringModel;
+Shader ringShader;
+int ringShaderBaseLoc;
+
+Model particleModel;
+Shader particleShader;
 
 
 Sound planeSound;  
@@ -24,42 +36,54 @@ Music endingMusic;
 
 
 // --- LOAD FUNCTION ---
-// This function reads the heavy files from the slow Hard Drive 
-// and loads them into the fast RAM.
+// This function creates the assets that are built in code (shaders and flat quads) and starts
+// the background loading of the heavy files (see asset_manager.h). It returns long before the files
+// arrive, so the game can show its loading screen and menus right away.
 void LoadGameResources(void) {
-    // Load the 3D models, the sounds and the music using Raylib's built-in function.
+    // 1. Files
+    // The worker threads read and decode them while we build the rest.
+    // The terrain, the sky and the ring are needed by every flight, so they are held for the whole session
+    // (the terrain also gets its BVH and heightfield built in the background).
+    // The aircraft, the engine sounds and the music are only loaded when a screen asks for them (see main.c).
     // NOTE: If you misspell the file name, Raylib won't crash your game; 
     // but it will just print a yellow warning in the console and show nothing on screen.
-
-    // 1. 3D models
-    // Raylib automatically reads the geometry and the embedded textures from the .glb files.
-    environmentModel = LoadModel("resources/models/terrain.glb");
-    skyboxModel = LoadModel("resources/models/skybox.glb");
-
-
-    ringModel = LoadModel("resources/models/ring.glb");
-    ringModel.transform = MatrixMultiply(ringModel.transform, MatrixRotateX(90.0f * DEG2RAD));
-
-
-    planeModel = LoadModel("resources/models/blackbird.glb");
-    planeModel.transform = MatrixMultiply(planeModel.transform, MatrixRotateY(90.0f * DEG2RAD));
-
-    helicopterModel = LoadModel("resources/models/apache.glb");
-    helicopterModel.transform = MatrixMultiply(helicopterModel.transform, MatrixRotateY(90.0f * DEG2RAD));
-
-    // 2. Sounds & Music
-    planeSound = LoadSound("resources/sounds/plane.wav");
-    SetSoundVolume(planeSound, 1.30f);
-
-    helicopterSound = LoadSound("resources/sounds/helicopter.wav");
-    SetSoundVolume(helicopterSound, 0.45f);
-
-
-    menuMusic = LoadMusicStream("resources/sounds/menu.mp3");
-    SetMusicVolume(menuMusic, 0.55f);
-
-    endingMusic = LoadMusicStream("resources/sounds/ending.mp3");
-    SetMusicVolume(endingMusic, 0.75);
+    StartAssetManager();
+    AcquireAsset(ASSET_TERRAIN);
+    AcquireAsset(ASSET_SKYBOX);
+    AcquireAsset(ASSET_RING);
+
+    // 2. Built in code
+    // The endless floor: a single 10000 x 10000 quad, built once and moved under the player every frame.
+    // The grid lines are not geometry at all, the shader draws them (the grid size costs nothing).
+    groundShader = LoadShaderFromMemory(GROUND_GRID_VS, GROUND_GRID_FS);
+    groundShader.locs[SHADER_LOC_VECTOR_VIEW] = GetShaderLocation(groundShader, "viewPos");
+
+    float gridSpacing = 50.0f;     // Same 50 unit squares as the old line grid.
+    float gridFadeStart = 1500.0f; // The old grid ended abruptly at 3000 units; now it fades out.
+    float gridFadeEnd = 3000.0f;
+    Vector4 groundColor = ColorNormalize(DARKGREEN);
+    Vector4 lineColor = ColorNormalize(LIME);
+    SetShaderValue(groundShader, GetShaderLocation(groundShader, "gridSpacing"), &gridSpacing, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(groundShader, GetShaderLocation(groundShader, "gridFadeStart"), &gridFadeStart, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(groundShader, GetShaderLocation(groundShader, "gridFadeEnd"), &gridFadeEnd, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(groundShader, GetShaderLocation(groundShader, "groundColor"), &groundColor, SHADER_UNIFORM_VEC4);
+    SetShaderValue(groundShader, GetShaderLocation(groundShader, "lineColor"), &lineColor, SHADER_UNIFORM_VEC4);
+
+    groundModel = LoadModelFromMesh(GenMeshPlane(10000.0f, 10000.0f, 1, 1));
+    groundModel.materials[0].shader = groundShader;
+
+    // The instancing shader reads every ring's world matrix from a per-instance vertex attribute.
+    // Raylib's DrawMeshInstanced() looks for that attribute in the MODEL matrix slot.
+    ringShader = LoadShaderFromMemory(RING_INSTANCED_VS, RING_INSTANCED_FS);
+    ringShader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(ringShader, "instanceTransform");
+    ringShaderBaseLoc = GetShaderLocation(ringShader, "matBase");
+
+    // Smoke puffs: one small quad, drawn thousands of times in a single instanced call.
+    particleShader = LoadShaderFromMemory(PARTICLE_BILLBOARD_VS, PARTICLE_BILLBOARD_FS);
+    particleShader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(particleShader, "instanceTransform");
+
+    particleModel = LoadModelFromMesh(GenMeshPlane(1.0f, 1.0f, 1, 1));
+    particleModel.materials[0].shader = particleShader;
 }
 
 
@@ -71,19 +95,14 @@ void UnloadGameResources(void) {
     // Destroys the external files and frees the RAM they were taking up.
     // If we didn't do this, we would create a "Memory Leak".
 
-    // 1. 3D models
-    UnloadModel(environmentModel);
-    UnloadModel(skyboxModel);
-
-    UnloadModel(ringModel);
+    // 1. Files (the asset manager frees whatever is still loaded, including the terrain collision)
+    StopAssetManager();
 
-    UnloadModel(planeModel);
-    UnloadModel(helicopterModel);
-    
-    // 2. Sounds & Music
-    UnloadSound(planeSound);
-    UnloadSound(helicopterSound);
+    // 2. Built in code
+    UnloadModel(groundModel);
+    UnloadShader(groundShader);
 
-    UnloadMusicStream(menuMusic);
-    UnloadMusicStream(endingMusic);
+    UnloadShader(ringShader);
+    UnloadModel(particleModel);
+    UnloadShader(particleShader);
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+// We include our own header file.
+#include "sim.h"
+
+// The frame profiler times both halves of the tick (nothing at all in release builds).
+#include "profiler.h"
+
+
+// --- SIMULATION TICK ---
+// The single entry point of the simulation core.
+// The game calls it from its fixed timestep loop, and headless tools call it directly in a tight loop.
+void SimStep(Player *player, RaceSystem *race, const PilotInput *input, float dt) {
+
+    // 1. Move the vehicle using the controls for this tick.
+    PROFILE_SCOPE("UpdatePlayer") {
+        UpdatePlayer(player, input, dt);
+    }
+
+    // 2. Let the referee check the new position (rings, landing pad, stopwatch).
+    PROFILE_SCOPE("UpdateRace") {
+        UpdateRace(race, player, dt);
+    }
+}
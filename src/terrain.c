@@ -0,0 +1,742 @@
+// Include standard library for dynamic memory (malloc/free).
+#include <stdlib.h>
+
+// Include stdio library to print the benchmark results in the console.
+#include <stdio.h>
+
+// Include float library for the FLT_MAX "infinite distance" constant.
+#include <float.h>
+
+// Include math library to use advanced mathematical functions.
+#include <math.h>
+
+// We include our own header file.
+// We also need raymath.h for the vector math used by the ray/triangle tests.
+#include "terrain.h"
+#include "raymath.h"
+
+
+// --- CONSTANTS ---
+// A leaf box stops being split once it holds this many triangles (or fewer).
+#define BVH_MAX_LEAF_TRIANGLES 4
+
+// The tree is split at the median, so its depth is about log2(triangles / 4).
+// 64 levels is enough for billions of triangles.
+#define BVH_STACK_SIZE 64
+
+// Same tolerance that Raylib uses inside GetRayCollisionTriangle().
+#define BVH_EPSILON 0.000001f
+
+
+// The grid aims for 1 sample every 2 units, but never more than this many samples per axis
+// (1024 x 1024 floats = 4 MB of RAM).
+#define HEIGHTFIELD_TARGET_CELL 2.0f
+#define HEIGHTFIELD_MAX_SAMPLES 1024
+
+// Every satellite ray starts this high, just like the old per-frame ground check.
+#define HEIGHTFIELD_RAY_START 1000.0f
+
+// File signature ("GHF1" in ASCII) and format version of the cached grid.
+// If we ever change the layout, bumping the version makes old caches rebuild automatically.
+#define HEIGHTFIELD_MAGIC 0x31464847
+#define HEIGHTFIELD_VERSION 1
+
+
+// --- CACHE FILE LAYOUT ---
+// The cached grid is this header followed by width * depth raw floats.
+typedef struct HeightfieldFileHeader {
+    unsigned int magic;        // Must be HEIGHTFIELD_MAGIC, otherwise it's not our file.
+    unsigned int version;      // Must be HEIGHTFIELD_VERSION.
+    long long sourceModTime;   // Last modification time of terrain.glb when the grid was baked.
+    int width;
+    int depth;
+    float originX;
+    float originZ;
+    float cellSize;
+} HeightfieldFileHeader;
+
+
+// --- GLOBAL VARIABLE DEFINITIONS ---
+// This is where the compiler actually reserves physical RAM for the collision data.
+TerrainCollision terrainCollision = { 0 };
+TerrainHeightfield terrainHeightfield = { 0 };
+bool terrainExactGround = false;
+
+
+// --- BUILD HELPERS ---
+// Temporary arrays that only live while the tree is being built.
+static Vector3 *buildCentroids = NULL; // Center point of every triangle (used to sort them).
+static int *buildOrder = NULL;         // Triangle indices, shuffled into BVH order during the build.
+
+// Grows a node's box until it wraps every triangle it owns.
+static void UpdateNodeBounds(TerrainBVHNode *node, const Vector3 *worldVertices) {
+    node->boundsMin = (Vector3){ FLT_MAX, FLT_MAX, FLT_MAX };
+    node->boundsMax = (Vector3){ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (int i = 0; i < node->triangleCount; i++) {
+        int tri = buildOrder[node->leftOrFirst + i];
+
+        for (int v = 0; v < 3; v++) {
+            node->boundsMin = Vector3Min(node->boundsMin, worldVertices[tri * 3 + v]);
+            node->boundsMax = Vector3Max(node->boundsMax, worldVertices[tri * 3 + v]);
+        }
+    }
+}
+
+// Returns the X, Y or Z component of a vector using an index (0, 1 or 2).
+static float GetAxis(Vector3 v, int axis) {
+    if (axis == 0) return v.x;
+    if (axis == 1) return v.y;
+    return v.z;
+}
+
+// Quickselect: reorders buildOrder[first..last] so the triangle at 'middle' is the one that would
+// be there if the range was fully sorted along 'axis', with smaller centroids on its left.
+// It is much cheaper than a full sort because it only recurses into one side.
+static void SelectMedian(int first, int last, int middle, int axis) {
+    while (first < last) {
+        float pivot = GetAxis(buildCentroids[buildOrder[(first + last) / 2]], axis);
+        int i = first;
+        int j = last;
+
+        while (i <= j) {
+            while (GetAxis(buildCentroids[buildOrder[i]], axis) < pivot) i++;
+            while (GetAxis(buildCentroids[buildOrder[j]], axis) > pivot) j--;
+
+            if (i <= j) {
+                int swap = buildOrder[i];
+                buildOrder[i] = buildOrder[j];
+                buildOrder[j] = swap;
+                i++;
+                j--;
+            }
+        }
+
+        // Keep working only on the half that contains the middle position.
+        if (middle <= j) {
+            last = j;
+        } else if (middle >= i) {
+            first = i;
+        } else {
+            return;
+        }
+    }
+}
+
+// Splits a node in two halves along its longest axis, then repeats on both halves.
+static void SubdivideNode(int nodeIndex, const Vector3 *worldVertices) {
+    TerrainBVHNode *node = &terrainCollision.nodes[nodeIndex];
+
+    if (node->triangleCount <= BVH_MAX_LEAF_TRIANGLES) {
+        return; // Small enough, this node becomes a leaf.
+    }
+
+    // 1. Find the longest axis of the box that wraps the triangle CENTERS.
+    Vector3 centerMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+    Vector3 centerMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (int i = 0; i < node->triangleCount; i++) {
+        Vector3 c = buildCentroids[buildOrder[node->leftOrFirst + i]];
+        centerMin = Vector3Min(centerMin, c);
+        centerMax = Vector3Max(centerMax, c);
+    }
+
+    Vector3 extent = Vector3Subtract(centerMax, centerMin);
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > GetAxis(extent, axis)) axis = 2;
+
+    // 2. Split at the median so both halves get the same number of triangles.
+    // This keeps the tree balanced, which guarantees it fits in our traversal stack.
+    int first = node->leftOrFirst;
+    int leftCount = node->triangleCount / 2;
+    SelectMedian(first, first + node->triangleCount - 1, first + leftCount, axis);
+
+    // 3. Create the two children (always next to each other in the array).
+    int leftIndex = terrainCollision.nodeCount;
+    terrainCollision.nodeCount += 2;
+
+    TerrainBVHNode *left = &terrainCollision.nodes[leftIndex];
+    TerrainBVHNode *right = &terrainCollision.nodes[leftIndex + 1];
+
+    left->leftOrFirst = first;
+    left->triangleCount = leftCount;
+    right->leftOrFirst = first + leftCount;
+    right->triangleCount = node->triangleCount - leftCount;
+
+    UpdateNodeBounds(left, worldVertices);
+    UpdateNodeBounds(right, worldVertices);
+
+    // 4. The parent becomes an internal node that points to its children.
+    node->leftOrFirst = leftIndex;
+    node->triangleCount = 0;
+
+    SubdivideNode(leftIndex, worldVertices);
+    SubdivideNode(leftIndex + 1, worldVertices);
+}
+
+
+// --- BUILD FUNCTION ---
+// Runs once at load time. The cost is paid here so every raycast in the game loop is cheap.
+void BuildTerrainCollision(Model model) {
+    UnloadTerrainCollision();
+
+    // 1. Count every triangle of every mesh.
+    int totalTriangles = 0;
+    for (int m = 0; m < model.meshCount; m++) {
+        if (model.meshes[m].vertices != NULL) {
+            totalTriangles += model.meshes[m].triangleCount;
+        }
+    }
+
+    if (totalTriangles == 0) {
+        return; // No terrain loaded: the game falls back to the flat floor at Y = 0.
+    }
+
+    // 2. Copy the triangles into world space (same math as GetRayCollisionMesh, but done only once).
+    Vector3 *worldVertices = (Vector3 *)malloc(sizeof(Vector3) * totalTriangles * 3);
+    buildCentroids = (Vector3 *)malloc(sizeof(Vector3) * totalTriangles);
+    buildOrder = (int *)malloc(sizeof(int) * totalTriangles);
+
+    int tri = 0;
+    for (int m = 0; m < model.meshCount; m++) {
+        Mesh *mesh = &model.meshes[m];
+        if (mesh->vertices == NULL) continue;
+
+        for (int i = 0; i < mesh->triangleCount; i++) {
+            for (int v = 0; v < 3; v++) {
+                // Indexed meshes reuse vertices, non-indexed meshes list them in order.
+                int vertexIndex;
+                if (mesh->indices != NULL) {
+                    vertexIndex = mesh->indices[i * 3 + v];
+                } else {
+                    vertexIndex = i * 3 + v;
+                }
+
+                Vector3 local = { mesh->vertices[vertexIndex * 3 + 0], mesh->vertices[vertexIndex * 3 + 1], mesh->vertices[vertexIndex * 3 + 2] };
+                worldVertices[tri * 3 + v] = Vector3Transform(local, model.transform);
+            }
+
+            Vector3 sum = Vector3Add(Vector3Add(worldVertices[tri * 3], worldVertices[tri * 3 + 1]), worldVertices[tri * 3 + 2]);
+            buildCentroids[tri] = Vector3Scale(sum, 1.0f / 3.0f);
+            buildOrder[tri] = tri;
+            tri++;
+        }
+    }
+
+    // 3. Build the tree. A binary tree with N leaves never needs more than 2N - 1 nodes.
+    terrainCollision.nodes = (TerrainBVHNode *)malloc(sizeof(TerrainBVHNode) * (2 * totalTriangles - 1));
+    terrainCollision.nodeCount = 1;
+    terrainCollision.nodes[0].leftOrFirst = 0;
+    terrainCollision.nodes[0].triangleCount = totalTriangles;
+
+    UpdateNodeBounds(&terrainCollision.nodes[0], worldVertices);
+    SubdivideNode(0, worldVertices);
+
+    // 4. Store the triangles in the final BVH order, so every leaf reads contiguous memory.
+    terrainCollision.vertices = (Vector3 *)malloc(sizeof(Vector3) * totalTriangles * 3);
+    for (int i = 0; i < totalTriangles; i++) {
+        int source = buildOrder[i];
+        terrainCollision.vertices[i * 3 + 0] = worldVertices[source * 3 + 0];
+        terrainCollision.vertices[i * 3 + 1] = worldVertices[source * 3 + 1];
+        terrainCollision.vertices[i * 3 + 2] = worldVertices[source * 3 + 2];
+    }
+
+    terrainCollision.triangleCount = totalTriangles;
+    terrainCollision.isReady = true;
+
+    // 5. Free the temporary build arrays.
+    free(worldVertices);
+    free(buildCentroids);
+    free(buildOrder);
+    buildCentroids = NULL;
+    buildOrder = NULL;
+
+    TraceLog(LOG_INFO, "TERRAIN: BVH built with %d triangles and %d nodes", terrainCollision.triangleCount, terrainCollision.nodeCount);
+}
+
+
+// --- UNLOAD FUNCTION ---
+void UnloadTerrainCollision(void) {
+    free(terrainCollision.vertices);
+    free(terrainCollision.nodes);
+
+    // Reset everything to 0 so a second unload (or a rebuild) is always safe.
+    terrainCollision = (TerrainCollision){ 0 };
+}
+
+
+// --- RAY VS BOX (SLAB TEST) ---
+// Clips the [tmin, tmax] range of the ray against the two walls of the box on one axis.
+// Returns false as soon as the range becomes empty (the ray misses the box).
+static bool ClipRaySlab(float origin, float direction, float invDir, float boxMin, float boxMax, float *tmin, float *tmax) {
+    if (direction == 0.0f) {
+        // The ray is parallel to these walls: it is either always between them or never.
+        // (Multiplying by the infinite inverse here would give NaN when the ray starts on a wall.)
+        return (origin >= boxMin && origin <= boxMax);
+    }
+
+    float t1 = (boxMin - origin) * invDir;
+    float t2 = (boxMax - origin) * invDir;
+
+    *tmin = fmaxf(*tmin, fminf(t1, t2));
+    *tmax = fminf(*tmax, fmaxf(t1, t2));
+
+    return (*tmin <= *tmax);
+}
+
+// Returns the distance where the ray enters the box, or FLT_MAX if it misses it.
+// We pass the inverse direction so the 3 divisions are done only once per ray.
+static float RayBoxDistance(Ray ray, Vector3 invDir, Vector3 boxMin, Vector3 boxMax) {
+    float tmin = 0.0f;     // The ray can't hit anything behind its starting point.
+    float tmax = FLT_MAX;
+
+    if (!ClipRaySlab(ray.position.x, ray.direction.x, invDir.x, boxMin.x, boxMax.x, &tmin, &tmax)) return FLT_MAX;
+    if (!ClipRaySlab(ray.position.y, ray.direction.y, invDir.y, boxMin.y, boxMax.y, &tmin, &tmax)) return FLT_MAX;
+    if (!ClipRaySlab(ray.position.z, ray.direction.z, invDir.z, boxMin.z, boxMax.z, &tmin, &tmax)) return FLT_MAX;
+
+    return tmin;
+}
+
+
+// --- RAY VS TRIANGLE (MOLLER-TRUMBORE) ---
+// The same algorithm GetRayCollisionTriangle() uses, but it only returns the distance
+// (or FLT_MAX on a miss) so the inner loop doesn't build a full RayCollision per triangle.
+static float RayTriangleDistance(Ray ray, Vector3 p1, Vector3 p2, Vector3 p3) {
+    Vector3 edge1 = Vector3Subtract(p2, p1);
+    Vector3 edge2 = Vector3Subtract(p3, p1);
+
+    Vector3 p = Vector3CrossProduct(ray.direction, edge2);
+    float det = Vector3DotProduct(edge1, p);
+
+    // The ray is parallel to the triangle.
+    if ((det > -BVH_EPSILON) && (det < BVH_EPSILON)) return FLT_MAX;
+
+    float invDet = 1.0f / det;
+
+    Vector3 tv = Vector3Subtract(ray.position, p1);
+    float u = Vector3DotProduct(tv, p) * invDet;
+    if ((u < 0.0f) || (u > 1.0f)) return FLT_MAX;
+
+    Vector3 q = Vector3CrossProduct(tv, edge1);
+    float v = Vector3DotProduct(ray.direction, q) * invDet;
+    if ((v < 0.0f) || ((u + v) > 1.0f)) return FLT_MAX;
+
+    float t = Vector3DotProduct(edge2, q) * invDet;
+    if (t > BVH_EPSILON) return t;
+
+    return FLT_MAX;
+}
+
+
+// --- RAYCAST FUNCTION ---
+// Walks the tree from the root, always visiting the nearest box first.
+// Any box that starts further away than our best hit so far is skipped completely.
+RayCollision GetRayCollisionTerrain(Ray ray, float maxDistance) {
+    RayCollision collision = { 0 };
+
+    if (!terrainCollision.isReady) {
+        return collision;
+    }
+
+    // Divisions by 0 produce +/- infinity, but the slab test never uses them for parallel axes.
+    Vector3 invDir = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+
+    float closest = maxDistance;
+    int closestTriangle = -1;
+
+    int stack[BVH_STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const TerrainBVHNode *node = &terrainCollision.nodes[stack[--stackSize]];
+
+        if (RayBoxDistance(ray, invDir, node->boundsMin, node->boundsMax) >= closest) {
+            continue;
+        }
+
+        if (node->triangleCount > 0) {
+            // LEAF: test the few triangles inside it.
+            for (int i = node->leftOrFirst; i < node->leftOrFirst + node->triangleCount; i++) {
+                const Vector3 *v = &terrainCollision.vertices[i * 3];
+                float t = RayTriangleDistance(ray, v[0], v[1], v[2]);
+
+                if (t < closest) {
+                    closest = t;
+                    closestTriangle = i;
+                }
+            }
+        } else {
+            // INTERNAL: push the far child first, so the near child is popped (visited) first.
+            int nearChild = node->leftOrFirst;
+            int farChild = node->leftOrFirst + 1;
+
+            float nearDistance = RayBoxDistance(ray, invDir, terrainCollision.nodes[nearChild].boundsMin, terrainCollision.nodes[nearChild].boundsMax);
+            float farDistance = RayBoxDistance(ray, invDir, terrainCollision.nodes[farChild].boundsMin, terrainCollision.nodes[farChild].boundsMax);
+
+            if (farDistance < nearDistance) {
+                int swap = nearChild;
+                nearChild = farChild;
+                farChild = swap;
+
+                float swapDistance = nearDistance;
+                nearDistance = farDistance;
+                farDistance = swapDistance;
+            }
+
+            if (farDistance < closest) stack[stackSize++] = farChild;
+            if (nearDistance < closest) stack[stackSize++] = nearChild;
+        }
+    }
+
+    // Fill the collision data exactly like Raylib does, but only for the winning triangle.
+    if (closestTriangle >= 0) {
+        const Vector3 *v = &terrainCollision.vertices[closestTriangle * 3];
+
+        collision.hit = true;
+        collision.distance = closest;
+        collision.point = Vector3Add(ray.position, Vector3Scale(ray.direction, closest));
+        collision.normal = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(v[1], v[0]), Vector3Subtract(v[2], v[0])));
+    }
+
+    return collision;
+}
+
+
+// --- HEIGHTFIELD: CACHE FILE ---
+// Reads the grid from the hard drive. If 'checkModTime' is true, the file is rejected when
+// it was baked from a different version of terrain.glb.
+static bool ReadHeightfieldFile(const char *cacheFile, long long expectedModTime, bool checkModTime) {
+    FILE *file = fopen(cacheFile, "rb");
+    if (file == NULL) return false;
+
+    HeightfieldFileHeader header = { 0 };
+    bool valid = (fread(&header, sizeof(header), 1, file) == 1);
+
+    // Reject foreign files, old formats, stale caches and absurd sizes.
+    if (valid && (header.magic != HEIGHTFIELD_MAGIC || header.version != HEIGHTFIELD_VERSION)) valid = false;
+    if (valid && checkModTime && header.sourceModTime != expectedModTime) valid = false;
+    if (valid && (header.width < 2 || header.depth < 2 || header.width > HEIGHTFIELD_MAX_SAMPLES || header.depth > HEIGHTFIELD_MAX_SAMPLES)) valid = false;
+    if (valid && header.cellSize <= 0.0f) valid = false;
+
+    if (valid) {
+        int sampleCount = header.width * header.depth;
+        float *heights = (float *)malloc(sizeof(float) * sampleCount);
+
+        if (fread(heights, sizeof(float), sampleCount, file) == (size_t)sampleCount) {
+            UnloadTerrainHeightfield();
+            terrainHeightfield.heights = heights;
+            terrainHeightfield.width = header.width;
+            terrainHeightfield.depth = header.depth;
+            terrainHeightfield.originX = header.originX;
+            terrainHeightfield.originZ = header.originZ;
+            terrainHeightfield.cellSize = header.cellSize;
+            terrainHeightfield.isReady = true;
+        } else {
+            free(heights); // The file was cut short (e.g. the game crashed while saving it).
+            valid = false;
+        }
+    }
+
+    fclose(file);
+    return valid;
+}
+
+// Writes the current grid to the hard drive so the next launch can skip the bake.
+static void WriteHeightfieldFile(const char *cacheFile, long long sourceModTime) {
+    FILE *file = fopen(cacheFile, "wb");
+    if (file == NULL) return; // Read-only folder: we just bake again next time.
+
+    HeightfieldFileHeader header = { 0 };
+    header.magic = HEIGHTFIELD_MAGIC;
+    header.version = HEIGHTFIELD_VERSION;
+    header.sourceModTime = sourceModTime;
+    header.width = terrainHeightfield.width;
+    header.depth = terrainHeightfield.depth;
+    header.originX = terrainHeightfield.originX;
+    header.originZ = terrainHeightfield.originZ;
+    header.cellSize = terrainHeightfield.cellSize;
+
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(terrainHeightfield.heights, sizeof(float), terrainHeightfield.width * terrainHeightfield.depth, file);
+    fclose(file);
+}
+
+
+// --- HEIGHTFIELD: BAKE ---
+void BakeTerrainHeightfield(const char *cacheFile, const char *sourceFile) {
+    if (!terrainCollision.isReady) {
+        UnloadTerrainHeightfield();
+        return; // No terrain: the ground stays flat at Y = 0.
+    }
+
+    // 1. Try the cached grid first. It is only valid if terrain.glb hasn't changed since.
+    long long sourceModTime = (long long)GetFileModTime(sourceFile);
+    if (ReadHeightfieldFile(cacheFile, sourceModTime, true)) {
+        TraceLog(LOG_INFO, "TERRAIN: Heightfield loaded from cache [%s] (%dx%d)", cacheFile, terrainHeightfield.width, terrainHeightfield.depth);
+        return;
+    }
+
+    // 2. Size the grid to cover the whole terrain (the root box of the BVH).
+    Vector3 boundsMin = terrainCollision.nodes[0].boundsMin;
+    Vector3 boundsMax = terrainCollision.nodes[0].boundsMax;
+    float extentX = boundsMax.x - boundsMin.x;
+    float extentZ = boundsMax.z - boundsMin.z;
+
+    float cellSize = HEIGHTFIELD_TARGET_CELL;
+    float largestExtent = fmaxf(extentX, extentZ);
+    if (largestExtent / cellSize > (HEIGHTFIELD_MAX_SAMPLES - 1)) {
+        cellSize = largestExtent / (HEIGHTFIELD_MAX_SAMPLES - 1);
+    }
+
+    int width = (int)ceilf(extentX / cellSize) + 1;
+    int depth = (int)ceilf(extentZ / cellSize) + 1;
+    if (width < 2) width = 2;
+    if (depth < 2) depth = 2;
+    if (width > HEIGHTFIELD_MAX_SAMPLES) width = HEIGHTFIELD_MAX_SAMPLES;
+    if (depth > HEIGHTFIELD_MAX_SAMPLES) depth = HEIGHTFIELD_MAX_SAMPLES;
+
+    // 3. "Rasterize" the terrain: one satellite ray per sample, cast only once, right here.
+    float *heights = (float *)malloc(sizeof(float) * width * depth);
+
+    for (int z = 0; z < depth; z++) {
+        for (int x = 0; x < width; x++) {
+            heights[z * width + x] = GetTerrainHeightExact(boundsMin.x + x * cellSize, boundsMin.z + z * cellSize);
+        }
+    }
+
+    UnloadTerrainHeightfield();
+    terrainHeightfield.heights = heights;
+    terrainHeightfield.width = width;
+    terrainHeightfield.depth = depth;
+    terrainHeightfield.originX = boundsMin.x;
+    terrainHeightfield.originZ = boundsMin.z;
+    terrainHeightfield.cellSize = cellSize;
+    terrainHeightfield.isReady = true;
+
+    // 4. Save it so the next launch doesn't have to bake it again.
+    WriteHeightfieldFile(cacheFile, sourceModTime);
+
+    TraceLog(LOG_INFO, "TERRAIN: Heightfield baked (%dx%d, %.2f units per cell)", width, depth, cellSize);
+}
+
+
+// --- HEIGHTFIELD: LOAD / UNLOAD ---
+bool LoadTerrainHeightfield(const char *cacheFile) {
+    return ReadHeightfieldFile(cacheFile, 0, false);
+}
+
+void UnloadTerrainHeightfield(void) {
+    free(terrainHeightfield.heights);
+    terrainHeightfield = (TerrainHeightfield){ 0 };
+}
+
+
+// --- HEIGHTFIELD: LOOKUPS ---
+float GetTerrainHeightExact(float x, float z) {
+    Ray downRay = { 0 };
+    downRay.position = (Vector3){ x, HEIGHTFIELD_RAY_START, z };
+    downRay.direction = (Vector3){ 0.0f, -1.0f, 0.0f };
+
+    RayCollision groundHit = GetRayCollisionTerrain(downRay, FLT_MAX);
+    if (groundHit.hit) {
+        return groundHit.point.y;
+    }
+
+    return 0.0f; // Nothing below us: the mathematical floor.
+}
+
+float GetTerrainHeight(float x, float z) {
+    // Exact fallback (or no grid available).
+    if (terrainExactGround || !terrainHeightfield.isReady) {
+        return GetTerrainHeightExact(x, z);
+    }
+
+    // 1. Convert the world position into (fractional) grid coordinates.
+    float gx = (x - terrainHeightfield.originX) / terrainHeightfield.cellSize;
+    float gz = (z - terrainHeightfield.originZ) / terrainHeightfield.cellSize;
+
+    // Outside the grid there is no terrain at all.
+    if (gx < 0.0f || gz < 0.0f || gx > (float)(terrainHeightfield.width - 1) || gz > (float)(terrainHeightfield.depth - 1)) {
+        return 0.0f;
+    }
+
+    // 2. Find the 4 samples around us (the last row/column reuses the previous cell).
+    int ix = (int)gx;
+    int iz = (int)gz;
+    if (ix > terrainHeightfield.width - 2) ix = terrainHeightfield.width - 2;
+    if (iz > terrainHeightfield.depth - 2) iz = terrainHeightfield.depth - 2;
+
+    float fx = gx - (float)ix;
+    float fz = gz - (float)iz;
+
+    const float *row0 = &terrainHeightfield.heights[iz * terrainHeightfield.width + ix];
+    const float *row1 = row0 + terrainHeightfield.width;
+
+    // 3. Bilinear blend: first along X on both rows, then along Z between the rows.
+    float h0 = row0[0] + (row0[1] - row0[0]) * fx;
+    float h1 = row1[0] + (row1[1] - row1[0]) * fx;
+
+    return h0 + (h1 - h0) * fz;
+}
+
+
+// --- HEIGHTFIELD: VALIDATION MODE ---
+// Measures how far the grid is from the real mesh at random positions over the terrain.
+void ValidateTerrainHeightfield(int sampleCount) {
+    if (!terrainHeightfield.isReady || !terrainCollision.isReady || sampleCount <= 0) {
+        printf("HEIGHTFIELD VALIDATION: No terrain loaded, nothing to validate.\n");
+        return;
+    }
+
+    SetRandomSeed(4321);
+
+    float minX = terrainHeightfield.originX;
+    float minZ = terrainHeightfield.originZ;
+    float sizeX = (terrainHeightfield.width - 1) * terrainHeightfield.cellSize;
+    float sizeZ = (terrainHeightfield.depth - 1) * terrainHeightfield.cellSize;
+
+    // 1. Pick the random positions (and keep them, so both paths read the same ones).
+    Vector2 *positions = (Vector2 *)malloc(sizeof(Vector2) * sampleCount);
+    float *gridHeights = (float *)malloc(sizeof(float) * sampleCount);
+    float *exactHeights = (float *)malloc(sizeof(float) * sampleCount);
+
+    for (int i = 0; i < sampleCount; i++) {
+        positions[i].x = minX + sizeX * ((float)GetRandomValue(0, 100000) / 100000.0f);
+        positions[i].y = minZ + sizeZ * ((float)GetRandomValue(0, 100000) / 100000.0f);
+    }
+
+    // 2. Grid lookups. We force the grid path even if the exact fallback is enabled.
+    bool previousExact = terrainExactGround;
+    terrainExactGround = false;
+
+    double gridStart = GetTime();
+    for (int i = 0; i < sampleCount; i++) {
+        gridHeights[i] = GetTerrainHeight(positions[i].x, positions[i].y);
+    }
+    double gridSeconds = GetTime() - gridStart;
+
+    terrainExactGround = previousExact;
+
+    // 3. Exact raycasts at the same positions.
+    double exactStart = GetTime();
+    for (int i = 0; i < sampleCount; i++) {
+        exactHeights[i] = GetTerrainHeightExact(positions[i].x, positions[i].y);
+    }
+    double exactSeconds = GetTime() - exactStart;
+
+    // 4. Compare them.
+    double totalError = 0.0;
+    float maxError = 0.0f;
+    Vector2 worstPosition = { 0.0f, 0.0f };
+
+    for (int i = 0; i < sampleCount; i++) {
+        float error = fabsf(gridHeights[i] - exactHeights[i]);
+        totalError += error;
+
+        if (error > maxError) {
+            maxError = error;
+            worstPosition = positions[i];
+        }
+    }
+
+    free(positions);
+    free(gridHeights);
+    free(exactHeights);
+
+    printf("HEIGHTFIELD VALIDATION: %dx%d grid, %.2f units per cell, %d samples\n", terrainHeightfield.width, terrainHeightfield.depth, terrainHeightfield.cellSize, sampleCount);
+    printf("  Max error      : %.3f units (at X = %.1f, Z = %.1f)\n", maxError, worstPosition.x, worstPosition.y);
+    printf("  Average error  : %.3f units\n", totalError / sampleCount);
+    printf("  Grid lookup    : %10.1f ns\n", (gridSeconds * 1e9) / sampleCount);
+    printf("  Exact raycast  : %10.1f ns\n", (exactSeconds * 1e9) / sampleCount);
+}
+
+
+// --- MICROBENCHMARK ---
+// Compares the BVH against the old brute-force path using the exact same rays.
+// Half of the rays are "satellite" rays cast straight down from Y = 1000 (like the ground check),
+// and the other half are horizontal rays (like the forward crash check).
+void BenchmarkTerrainRaycasts(Model model, int rayCount) {
+    if (!terrainCollision.isReady || rayCount <= 0) {
+        printf("TERRAIN BENCHMARK: No terrain loaded, nothing to measure.\n");
+        return;
+    }
+
+    // Fixed seed so two runs of the benchmark fire the exact same rays.
+    SetRandomSeed(1234);
+
+    Vector3 boundsMin = terrainCollision.nodes[0].boundsMin;
+    Vector3 boundsMax = terrainCollision.nodes[0].boundsMax;
+
+    Ray *rays = (Ray *)malloc(sizeof(Ray) * rayCount);
+
+    for (int i = 0; i < rayCount; i++) {
+        float rx = (float)GetRandomValue(0, 10000) / 10000.0f;
+        float ry = (float)GetRandomValue(0, 10000) / 10000.0f;
+        float rz = (float)GetRandomValue(0, 10000) / 10000.0f;
+
+        Vector3 origin = {
+            boundsMin.x + (boundsMax.x - boundsMin.x) * rx,
+            boundsMin.y + (boundsMax.y - boundsMin.y) * ry,
+            boundsMin.z + (boundsMax.z - boundsMin.z) * rz
+        };
+
+        if (i % 2 == 0) {
+            rays[i].position = (Vector3){ origin.x, 1000.0f, origin.z };
+            rays[i].direction = (Vector3){ 0.0f, -1.0f, 0.0f };
+        } else {
+            float angle = (float)GetRandomValue(0, 360) * DEG2RAD;
+            rays[i].position = origin;
+            rays[i].direction = (Vector3){ sinf(angle), 0.0f, cosf(angle) };
+        }
+    }
+
+    // 1. Brute force: every triangle of every mesh, for every ray.
+    RayCollision *bruteHits = (RayCollision *)malloc(sizeof(RayCollision) * rayCount);
+    double bruteStart = GetTime();
+
+    for (int i = 0; i < rayCount; i++) {
+        RayCollision best = { 0 };
+        best.distance = FLT_MAX;
+
+        for (int m = 0; m < model.meshCount; m++) {
+            RayCollision hit = GetRayCollisionMesh(rays[i], model.meshes[m], model.transform);
+            if (hit.hit && hit.distance < best.distance) {
+                best = hit;
+            }
+        }
+        bruteHits[i] = best;
+    }
+    double bruteSeconds = GetTime() - bruteStart;
+
+    // 2. BVH: same rays.
+    int mismatches = 0;
+    int hits = 0;
+    double bvhStart = GetTime();
+
+    for (int i = 0; i < rayCount; i++) {
+        RayCollision hit = GetRayCollisionTerrain(rays[i], FLT_MAX);
+        if (hit.hit) hits++;
+
+        // Both paths must agree on whether we hit and at which distance.
+        if (hit.hit != bruteHits[i].hit || (hit.hit && fabsf(hit.distance - bruteHits[i].distance) > 0.001f)) {
+            mismatches++;
+        }
+    }
+    double bvhSeconds = GetTime() - bvhStart;
+
+    double bruteNs = (bruteSeconds * 1e9) / rayCount;
+    double bvhNs = (bvhSeconds * 1e9) / rayCount;
+
+    printf("TERRAIN BENCHMARK: %d triangles, %d BVH nodes, %d rays (%d hits)\n", terrainCollision.triangleCount, terrainCollision.nodeCount, rayCount, hits);
+    printf("  GetRayCollisionMesh : %12.1f ns/ray\n", bruteNs);
+    printf("  Terrain BVH         : %12.1f ns/ray\n", bvhNs);
+    if (bvhNs > 0.0) {
+        printf("  Speedup             : %12.1fx\n", bruteNs / bvhNs);
+    }
+    printf("  Mismatched results  : %d\n", mismatches);
+
+    free(rays);
+    free(bruteHits);
+}
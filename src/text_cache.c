@@ -0,0 +1,167 @@
+// Include string library to use string manipulation functions.
+#include <string.h>
+
+// We include our own header file.
+#include "text_cache.h"
+
+
+// --- CACHE STORAGE ---
+// 'static' keeps these private to this file: the rest of the game only sees DrawTextOutlined().
+static TextCacheEntry textCache[TEXT_CACHE_SIZE] = { 0 };
+static unsigned int textCacheClock = 0;   // Goes up by one on every draw (a "time" for 'lastUsed').
+
+
+// --- OUTLINED TEXT (THE SLOW WAY) ---
+// Eight black copies around the text and the coloured one on top.
+// Used to fill a cache entry once, and directly for strings too long to cache.
+static void DrawTextOutlinedPasses(const char *text, int posX, int posY, int fontSize, Color color, int outlineSize) {
+    DrawText(text, posX - outlineSize, posY, fontSize, BLACK);
+    DrawText(text, posX + outlineSize, posY, fontSize, BLACK);
+    DrawText(text, posX, posY - outlineSize, fontSize, BLACK);
+    DrawText(text, posX, posY + outlineSize, fontSize, BLACK);
+    DrawText(text, posX - outlineSize, posY - outlineSize, fontSize, BLACK);
+    DrawText(text, posX + outlineSize, posY - outlineSize, fontSize, BLACK);
+    DrawText(text, posX - outlineSize, posY + outlineSize, fontSize, BLACK);
+    DrawText(text, posX + outlineSize, posY + outlineSize, fontSize, BLACK);
+    DrawText(text, posX, posY, fontSize, color);
+}
+
+
+// --- KEY FINGERPRINT ---
+// FNV-1a hash of the string, with the size, colour and border mixed in.
+// Comparing two numbers is much cheaper than comparing two strings, so the lookup
+// only calls strcmp() on the slot that already has the right fingerprint.
+static unsigned int HashTextKey(const char *text, int fontSize, Color color, int outlineSize) {
+    unsigned int hash = 2166136261u;
+
+    for (const unsigned char *c = (const unsigned char *)text; *c != '\0'; c++) {
+        hash = (hash ^ *c) * 16777619u;
+    }
+
+    unsigned int extras[3] = {
+        (unsigned int)fontSize,
+        ((unsigned int)color.r << 24) | ((unsigned int)color.g << 16) | ((unsigned int)color.b << 8) | color.a,
+        (unsigned int)outlineSize
+    };
+    for (int i = 0; i < 3; i++) {
+        hash = (hash ^ extras[i]) * 16777619u;
+    }
+
+    // 0 marks an empty slot, so a real key never uses it.
+    return (hash != 0) ? hash : 1;
+}
+
+
+// --- SLOT LOOKUP ---
+// Returns the slot holding this exact key, or NULL if it isn't cached.
+static TextCacheEntry *FindTextEntry(unsigned int hash, const char *text, int fontSize, Color color, int outlineSize) {
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++) {
+        TextCacheEntry *entry = &textCache[i];
+
+        if (entry->hash == hash && entry->fontSize == fontSize && entry->outlineSize == outlineSize &&
+            entry->color.r == color.r && entry->color.g == color.g &&
+            entry->color.b == color.b && entry->color.a == color.a &&
+            strcmp(entry->text, text) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Picks the slot to overwrite: an empty one if there is any, otherwise the one unused for the longest.
+// The HUD lines are drawn every frame, so they are never the oldest; old timer and altitude
+// values (which will never be shown again) are.
+static TextCacheEntry *ChooseTextSlot(void) {
+    TextCacheEntry *oldest = &textCache[0];
+
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++) {
+        TextCacheEntry *entry = &textCache[i];
+        if (entry->hash == 0) {
+            return entry;
+        }
+        if (textCacheClock - entry->lastUsed > textCacheClock - oldest->lastUsed) {
+            oldest = entry;
+        }
+    }
+    return oldest;
+}
+
+
+// --- CACHE FILL ---
+// Renders the outlined string into 'entry'. The slot keeps its old texture if the new text fits in it,
+// so a value that changes every frame (the timer) keeps reusing the same GPU image.
+static bool FillTextEntry(TextCacheEntry *entry, unsigned int hash, const char *text, int fontSize, Color color, int outlineSize) {
+    int width = MeasureText(text, fontSize) + (outlineSize * 2);
+    int height = fontSize + (outlineSize * 2);
+
+    if (entry->target.id == 0 || entry->target.texture.width < width || entry->target.texture.height < height) {
+        if (entry->target.id != 0) {
+            UnloadRenderTexture(entry->target);
+        }
+
+        // Round the size up, so slightly longer values next time still fit without a new texture.
+        int textureWidth = (width + 63) & ~63;
+        int textureHeight = (height + 15) & ~15;
+        entry->target = LoadRenderTexture(textureWidth, textureHeight);
+
+        if (entry->target.id == 0) {
+            *entry = (TextCacheEntry){ 0 };
+            return false;
+        }
+    }
+
+    // Draw the nine passes once, into the texture instead of the screen.
+    // (Switching to a texture mid-frame is fine in 2D; EndTextureMode() puts the screen back.)
+    BeginTextureMode(entry->target);
+        ClearBackground(BLANK);
+        DrawTextOutlinedPasses(text, outlineSize, outlineSize, fontSize, color, outlineSize);
+    EndTextureMode();
+
+    entry->hash = hash;
+    strcpy(entry->text, text);
+    entry->fontSize = fontSize;
+    entry->color = color;
+    entry->outlineSize = outlineSize;
+    entry->width = width;
+    entry->height = height;
+    return true;
+}
+
+
+// --- OUTLINED TEXT ---
+void DrawTextOutlined(const char *text, int posX, int posY, int fontSize, Color color, int outlineSize) {
+    if (strlen(text) > TEXT_CACHE_MAX_LENGTH) {
+        DrawTextOutlinedPasses(text, posX, posY, fontSize, color, outlineSize);
+        return;
+    }
+
+    unsigned int hash = HashTextKey(text, fontSize, color, outlineSize);
+    TextCacheEntry *entry = FindTextEntry(hash, text, fontSize, color, outlineSize);
+
+    // First time this exact string is shown (or it changed): render it once.
+    if (entry == NULL) {
+        entry = ChooseTextSlot();
+        if (!FillTextEntry(entry, hash, text, fontSize, color, outlineSize)) {
+            DrawTextOutlinedPasses(text, posX, posY, fontSize, color, outlineSize);
+            return;
+        }
+    }
+
+    entry->lastUsed = ++textCacheClock;
+
+    // Render textures are stored upside down (OpenGL starts at the bottom), so the source height is negative.
+    Rectangle source = { 0.0f, (float)(entry->target.texture.height - entry->height), (float)entry->width, -(float)entry->height };
+    DrawTextureRec(entry->target.texture, source, (Vector2){ (float)(posX - outlineSize), (float)(posY - outlineSize) }, WHITE);
+}
+
+
+// --- CLEANUP ---
+void UnloadTextCache(void) {
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++) {
+        if (textCache[i].target.id != 0) {
+            UnloadRenderTexture(textCache[i].target);
+        }
+        textCache[i] = (TextCacheEntry){ 0 };
+    }
+    textCacheClock = 0;
+}
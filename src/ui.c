@@ -2,9 +2,9 @@
 #include <string.h>
 
 // We include our own header files.
-// We need  race.h to use the shared DrawTextOutlined and GetLevelName functions.
+// We need race_draw.h for the mission HUD (DrawRaceUI) and the shared DrawTextOutlined function.
 #include "ui.h"
-#include "race.h"
+#include "race_draw.h"
 
 
 // --- 1. MAIN MENU SCREEN ---
@@ -40,22 +40,24 @@ void DrawMainMenu(int screenWidth, int screenHeight) {
 
 
 // --- 2. LEVEL SELECT SCREEN ---
-void DrawLevelSelectScreen(int currentLevel, int maxLevels, int screenWidth, int screenHeight) {
+void DrawLevelSelectScreen(const LevelCatalog *catalog, int currentLevel, int screenWidth, int screenHeight) {
     // 1. Main screen title.
     const char *title = "SELECT CIRCUIT";
     int titleWidth = MeasureText(title, 40); 
     DrawText(title, (screenWidth - titleWidth) / 2, screenHeight * 0.1f, 40, DARKBLUE);
     
-    // 2. Fetch and draw the specific mission name dynamically.
-    char currentName[50] = { 0 }; 
-    GetLevelName(currentLevel, currentName); // Modifies our string buffer.
+    // 2. Look up the specific mission name in the catalog (already in RAM).
+    // If the file doesn't exist (e.g., level 15 when we only have 10), we show a placeholder instead.
+    const LevelInfo *info = GetLevelInfo(catalog, currentLevel);
+    bool levelExists = (info != NULL && info->exists);
+    const char *currentName = levelExists ? info->name : "RESTRICTED AREA";
     
     const char *lvlText = TextFormat("< LEVEL %d: %s >", currentLevel, currentName);
     int lvlWidth = MeasureText(lvlText, 30);
     
     // Color logic: Gold if the file exists (playable), Gray if it doesn't ("RESTRICTED AREA").
     Color titleColor;
-    if (strcmp(currentName, "RESTRICTED AREA") != 0) {
+    if (levelExists) {
         titleColor = GOLD;
     } else {
         titleColor = GRAY;
@@ -83,7 +85,7 @@ void DrawLevelSelectScreen(int currentLevel, int maxLevels, int screenWidth, int
         Color boxColor;
         if (levelNum == currentLevel) {
             boxColor = GOLD;      // Currently selected by the user.
-        } else if (levelNum <= maxLevels) {
+        } else if (levelNum <= catalog->count) {
             boxColor = DARKBLUE;  // Playable level.
         } else {
             boxColor = LIGHTGRAY; // Future/unlocked level.
@@ -93,7 +95,7 @@ void DrawLevelSelectScreen(int currentLevel, int maxLevels, int screenWidth, int
         DrawRectangleLinesEx(slotRect, 2, WHITE);
 
         // Only draw the number inside if the level actually exists.
-        if (levelNum <= maxLevels) {
+        if (levelNum <= catalog->count) {
             DrawText(TextFormat("%d", levelNum), slotRect.x + 30, slotRect.y + 25, 30, WHITE);
         }
     }
@@ -135,7 +137,7 @@ void DrawVehicleSelectScreen(int screenWidth, int screenHeight) {
 
 
 // --- 4. IN-FLIGHT HUD (HEAD-UP DISPLAY) ---
-void DrawHUD(Player *player, RaceSystem *race, bool showControls, int screenWidth, int screenHeight) {
+void DrawHUD(Player *player, RaceSystem *race, const LeaderboardTarget *target, bool showControls, int screenWidth, int screenHeight) {
     
     // 1. Controls Overlay (Toggleable).
     if (showControls) {
@@ -161,7 +163,23 @@ void DrawHUD(Player *player, RaceSystem *race, bool showControls, int screenWidt
     // 2. Delegate the mission-specific UI (Rings left, landing timers) to the Race Manager.
     DrawRaceUI(race);
 
-    // 3. Draw the universal aeronautical telemetry (Altitude and Power).
+    // 3. The run to beat, right under the mission UI, with the live gap to it.
+    // Green while the player is well ahead of it, orange in its last 5 seconds.
+    // Once it is lost, the next slower run takes its place.
+    if (race->isRaceActive && target->hasTarget) {
+        const char *targetText;
+        if (target->rank == 1) {
+            targetText = TextFormat("RECORD: %.2f  (%+.2f)", target->time, target->delta);
+        } else {
+            targetText = TextFormat("BEAT #%d: %.2f  (%+.2f)", target->rank, target->time, target->delta);
+        }
+
+        Color deltaColor = (target->delta > -5.0f) ? ORANGE : LIME;
+        int targetWidth = MeasureText(targetText, 20);
+        DrawTextOutlined(targetText, (screenWidth - targetWidth) / 2, screenHeight * 0.14f, 20, deltaColor, 2);
+    }
+
+    // 4. Draw the universal aeronautical telemetry (Altitude and Power).
     DrawTextOutlined(TextFormat("ALTITUDE: %.0f ft", player->position.y * 10.0f), 20, screenHeight - 100, 20, LIME, 2);
 
     float maxThrottle;
@@ -222,11 +240,17 @@ void DrawNameInputScreen(const char *playerName, char currentVirtualKey, int scr
 
 
 // --- 6. LEADERBOARD TERMINAL ---
-void DrawLeaderboardScreen(Leaderboard *lb, int screenWidth, int screenHeight) {
+void DrawLeaderboardScreen(Leaderboard *lb, int playerRank, int screenWidth, int screenHeight) {
     // A different background to make it feel like an old computer terminal.
     ClearBackground(DARKBLUE); 
     
-    const char *title = "--- TOP 10 PILOTS ---";
+    // The first page is the classic top 10; the others say which ranks they show.
+    const char *title;
+    if (lb->firstRank <= 1) {
+        title = "--- TOP 10 PILOTS ---";
+    } else {
+        title = TextFormat("--- RANKS %d-%d ---", lb->firstRank, lb->firstRank + MAX_LEADERBOARD - 1);
+    }
     DrawText(title, (screenWidth - MeasureText(title, 40)) / 2, screenHeight * 0.1f, 40, GOLD);
     
     // Base layout coordinates.
@@ -241,7 +265,8 @@ void DrawLeaderboardScreen(Leaderboard *lb, int screenWidth, int screenHeight) {
     // Loop through the active records and print them list-style.
     for (int i = 0; i < lb->count; i++) {
         // Format the strings.
-        const char *recordStr = TextFormat("%d. %s", i + 1, lb->entries[i].name);
+        int rank = lb->firstRank + i;
+        const char *recordStr = TextFormat("%d. %s", rank, lb->entries[i].name);
         const char *timeStr = TextFormat("%.2f s", lb->entries[i].time);
         
         const char *vehStr;
@@ -251,12 +276,29 @@ void DrawLeaderboardScreen(Leaderboard *lb, int screenWidth, int screenHeight) {
             vehStr = "Helicopter";
         }
         
+        // The run just submitted gets a highlight bar behind it.
+        if (rank == playerRank) {
+            DrawRectangle(screenWidth * 0.18f, startY + (i * spacing) - 3, screenWidth * 0.72f, spacing - 2, Fade(GOLD, 0.3f));
+        }
+
         // Draw the 3 aligned columns.
         DrawText(recordStr, screenWidth * 0.2f, startY + (i * spacing), 30, WHITE);
         DrawText(timeStr,   screenWidth * 0.5f, startY + (i * spacing), 30, LIME);
         DrawText(vehStr,    screenWidth * 0.75f, startY + (i * spacing), 30, SKYBLUE);
     }
     
+    // Where the player's run landed among all of them, even far below the top 10.
+    if (playerRank > 0) {
+        const char *rankText = TextFormat("YOUR RUN: #%d OF %d", playerRank, lb->totalCount);
+        DrawText(rankText, (screenWidth - MeasureText(rankText, 25)) / 2, screenHeight * 0.8f, 25, GOLD);
+    }
+
+    // Paging hint (only when there is more than one page).
+    if (lb->totalCount > MAX_LEADERBOARD) {
+        const char *pageText = "[UP] / [DOWN] TO BROWSE ALL RANKS";
+        DrawText(pageText, (screenWidth - MeasureText(pageText, 20)) / 2, screenHeight * 0.85f, 20, LIGHTGRAY);
+    }
+
     // Exit instructions.
     const char *exitText;
     if (IsGamepadAvailable(0)) {
@@ -265,4 +307,25 @@ void DrawLeaderboardScreen(Leaderboard *lb, int screenWidth, int screenHeight) {
         exitText = "PRESS [ENTER] TO RETURN TO BASE";
     }
     DrawText(exitText, (screenWidth - MeasureText(exitText, 20)) / 2, screenHeight * 0.9f, 20, GRAY);
-}
\ No newline at end of file
+}
+
+// --- 7. LOADING SCREEN ---
+void DrawLoadingScreen(float progress, int screenWidth, int screenHeight) {
+    if (progress < 0.0f) progress = 0.0f;
+    if (progress > 1.0f) progress = 1.0f;
+
+    const char *title = "LOADING";
+    int titleWidth = MeasureText(title, 50);
+    DrawText(title, (screenWidth - titleWidth) / 2, screenHeight * 0.35f, 50, DARKBLUE);
+
+    // The bar: a dark frame, filled from the left as the files arrive.
+    float barWidth = screenWidth * 0.5f;
+    float barHeight = 30.0f;
+    Rectangle frame = { (screenWidth - barWidth) / 2, screenHeight * 0.5f, barWidth, barHeight };
+    DrawRectangleRec(frame, Fade(DARKBLUE, 0.3f));
+    DrawRectangle(frame.x, frame.y, frame.width * progress, frame.height, GOLD);
+    DrawRectangleLinesEx(frame, 2, DARKBLUE);
+
+    const char *percent = TextFormat("%d%%", (int)(progress * 100.0f));
+    DrawText(percent, (screenWidth - MeasureText(percent, 20)) / 2, frame.y + barHeight + 15, 20, DARKGRAY);
+}
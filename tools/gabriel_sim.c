@@ -0,0 +1,563 @@
+// --- GABRIEL-SIM (HEADLESS BATCH RUNNER) ---
+// A second program, separate from the game, that flies missions WITHOUT opening a window.
+// It loads levels with the normal InitRace(), feeds the simulation core (SimStep) with
+// a scripted input stream or a simple built-in autopilot, and reports how every run ended.
+// Many runs are spread over all the CPU cores, so the whole campaign is re-checked in seconds
+// after every physics change.
+//
+// Usage:
+//   gabriel-sim [options] [level ...]
+//
+//   level                 Level numbers to run (e.g. "1 5 12"). Default: every levels/lvlN.txt found.
+//   --seeds N             Runs every level N times with a different autopilot seed (default 1).
+//   --script FILE         Feeds the input from FILE instead of the autopilot.
+//   --replay FILE         Plays back a recorded flight (data/times_lvlN_*.replay) and checks
+//                         that it reaches the same race time as the original run.
+//   --vehicle plane|heli  Forces the vehicle (default: plane for rings, helicopter for landings).
+//   --max-time SECONDS    Simulated time limit per run before giving up (default 300).
+//   --threads N           Number of worker threads (default: one per CPU core).
+//
+// Script format (plain text, one step per line, '#' starts a comment):
+//   <ticks> <throttle> <yaw> <pitch>
+// Each step holds the same PilotInput for <ticks> simulation ticks (120 ticks = 1 second).
+// When the script runs out, the controls are released (all axes at 0.0f).
+//
+// The process exits with code 1 if any run failed or timed out, so it can gate CI directly.
+
+// Include standard libraries for printing, memory, strings and math.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// POSIX threads and clocks (available on Linux, macOS and MinGW).
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+// The headless simulation core and the terrain (only the baked height grid is used here).
+#include "sim.h"
+#include "terrain.h"
+#include "replay.h"
+
+
+// --- CONSTANTS ---
+#define MAX_SIM_LEVELS 256        // Highest level number we probe on disk.
+#define MAX_SIM_JOBS 4096         // Maximum number of runs (levels x seeds) in one batch.
+#define DEFAULT_MAX_TIME 300.0f   // Simulated seconds before a run is declared a timeout.
+
+
+// --- DATA STRUCTURES ---
+
+// One line of an input script: hold 'input' for 'ticks' simulation ticks.
+typedef struct ScriptStep {
+    int ticks;
+    PilotInput input;
+} ScriptStep;
+
+// The whole input script, loaded once and shared (read-only) by every thread.
+typedef struct InputScript {
+    ScriptStep *steps;
+    int count;
+} InputScript;
+
+// How a single run ended.
+typedef enum RunResult {
+    RUN_FINISHED = 0,   // Mission completed.
+    RUN_FAILED,         // The referee declared the mission failed (see failReason).
+    RUN_TIMEOUT,        // The time limit was reached before finishing.
+    RUN_NO_LEVEL        // The level file doesn't exist.
+} RunResult;
+
+// One run of the batch: the inputs (level, seed, vehicle) and, once done, the results.
+typedef struct SimJob {
+    int levelID;
+    unsigned int seed;
+    VehicleType vehicle;          // VEHICLE_NONE = pick automatically from the mission type.
+
+    RunResult result;
+    MissionFailReason failReason;
+    float missionTime;            // The race stopwatch when the run ended.
+    int ringsCrossed;
+    int totalRings;
+    long long ticks;              // Number of SimStep() calls.
+    double seconds;               // Real (wall clock) time spent in the loop.
+} SimJob;
+
+// The autopilot memory between ticks.
+typedef struct Autopilot {
+    unsigned int noiseState;      // Random generator state (0 = no noise).
+    Vector3 lastPadPosition;      // To estimate the speed of moving landing pads.
+    bool hasLastPad;
+} Autopilot;
+
+
+// --- SHARED BATCH STATE ---
+// Written once by main() before the threads start, then only read (except 'nextJob').
+static SimJob jobs[MAX_SIM_JOBS];
+static int jobCount = 0;
+static int nextJob = 0;
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+
+static InputScript script = { 0 };
+static bool useScript = false;
+static Replay replay = { 0 };     // Every job plays its own copy (the copy has its own cursor).
+static float maxSimTime = DEFAULT_MAX_TIME;
+
+
+// --- TIMING ---
+// Monotonic wall clock in seconds (raylib's GetTime() needs a window, so we can't use it here).
+static double GetWallTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+
+// --- SCRIPT LOADING ---
+// Reads the "<ticks> <throttle> <yaw> <pitch>" lines of a script file.
+static bool LoadInputScript(const char *fileName, InputScript *outScript) {
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL) {
+        return false;
+    }
+
+    int capacity = 64;
+    outScript->steps = (ScriptStep *)malloc(capacity * sizeof(ScriptStep));
+    outScript->count = 0;
+
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        // Cut the comments and skip empty lines.
+        line[strcspn(line, "#")] = 0;
+
+        ScriptStep step = { 0 };
+        if (sscanf(line, "%d %f %f %f", &step.ticks, &step.input.throttle, &step.input.yaw, &step.input.pitch) != 4) {
+            continue;
+        }
+        if (step.ticks <= 0) {
+            continue;
+        }
+
+        if (outScript->count == capacity) {
+            capacity *= 2;
+            outScript->steps = (ScriptStep *)realloc(outScript->steps, capacity * sizeof(ScriptStep));
+        }
+        outScript->steps[outScript->count++] = step;
+    }
+
+    fclose(file);
+    return true;
+}
+
+
+// --- AUTOPILOT ---
+// A deliberately simple pilot that flies towards the current objective.
+// It only needs to be good enough to complete the campaign, so a broken physics change
+// shows up as failures or much slower times in the batch report.
+
+// Small xorshift generator, private to every run (rand() is shared between threads).
+static float NextNoise(Autopilot *pilot) {
+    if (pilot->noiseState == 0) {
+        return 0.0f;
+    }
+    pilot->noiseState ^= pilot->noiseState << 13;
+    pilot->noiseState ^= pilot->noiseState >> 17;
+    pilot->noiseState ^= pilot->noiseState << 5;
+    return ((float)(pilot->noiseState & 0xFFFF) / 65535.0f) * 2.0f - 1.0f;
+}
+
+// Wraps an angle into the -PI to +PI range.
+static float WrapAngle(float angle) {
+    while (angle > PI)  angle -= 2.0f * PI;
+    while (angle < -PI) angle += 2.0f * PI;
+    return angle;
+}
+
+// Yaw input that turns the nose towards the (X, Z) target.
+// Remember: the vehicle flies along (-sin(yaw), -cos(yaw)) on the ground plane.
+static float SteerTowards(const Player *player, float dx, float dz) {
+    float desiredYaw = atan2f(-dx, -dz);
+    float error = WrapAngle(desiredYaw - player->rotation.y);
+    return Clamp(error * 3.0f, -1.0f, 1.0f);
+}
+
+// Throttle input that moves the current throttle towards 'targetThrottle'.
+static float ThrottleTowards(const Player *player, float targetThrottle, float dt) {
+    float step = player->acceleration * dt * 60.0f;
+    return Clamp((player->throttle - targetThrottle) / step, -1.0f, 1.0f);
+}
+
+// Ring missions (plane): fly a straight line to the centre of the next ring.
+static PilotInput FlyToRing(const Player *player, const RaceSystem *race, float dt) {
+    PilotInput input = { 0 };
+    if (race->targetRing >= race->totalRings) {
+        return input; // Empty circuit: nothing to fly to.
+    }
+    const Ring *ring = &race->rings[race->targetRing];
+
+    float dx = ring->position.x - player->position.x;
+    float dy = ring->position.y - player->position.y;
+    float dz = ring->position.z - player->position.z;
+    float horizontalDistance = sqrtf(dx * dx + dz * dz);
+
+    // If the ring is close but behind us, fly straight on and come back for a wider turn.
+    float desiredYaw = atan2f(-dx, -dz);
+    float yawError = WrapAngle(desiredYaw - player->rotation.y);
+    if (horizontalDistance < 50.0f && fabsf(yawError) > 1.0f) {
+        input.yaw = 0.0f;
+    } else {
+        input.yaw = SteerTowards(player, dx, dz);
+    }
+
+    // Full power keeps the wings generating lift.
+    input.throttle = ThrottleTowards(player, -0.8f, dt);
+
+    // Vertical speed needed to arrive exactly at the ring's height (per 60 Hz frame units).
+    float speed = fmaxf(-player->throttle, 0.05f);
+    float desiredVY = (dy / fmaxf(horizontalDistance, 1.0f)) * speed;
+
+    // Solve the plane's vertical physics for the pitch input that reaches that speed:
+    // lift (0.03 * speed) - gravity (0.015) - drag (5% of vy) + pitch (0.05 * speed * input).
+    float needed = 0.015f - (0.03f * speed) + (0.05f * desiredVY) + ((desiredVY - player->velocity.y) * 0.5f);
+    input.pitch = Clamp(needed / (0.05f * speed), -1.0f, 1.0f);
+
+    return input;
+}
+
+// Landing missions (helicopter): match the pad's movement, hover above it and descend gently.
+static PilotInput FlyToPad(Autopilot *pilot, const Player *player, const RaceSystem *race, float dt) {
+    PilotInput input = { 0 };
+
+    // Estimate the pad velocity (per 60 Hz frame units, like the player's velocity).
+    Vector3 padVelocity = { 0 };
+    if (pilot->hasLastPad) {
+        padVelocity = Vector3Scale(Vector3Subtract(race->landingZone, pilot->lastPadPosition), 1.0f / (dt * 60.0f));
+    }
+    pilot->lastPadPosition = race->landingZone;
+    pilot->hasLastPad = true;
+
+    float dx = race->landingZone.x - player->position.x;
+    float dz = race->landingZone.z - player->position.z;
+    float horizontalDistance = sqrtf(dx * dx + dz * dz);
+
+    // Desired ground velocity: follow the pad, plus a correction towards its centre.
+    float desiredVX = padVelocity.x + dx * 0.01f;
+    float desiredVZ = padVelocity.z + dz * 0.01f;
+    float desiredSpeed = sqrtf(desiredVX * desiredVX + desiredVZ * desiredVZ);
+    if (desiredSpeed > 0.4f) {
+        desiredVX *= 0.4f / desiredSpeed;
+        desiredVZ *= 0.4f / desiredSpeed;
+        desiredSpeed = 0.4f;
+    }
+
+    // Helicopters only move along their nose, so turn towards the desired velocity
+    // and use the throttle for the part of it that lies along the nose.
+    float targetThrottle = 0.0f;
+    if (desiredSpeed > 0.005f) {
+        input.yaw = SteerTowards(player, desiredVX, desiredVZ);
+        float forwardX = -sinf(player->rotation.y);
+        float forwardZ = -cosf(player->rotation.y);
+        targetThrottle = -((desiredVX * forwardX) + (desiredVZ * forwardZ));
+    }
+    input.throttle = ThrottleTowards(player, Clamp(targetThrottle, -0.4f, 0.1f), dt);
+
+    // Height: cruise 15 units above the pad, descend only when we are well inside it.
+    float altitude = player->position.y - race->landingZone.y;
+    float desiredVY;
+    if (horizontalDistance > race->landingRadius * 0.4f) {
+        desiredVY = Clamp((15.0f - altitude) * 0.02f, -0.5f, 0.3f);
+    } else {
+        // Touchdown sink rate: 40% of the allowed limit (which is in units per second).
+        float maxSink = (race->maxLandingSpeed * 0.4f) / 60.0f;
+        desiredVY = Clamp(-altitude * 0.02f, -0.5f, -maxSink * 0.5f);
+        if (desiredVY < -maxSink) desiredVY = -maxSink;
+    }
+
+    // Rotor: 3x acceleration up, 2x down, against gravity (0.015) and drag (5% of vy).
+    float needed = 0.015f + (0.05f * desiredVY) + ((desiredVY - player->velocity.y) * 0.5f);
+    if (needed >= 0.0f) {
+        input.pitch = Clamp(needed / (player->acceleration * 3.0f), -1.0f, 1.0f);
+    } else {
+        input.pitch = Clamp(needed / (player->acceleration * 2.0f), -1.0f, 1.0f);
+    }
+
+    return input;
+}
+
+static PilotInput RunAutopilot(Autopilot *pilot, const Player *player, const RaceSystem *race, float dt) {
+    PilotInput input;
+    if (race->missionType == 0) {
+        input = FlyToRing(player, race, dt);
+    } else {
+        input = FlyToPad(pilot, player, race, dt);
+    }
+
+    // Seeds other than 0 add a little stick noise, so every seed flies a slightly different line.
+    input.yaw   = Clamp(input.yaw + NextNoise(pilot) * 0.1f, -1.0f, 1.0f);
+    input.pitch = Clamp(input.pitch + NextNoise(pilot) * 0.1f, -1.0f, 1.0f);
+
+    return input;
+}
+
+
+// --- SINGLE RUN ---
+// Flies one job from the spawn point until the mission ends or the time runs out.
+static void RunJob(SimJob *job) {
+    // InitRace() silently returns an empty mission if the file is missing, so check first.
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "levels/lvl%d.txt", job->levelID);
+    FILE *probe = fopen(fileName, "r");
+    if (probe == NULL) {
+        job->result = RUN_NO_LEVEL;
+        return;
+    }
+    fclose(probe);
+
+    RaceSystem race = InitRace(job->levelID);
+
+    VehicleType vehicle = job->vehicle;
+    if (vehicle == VEHICLE_NONE) {
+        vehicle = (race.missionType == 1) ? VEHICLE_HELICOPTER : VEHICLE_PLANE;
+    }
+    job->vehicle = vehicle;
+
+    Player player = InitPlayer(vehicle, race.startPos, race.startYaw);
+
+    Autopilot pilot = { 0 };
+    pilot.noiseState = job->seed * 2654435761u;
+
+    long long maxTicks = (long long)(maxSimTime * SIM_TICK_RATE);
+    int scriptStep = 0;
+    int scriptTicksLeft = useScript && script.count > 0 ? script.steps[0].ticks : 0;
+    Replay playback = replay;
+
+    double start = GetWallTime();
+    long long tick = 0;
+
+    for (; tick < maxTicks; tick++) {
+        if (race.isFinished || race.missionFailed) {
+            break;
+        }
+
+        PilotInput input = { 0 };
+        if (replay.isReady) {
+            // Same path as the game: the recorded input (and vehicle switches) go through SimStep().
+            VehicleType recordedVehicle = player.type;
+            if (ReadReplayTick(&playback, &input, &recordedVehicle)) {
+                player.type = recordedVehicle;
+            }
+        } else if (useScript) {
+            // Advance through the script, one step after another.
+            while (scriptStep < script.count && scriptTicksLeft <= 0) {
+                scriptStep++;
+                if (scriptStep < script.count) scriptTicksLeft = script.steps[scriptStep].ticks;
+            }
+            if (scriptStep < script.count) {
+                input = script.steps[scriptStep].input;
+                scriptTicksLeft--;
+            }
+        } else {
+            input = RunAutopilot(&pilot, &player, &race, SIM_DT);
+        }
+
+        SimStep(&player, &race, &input, SIM_DT);
+    }
+
+    job->seconds = GetWallTime() - start;
+    job->ticks = tick;
+    job->missionTime = race.timer;
+    job->failReason = race.failReason;
+    job->totalRings = race.totalRings;
+    job->ringsCrossed = race.targetRing;
+
+    if (race.isFinished) job->result = RUN_FINISHED;
+    else if (race.missionFailed) job->result = RUN_FAILED;
+    else job->result = RUN_TIMEOUT;
+
+    UnloadRace(&race);
+}
+
+
+// --- WORKER THREAD ---
+// Every worker keeps taking the next free job until the list is empty.
+static void *WorkerThread(void *arg) {
+    (void)arg;
+
+    while (true) {
+        pthread_mutex_lock(&jobLock);
+        int index = nextJob++;
+        pthread_mutex_unlock(&jobLock);
+
+        if (index >= jobCount) {
+            break;
+        }
+        RunJob(&jobs[index]);
+    }
+
+    return NULL;
+}
+
+
+// --- REPORT HELPERS ---
+static const char *GetFailReasonText(MissionFailReason reason) {
+    switch (reason) {
+        case FAIL_MISSED_PAD:   return "missed the pad";
+        case FAIL_HARD_LANDING: return "hard landing";
+        case FAIL_SLIDING:      return "sliding touchdown";
+        default:                return "-";
+    }
+}
+
+static const char *GetRunResultText(RunResult result) {
+    switch (result) {
+        case RUN_FINISHED: return "FINISHED";
+        case RUN_FAILED:   return "FAILED";
+        case RUN_TIMEOUT:  return "TIMEOUT";
+        default:           return "NO LEVEL";
+    }
+}
+
+
+// --- MAIN FUNCTION ---
+int main(int argc, char *argv[]) {
+    int levelList[MAX_SIM_LEVELS];
+    int levelCount = 0;
+    int seedCount = 1;
+    int threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    VehicleType forcedVehicle = VEHICLE_NONE;
+    const char *heightfieldFile = "resources/models/terrain.height";
+
+    // --- 1. COMMAND LINE ---
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            seedCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-time") == 0 && i + 1 < argc) {
+            maxSimTime = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--vehicle") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "plane") == 0) forcedVehicle = VEHICLE_PLANE;
+            else if (strcmp(argv[i], "heli") == 0) forcedVehicle = VEHICLE_HELICOPTER;
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            if (!LoadInputScript(argv[++i], &script)) {
+                fprintf(stderr, "gabriel-sim: cannot read script '%s'\n", argv[i]);
+                return 2;
+            }
+            useScript = true;
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay = LoadReplay(argv[++i]);
+            if (!replay.isReady) {
+                fprintf(stderr, "gabriel-sim: cannot read replay '%s'\n", argv[i]);
+                return 2;
+            }
+        } else if (argv[i][0] != '-' && levelCount < MAX_SIM_LEVELS) {
+            levelList[levelCount++] = atoi(argv[i]);
+        } else {
+            fprintf(stderr, "usage: gabriel-sim [--seeds N] [--threads N] [--max-time S] [--vehicle plane|heli] [--script FILE] [--replay FILE] [level ...]\n");
+            return 2;
+        }
+    }
+    if (seedCount < 1) seedCount = 1;
+    if (threadCount < 1) threadCount = 1;
+
+    // A replay always belongs to one level and starts with one vehicle.
+    if (replay.isReady) {
+        levelList[0] = replay.levelID;
+        levelCount = 1;
+        forcedVehicle = replay.startVehicle;
+    }
+
+    // No levels given: run every level file found on disk (same probing as the game's menu).
+    if (levelCount == 0) {
+        for (int id = 1; id <= MAX_SIM_LEVELS; id++) {
+            char fileName[64];
+            snprintf(fileName, sizeof(fileName), "levels/lvl%d.txt", id);
+            FILE *probe = fopen(fileName, "r");
+            if (probe == NULL) break;
+            fclose(probe);
+            levelList[levelCount++] = id;
+        }
+    }
+
+    // --- 2. TERRAIN ---
+    // Without a GPU we can't load terrain.glb, but the baked height grid is plain data.
+    // The forward crash ray needs the full mesh, so it is skipped in headless runs.
+    if (!LoadTerrainHeightfield(heightfieldFile)) {
+        fprintf(stderr, "gabriel-sim: no baked terrain (%s), flying over flat ground\n", heightfieldFile);
+    }
+
+    // --- 3. BUILD THE JOB LIST ---
+    for (int l = 0; l < levelCount; l++) {
+        for (int s = 0; s < seedCount && jobCount < MAX_SIM_JOBS; s++) {
+            SimJob job = { 0 };
+            job.levelID = levelList[l];
+            job.seed = (unsigned int)s;
+            job.vehicle = forcedVehicle;
+            jobs[jobCount++] = job;
+        }
+    }
+    if (threadCount > jobCount) threadCount = jobCount;
+
+    // --- 4. RUN EVERYTHING IN PARALLEL ---
+    double batchStart = GetWallTime();
+
+    pthread_t *threads = (pthread_t *)malloc(threadCount * sizeof(pthread_t));
+    for (int t = 0; t < threadCount; t++) {
+        pthread_create(&threads[t], NULL, WorkerThread, NULL);
+    }
+    for (int t = 0; t < threadCount; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+
+    double batchSeconds = GetWallTime() - batchStart;
+
+    // --- 5. REPORT ---
+    // Printed in job order (not completion order), so two reports can be diffed line by line.
+    printf("%-5s %-5s %-5s %-9s %10s %7s %12s %12s  %s\n",
+           "LEVEL", "SEED", "VEH", "RESULT", "TIME(s)", "RINGS", "TICKS", "TICKS/s", "FAIL REASON");
+
+    long long totalTicks = 0;
+    int badRuns = 0;
+
+    for (int i = 0; i < jobCount; i++) {
+        SimJob *job = &jobs[i];
+        const char *vehicleName = (job->vehicle == VEHICLE_HELICOPTER) ? "heli" : "plane";
+        double ticksPerSecond = (job->seconds > 0.0) ? (double)job->ticks / job->seconds : 0.0;
+
+        char rings[16] = "-";
+        if (job->totalRings > 0) {
+            snprintf(rings, sizeof(rings), "%d/%d", job->ringsCrossed, job->totalRings);
+        }
+
+        const char *reason = GetFailReasonText(job->failReason);
+        if (job->result == RUN_TIMEOUT) reason = "time limit";
+
+        printf("%-5d %-5u %-5s %-9s %10.2f %7s %12lld %12.0f  %s\n",
+               job->levelID, job->seed, vehicleName, GetRunResultText(job->result),
+               job->missionTime, rings, job->ticks, ticksPerSecond, reason);
+
+        totalTicks += job->ticks;
+        if (job->result != RUN_FINISHED) badRuns++;
+    }
+
+    printf("\n%d runs on %d threads, %d not finished. %lld ticks in %.3f s (%.0f ticks/s overall)\n",
+           jobCount, threadCount, badRuns, totalTicks, batchSeconds,
+           (batchSeconds > 0.0) ? (double)totalTicks / batchSeconds : 0.0);
+
+    // Replays must land on the exact same time, otherwise the physics changed (or aren't deterministic).
+    if (replay.isReady && jobCount > 0) {
+        bool match = (jobs[0].result == RUN_FINISHED) && (fabsf(jobs[0].missionTime - replay.finalTime) < 0.001f);
+        printf("Replay check: recorded %.3f s in %d ticks, simulated %.3f s in %lld ticks -> %s\n",
+               replay.finalTime, replay.tickCount, jobs[0].missionTime, jobs[0].ticks, match ? "MATCH" : "MISMATCH");
+        if (!match) badRuns++;
+    }
+
+    UnloadTerrainHeightfield();
+    UnloadReplay(&replay);
+    free(script.steps);
+
+    return (badRuns > 0) ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+// --- LEVEL-COMPILER ---
+// Checks the hand-written level files (levels/lvlN.txt) and compiles each one into a binary
+// 'lvlN.bin' next to it. The game maps the binary straight into memory instead of parsing the
+// text, with every ring transform and collision frame already calculated (see level_binary.h).
+// The text stays the real level: edit it, and the game ignores the old binary until it is recompiled.
+//
+// Usage:
+//   level-compiler [--check] [file.txt ...]
+//
+//   file.txt    Level files to compile. Default: every levels/lvlN.txt found.
+//   --check     Only validates the files, without writing any binary.
+//
+// The process exits with code 1 if any file is invalid or couldn't be written, so it can gate CI.
+
+// Include standard libraries for printing, strings and math.
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// The mission loader and the compiled level format.
+#include "race.h"
+#include "level_binary.h"
+
+
+// --- CONSTANTS ---
+#define MAX_COMPILER_LEVELS 256   // Highest level number we probe on disk.
+
+
+// --- VALIDATION ---
+// The text loader is forgiving (a short file just ends the circuit early), which is right for
+// playing but hides mistakes. Here every one of them is an error.
+
+static bool IsFiniteVector(Vector3 v) {
+    return isfinite(v.x) && isfinite(v.y) && isfinite(v.z);
+}
+
+// Prints every problem found in 'race' (loaded from 'fileName') and returns true if there were none.
+static bool ValidateLevel(const RaceSystem *race, const char *fileName) {
+    bool valid = true;
+
+    if (!IsFiniteVector(race->startPos) || !isfinite(race->startYaw)) {
+        fprintf(stderr, "%s: invalid start position\n", fileName);
+        valid = false;
+    }
+
+    if (race->missionType == 0) {
+        if (race->declaredRings <= 0) {
+            fprintf(stderr, "%s: ring race without rings\n", fileName);
+            valid = false;
+        } else if (race->totalRings != race->declaredRings) {
+            fprintf(stderr, "%s: file ends after ring %d of %d\n", fileName, race->totalRings, race->declaredRings);
+            valid = false;
+        }
+
+        for (int i = 0; i < race->totalRings; i++) {
+            const Ring *ring = &race->rings[i];
+            if (!IsFiniteVector(ring->position) || !isfinite(ring->pitch) ||
+                !isfinite(ring->yaw) || !isfinite(ring->roll)) {
+                fprintf(stderr, "%s: ring %d has an invalid position or rotation\n", fileName, i + 1);
+                valid = false;
+            }
+            if (!(ring->radius > 0.0f)) {
+                fprintf(stderr, "%s: ring %d has a radius of %.2f\n", fileName, i + 1, ring->radius);
+                valid = false;
+            }
+        }
+    } else if (race->missionType == 1) {
+        if (!IsFiniteVector(race->landingZone) || !(race->landingRadius > 0.0f) || !(race->maxLandingSpeed > 0.0f)) {
+            fprintf(stderr, "%s: invalid landing pad (position, radius or speed limit)\n", fileName);
+            valid = false;
+        }
+        if (race->padMoveType < 0 || race->padMoveType > 2) {
+            fprintf(stderr, "%s: unknown pad movement type %d\n", fileName, race->padMoveType);
+            valid = false;
+        }
+    } else {
+        fprintf(stderr, "%s: unknown mission type %d\n", fileName, race->missionType);
+        valid = false;
+    }
+
+    return valid;
+}
+
+
+// --- COMPILER ---
+// Compiles one level. Returns false if it is invalid or the binary couldn't be written.
+static bool CompileLevel(const char *textFile, bool checkOnly) {
+    FILE *probe = fopen(textFile, "r");
+    if (probe == NULL) {
+        fprintf(stderr, "%s: can't open file\n", textFile);
+        return false;
+    }
+    fclose(probe);
+
+    RaceSystem race = LoadRaceText(textFile);
+    bool ok = ValidateLevel(&race, textFile);
+
+    if (ok && !checkOnly) {
+        // Same name with the '.bin' extension ("levels/lvl3.txt" -> "levels/lvl3.bin").
+        char binaryFile[256];
+        snprintf(binaryFile, sizeof(binaryFile), "%s", textFile);
+        char *extension = strrchr(binaryFile, '.');
+        if (extension != NULL && strcmp(extension, ".txt") == 0) {
+            strcpy(extension, ".bin");
+        } else {
+            snprintf(binaryFile, sizeof(binaryFile), "%s.bin", textFile);
+        }
+
+        if (WriteLevelBinary(&race, textFile, binaryFile)) {
+            size_t bytes = LEVEL_BINARY_PAYLOAD_OFFSET + ((race.ringArena.base != NULL) ? GetRaceRingsSize(race.declaredRings) : 0);
+            printf("%s -> %s (%d rings, %.1f KB)\n", textFile, binaryFile, race.totalRings, bytes / 1024.0);
+        } else {
+            fprintf(stderr, "%s: can't write %s\n", textFile, binaryFile);
+            ok = false;
+        }
+    } else if (ok) {
+        printf("%s: OK (%d rings)\n", textFile, race.totalRings);
+    }
+
+    UnloadRace(&race);
+    return ok;
+}
+
+
+// --- MAIN ---
+int main(int argc, char *argv[]) {
+    bool checkOnly = false;
+    int fileCount = 0;
+    bool allOk = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--check") == 0) {
+            checkOnly = true;
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "usage: level-compiler [--check] [file.txt ...]\n");
+            return 1;
+        }
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-') continue;
+        allOk = CompileLevel(argv[i], checkOnly) && allOk;
+        fileCount++;
+    }
+
+    // No files given: every level the game would list (the unbroken run from lvl1.txt).
+    if (fileCount == 0) {
+        for (int id = 1; id <= MAX_COMPILER_LEVELS; id++) {
+            char textFile[64];
+            snprintf(textFile, sizeof(textFile), "levels/lvl%d.txt", id);
+            FILE *probe = fopen(textFile, "r");
+            if (probe == NULL) break;
+            fclose(probe);
+
+            allOk = CompileLevel(textFile, checkOnly) && allOk;
+            fileCount++;
+        }
+    }
+
+    if (fileCount == 0) {
+        fprintf(stderr, "level-compiler: no level files found\n");
+        return 1;
+    }
+
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+// --- RING-BENCH (MICROBENCHMARK) ---
+// Measures how long the ring referee (UpdateMissionRings) takes per simulation tick
+// on synthetic circuits of 50, 5,000 and 50,000 rings, and compares it with the
+// original loop that recalculated every ring's direction with sinf/cosf on every tick.
+// With the broadphase grid the referee only looks at the rings around the plane,
+// so its time per tick should stay flat while the reference grows with the ring count.
+//
+// Usage:
+//   ring-bench [ticks]     (default: 2000 ticks per circuit)
+//
+// The plane flies along the whole circuit, 100 units to the side of the rings,
+// so no ring is ever crossed and every ring stays live (the worst case for the referee).
+
+// Include standard libraries for printing, memory and math.
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// POSIX clock.
+#include <time.h>
+
+// The simulation core (RaceSystem, Player and the ring mission).
+#include "sim.h"
+#include "raymath.h"
+
+
+// --- CONSTANTS ---
+#define RING_SPACING 60.0f        // Distance between two consecutive rings.
+#define DEFAULT_BENCH_TICKS 2000
+
+
+static double GetWallTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+
+// --- SYNTHETIC CIRCUIT ---
+// A long line of rings, each one slightly turned so the direction math isn't trivial.
+static RaceSystem BuildBenchRace(int ringCount) {
+    RaceSystem race = { 0 };
+    race.missionType = 0;
+    race.isRaceActive = true;
+
+    if (!AllocateRaceRings(&race, ringCount)) {
+        return race;
+    }
+
+    for (int i = 0; i < ringCount; i++) {
+        Ring *ring = &race.rings[i];
+        ring->position = (Vector3){ 0.0f, 50.0f, -RING_SPACING * (i + 1) };
+        ring->radius = 15.0f;
+        ring->pitch = (float)(i % 7) * 3.0f;
+        ring->yaw = (float)(i % 11) * 5.0f;
+        ring->roll = 0.0f;
+        ring->active = true;
+    }
+    race.totalRings = ringCount;
+
+    BuildRingFrames(&race);
+    if (!BuildRingGrid(&race)) {
+        UnloadRace(&race);
+    }
+    return race;
+}
+
+
+// --- REFERENCE LOOP ---
+// The ring check as it was before the precomputed frames: sinf/cosf and two square roots
+// for every ring on every tick. Kept here only as a baseline. Returns the number of crashes
+// so the compiler can't throw the work away.
+static int ReferenceRingsTick(const RaceSystem *race, const Player *player) {
+    int hits = 0;
+
+    for (int i = race->targetRing; i < race->totalRings; i++) {
+        const Ring *ring = &race->rings[i];
+        if (!ring->active) continue;
+
+        Vector3 diff = Vector3Subtract(player->position, ring->position);
+        Vector3 ringForward = {
+            -sinf(ring->yaw * DEG2RAD) * cosf(ring->pitch * DEG2RAD),
+            sinf(ring->pitch * DEG2RAD),
+            -cosf(ring->yaw * DEG2RAD) * cosf(ring->pitch * DEG2RAD)
+        };
+
+        float depthDistance = fabsf(Vector3DotProduct(diff, ringForward));
+        float totalDistanceSqr = Vector3LengthSqr(diff);
+        float distance2D = sqrtf(fabsf(totalDistanceSqr - (depthDistance * depthDistance)));
+
+        float radialDiff = distance2D - ring->radius;
+        float distanceToTubeCore = sqrtf((radialDiff * radialDiff) + (depthDistance * depthDistance));
+        float tubeThickness = (ring->radius * 0.05f) + 2.0f;
+
+        if (distanceToTubeCore < tubeThickness) hits++;
+    }
+
+    return hits;
+}
+
+
+// --- BENCHMARK ---
+// Moves the player along the circuit and returns the average nanoseconds per tick.
+static double TimeTicks(RaceSystem *race, int ticks, bool useReference, int *outHits) {
+    Player player = { 0 };
+    float circuitLength = RING_SPACING * (race->totalRings + 1);
+    int hits = 0;
+
+    double start = GetWallTime();
+    for (int t = 0; t < ticks; t++) {
+        player.position = (Vector3){ 100.0f, 50.0f, -circuitLength * ((float)t / ticks) };
+
+        if (useReference) {
+            hits += ReferenceRingsTick(race, &player);
+        } else {
+            UpdateMissionRings(race, &player, SIM_DT);
+        }
+    }
+    double seconds = GetWallTime() - start;
+
+    *outHits = hits;
+    return (seconds * 1e9) / ticks;
+}
+
+
+// --- MAIN ---
+int main(int argc, char *argv[]) {
+    int ticks = DEFAULT_BENCH_TICKS;
+    if (argc > 1) {
+        ticks = atoi(argv[1]);
+        if (ticks <= 0) {
+            fprintf(stderr, "usage: ring-bench [ticks]\n");
+            return 1;
+        }
+    }
+
+    const int ringCounts[] = { 50, 5000, 50000 };
+    const int caseCount = (int)(sizeof(ringCounts) / sizeof(ringCounts[0]));
+
+    printf("%-8s %16s %16s %9s\n", "RINGS", "REFERENCE ns/t", "GRID ns/t", "SPEEDUP");
+
+    for (int c = 0; c < caseCount; c++) {
+        RaceSystem race = BuildBenchRace(ringCounts[c]);
+        if (race.totalRings == 0) {
+            fprintf(stderr, "ring-bench: not enough memory for %d rings\n", ringCounts[c]);
+            return 1;
+        }
+
+        int referenceHits = 0;
+        int unusedHits = 0;
+        double reference = TimeTicks(&race, ticks, true, &referenceHits);
+        double grid = TimeTicks(&race, ticks, false, &unusedHits);
+
+        printf("%-8d %16.0f %16.0f %8.1fx\n", race.totalRings, reference, grid, reference / grid);
+
+        // Nothing should touch the rings on this flight path.
+        if (referenceHits != 0 || race.targetRing != 0) {
+            fprintf(stderr, "ring-bench: unexpected ring contact (%d)\n", referenceHits);
+        }
+
+        UnloadRace(&race);
+    }
+
+    return 0;
+}